@@ -0,0 +1,42 @@
+#include "arena.hpp"
+
+namespace base
+{
+
+Arena::Arena(std::size_t initial_size)
+  : _resource{ initial_size }
+{}
+
+
+std::size_t Arena::getAllocationsCount() const noexcept
+{
+    return _allocations_count;
+}
+
+
+std::size_t Arena::getAllocatedBytes() const noexcept
+{
+    return _allocated_bytes;
+}
+
+
+void* Arena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    ++_allocations_count;
+    _allocated_bytes += bytes;
+    return _resource.allocate(bytes, alignment);
+}
+
+
+void Arena::do_deallocate(void*, std::size_t, std::size_t)
+{
+    // memory is released only when the arena is destroyed
+}
+
+
+bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+} // namespace base
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace base
+{
+
+/// Memory resource for temporary objects of a single unit of work, e.g. processing of a block.
+/// Allocations are served from a growing buffer and are freed all at once when the arena is destroyed.
+/// The arena counts what was requested from it, so that allocation-heavy steps can be spotted in logs.
+class Arena : public std::pmr::memory_resource
+{
+  public:
+    //====================
+    explicit Arena(std::size_t initial_size);
+    Arena(const Arena&) = delete;
+    Arena(Arena&&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    Arena& operator=(Arena&&) = delete;
+    ~Arena() override = default;
+    //====================
+    std::size_t getAllocationsCount() const noexcept;
+    std::size_t getAllocatedBytes() const noexcept;
+    //====================
+  private:
+    //====================
+    std::pmr::monotonic_buffer_resource _resource;
+    std::size_t _allocations_count{ 0 };
+    std::size_t _allocated_bytes{ 0 };
+    //====================
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+} // namespace base
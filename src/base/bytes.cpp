@@ -3,10 +3,17 @@
 #include "base/assert.hpp"
 #include "base/error.hpp"
 
-#include <openssl/pem.h>
-
 #include <boost/container_hash/hash.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BYTES_CODECS_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
 namespace base
 {
 
@@ -16,7 +23,7 @@ Bytes::Bytes(std::size_t size)
 
 
 Bytes::Bytes(const std::vector<Byte>& bytes)
-  : _raw(bytes)
+  : _raw(bytes.begin(), bytes.end())
 {}
 
 
@@ -85,10 +92,7 @@ Bytes& Bytes::append(const Bytes& bytes)
 
 Bytes& Bytes::append(const Byte* byte, std::size_t length)
 {
-    _raw.reserve(_raw.size() + length);
-    for (const Byte* ptr = byte; ptr < byte + length; ++ptr) {
-        _raw.push_back(*ptr);
-    }
+    _raw.insert(_raw.end(), byte, byte + length);
     return *this;
 }
 
@@ -147,18 +151,6 @@ Byte* Bytes::getData()
 }
 
 
-std::vector<Byte>& Bytes::toVector() noexcept
-{
-    return _raw;
-}
-
-
-const std::vector<Byte>& Bytes::toVector() const noexcept
-{
-    return _raw;
-}
-
-
 std::string Bytes::toString() const
 {
     std::string ret(_raw.size(), static_cast<char>(0));
@@ -208,7 +200,9 @@ bool Bytes::operator>=(const Bytes& another) const
 
 base::Bytes operator+(const base::Bytes& a, const base::Bytes& b)
 {
-    base::Bytes ret{ a };
+    base::Bytes ret;
+    ret.reserve(a.size() + b.size());
+    ret.append(a);
     ret.append(b);
     return ret;
 }
@@ -219,30 +213,631 @@ std::ostream& operator<<(std::ostream& os, const Bytes& bytes)
 }
 
 
-base::Bytes base64Decode(std::string_view base64)
+BytesView::BytesView(const Byte* bytes, std::size_t length)
+  : _data{ bytes }
+  , _size{ length }
+{}
+
+
+BytesView::BytesView(const Bytes& bytes)
+  : _data{ bytes.getData() }
+  , _size{ bytes.size() }
+{}
+
+
+BytesView::BytesView(std::string_view s)
+  : _data{ reinterpret_cast<const Byte*>(s.data()) }
+  , _size{ s.size() }
+{}
+
+
+const Byte& BytesView::operator[](std::size_t index) const
+{
+    ASSERT(index < _size);
+    return _data[index];
+}
+
+
+BytesView BytesView::subView(std::size_t begin_index, std::size_t one_past_end_index) const
+{
+    ASSERT(begin_index <= one_past_end_index);
+    ASSERT(one_past_end_index <= _size);
+    return BytesView(_data + begin_index, one_past_end_index - begin_index);
+}
+
+
+std::size_t BytesView::size() const noexcept
+{
+    return _size;
+}
+
+
+bool BytesView::isEmpty() const noexcept
+{
+    return _size == 0;
+}
+
+
+const Byte* BytesView::getData() const noexcept
+{
+    return _data;
+}
+
+
+Bytes BytesView::toBytes() const
+{
+    return Bytes(_data, _size);
+}
+
+
+std::string BytesView::toString() const
+{
+    return std::string(reinterpret_cast<const char*>(_data), _size);
+}
+
+
+bool BytesView::operator==(const BytesView& another) const
+{
+    return std::equal(_data, _data + _size, another._data, another._data + another._size);
+}
+
+
+bool BytesView::operator!=(const BytesView& another) const
+{
+    return !(*this == another);
+}
+
+
+std::ostream& operator<<(std::ostream& os, const BytesView& bytes)
+{
+    return os << toHex<BytesView>(bytes);
+}
+
+
+namespace
+{
+
+constexpr char HEX_DIGITS[] = "0123456789abcdef";
+constexpr char BASE64_DIGITS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr char BASE64_PADDING = '=';
+
+
+constexpr std::array<std::int8_t, 256> makeHexDigitsMap()
+{
+    std::array<std::int8_t, 256> map{};
+    for (auto& digit : map) {
+        digit = -1;
+    }
+    for (std::size_t i = 0; i < 10; ++i) {
+        map['0' + i] = static_cast<std::int8_t>(i);
+    }
+    for (std::size_t i = 0; i < 6; ++i) {
+        map['a' + i] = map['A' + i] = static_cast<std::int8_t>(10 + i);
+    }
+    return map;
+}
+
+
+constexpr std::array<std::int8_t, 256> makeBase64DigitsMap()
+{
+    std::array<std::int8_t, 256> map{};
+    for (auto& digit : map) {
+        digit = -1;
+    }
+    for (std::size_t i = 0; i < 64; ++i) {
+        map[static_cast<unsigned char>(BASE64_DIGITS[i])] = static_cast<std::int8_t>(i);
+    }
+    return map;
+}
+
+
+constexpr std::array<std::int8_t, 256> HEX_DIGITS_MAP = makeHexDigitsMap();
+constexpr std::array<std::int8_t, 256> BASE64_DIGITS_MAP = makeBase64DigitsMap();
+
+
+std::size_t base64PaddingLength(std::string_view base64) noexcept
+{
+    std::size_t padding = 0;
+    if (!base64.empty() && base64.size() % 4 == 0) {
+        for (auto it = base64.rbegin(); padding < 2 && *it == BASE64_PADDING; ++it) {
+            ++padding;
+        }
+    }
+    return padding;
+}
+
+
+// scalar codecs process everything the vectorized ones left, so they are the only place errors are raised
+
+void toHexScalar(const base::Byte* data, std::size_t length, char* out) noexcept
+{
+    for (std::size_t i = 0; i < length; ++i) {
+        *out++ = HEX_DIGITS[data[i] >> 4];
+        *out++ = HEX_DIGITS[data[i] & 0xF];
+    }
+}
+
+
+void fromHexScalar(const char* hex, std::size_t length, base::Byte* out)
+{
+    for (std::size_t i = 0; i < length; i += 2) {
+        auto high_part = HEX_DIGITS_MAP[static_cast<unsigned char>(hex[i])];
+        auto low_part = HEX_DIGITS_MAP[static_cast<unsigned char>(hex[i + 1])];
+        if (high_part < 0 || low_part < 0) {
+            RAISE_ERROR(base::InvalidArgument, "Non hex symbol");
+        }
+        *out++ = static_cast<base::Byte>((high_part << 4) | low_part);
+    }
+}
+
+
+void base64EncodeScalar(const base::Byte* data, std::size_t length, char* out) noexcept
 {
-    auto length = base64.length();
-    if (length == 0) {
-        return base::Bytes();
+    std::size_t i = 0;
+    for (; i + 3 <= length; i += 3) {
+        std::uint32_t triple = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+        *out++ = BASE64_DIGITS[(triple >> 18) & 0x3F];
+        *out++ = BASE64_DIGITS[(triple >> 12) & 0x3F];
+        *out++ = BASE64_DIGITS[(triple >> 6) & 0x3F];
+        *out++ = BASE64_DIGITS[triple & 0x3F];
+    }
+
+    if (auto rest = length - i; rest > 0) {
+        std::uint32_t triple = (data[i] << 16) | (rest == 2 ? data[i + 1] << 8 : 0);
+        *out++ = BASE64_DIGITS[(triple >> 18) & 0x3F];
+        *out++ = BASE64_DIGITS[(triple >> 12) & 0x3F];
+        *out++ = rest == 2 ? BASE64_DIGITS[(triple >> 6) & 0x3F] : BASE64_PADDING;
+        *out++ = BASE64_PADDING;
     }
+}
 
-    BIO* b64 = BIO_new(BIO_f_base64());
-    BIO* bio = BIO_new_mem_buf(base64.data(), length);
-    base::Bytes ret(length);
 
-    BIO_set_flags(b64, BIO_FLAGS_BASE64_NO_NL);
-    bio = BIO_push(b64, bio);
-    auto new_length = BIO_read(bio, ret.getData(), length);
-    if (new_length < 1) {
-        BIO_free_all(bio);
-        RAISE_ERROR(CryptoError, "Base64 decode read error");
+// length doesn't include padding, so the last group may hold 2 or 3 symbols
+void base64DecodeScalar(const char* base64, std::size_t length, base::Byte* out)
+{
+    std::uint32_t accumulator = 0;
+    std::size_t i = 0;
+    for (; i < length; ++i) {
+        auto digit = BASE64_DIGITS_MAP[static_cast<unsigned char>(base64[i])];
+        if (digit < 0) {
+            RAISE_ERROR(base::InvalidArgument, "Non base64 symbol");
+        }
+        accumulator = (accumulator << 6) | static_cast<std::uint32_t>(digit);
+        if (i % 4 == 3) {
+            *out++ = static_cast<base::Byte>(accumulator >> 16);
+            *out++ = static_cast<base::Byte>(accumulator >> 8);
+            *out++ = static_cast<base::Byte>(accumulator);
+            accumulator = 0;
+        }
+    }
+
+    if (i % 4 == 2) {
+        *out++ = static_cast<base::Byte>(accumulator >> 4);
+    }
+    else if (i % 4 == 3) {
+        *out++ = static_cast<base::Byte>(accumulator >> 10);
+        *out++ = static_cast<base::Byte>(accumulator >> 2);
     }
+}
+
+
+#ifdef BYTES_CODECS_HAVE_X86_SIMD
+
+// vectorized codecs are compiled for their instruction set regardless of build flags and are picked
+// at runtime; each one processes whole blocks and returns how many input bytes it has consumed
+
+bool cpuHasSsse3() noexcept
+{
+    static const bool has_ssse3 = __builtin_cpu_supports("ssse3");
+    return has_ssse3;
+}
+
+
+bool cpuHasAvx2() noexcept
+{
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+
+__attribute__((target("ssse3"), always_inline)) inline __m128i hexDigitsLut() noexcept
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(HEX_DIGITS));
+}
 
-    BIO_free_all(bio);
-    ret.resize(new_length);
+
+__attribute__((target("ssse3"))) std::size_t toHexSsse3(const base::Byte* data, std::size_t length, char* out) noexcept
+{
+    const __m128i digits = hexDigitsLut();
+    const __m128i low_mask = _mm_set1_epi8(0x0F);
+
+    std::size_t processed = 0;
+    for (; processed + 16 <= length; processed += 16) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + processed));
+        const __m128i high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(input, 4), low_mask));
+        const __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(input, low_mask));
+        auto dst = reinterpret_cast<__m128i*>(out + processed * 2);
+        _mm_storeu_si128(dst, _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(dst + 1, _mm_unpackhi_epi8(high, low));
+    }
+    return processed;
+}
+
+
+__attribute__((target("avx2"))) std::size_t toHexAvx2(const base::Byte* data, std::size_t length, char* out) noexcept
+{
+    const __m256i digits = _mm256_broadcastsi128_si256(hexDigitsLut());
+    const __m256i low_mask = _mm256_set1_epi8(0x0F);
+
+    std::size_t processed = 0;
+    for (; processed + 32 <= length; processed += 32) {
+        const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + processed));
+        const __m256i high = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_mask));
+        const __m256i low = _mm256_shuffle_epi8(digits, _mm256_and_si256(input, low_mask));
+        // unpacking works within 128-bit lanes, so the halves are put back in order afterwards
+        const __m256i first = _mm256_unpacklo_epi8(high, low);
+        const __m256i second = _mm256_unpackhi_epi8(high, low);
+        auto dst = reinterpret_cast<__m256i*>(out + processed * 2);
+        _mm256_storeu_si256(dst, _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(dst + 1, _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    return processed;
+}
+
+
+// converts hex digits to their values, lanes with non-hex characters are marked in invalid
+__attribute__((target("ssse3"), always_inline)) inline __m128i hexValuesSsse3(__m128i chars, __m128i& invalid) noexcept
+{
+    // setting 0x20 turns uppercase letters to lowercase and keeps digits as is
+    const __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+    const __m128i is_digit =
+      _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+    const __m128i is_letter =
+      _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+    invalid = _mm_or_si128(invalid, _mm_cmpeq_epi8(_mm_or_si128(is_digit, is_letter), _mm_setzero_si128()));
+    return _mm_or_si128(_mm_and_si128(is_digit, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+                        _mm_and_si128(is_letter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+}
+
+
+__attribute__((target("avx2"), always_inline)) inline __m256i hexValuesAvx2(__m256i chars, __m256i& invalid) noexcept
+{
+    const __m256i lower = _mm256_or_si256(chars, _mm256_set1_epi8(0x20));
+    const __m256i is_digit = _mm256_andnot_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('9')),
+                                                 _mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1)));
+    const __m256i is_letter = _mm256_andnot_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('f')),
+                                                  _mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)));
+    invalid = _mm256_or_si256(invalid, _mm256_cmpeq_epi8(_mm256_or_si256(is_digit, is_letter), _mm256_setzero_si256()));
+    return _mm256_or_si256(_mm256_and_si256(is_digit, _mm256_sub_epi8(chars, _mm256_set1_epi8('0'))),
+                           _mm256_and_si256(is_letter, _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10))));
+}
+
+
+__attribute__((target("ssse3"))) std::size_t fromHexSsse3(const char* hex, std::size_t length, base::Byte* out) noexcept
+{
+    // multiply-add of neighbour bytes by 16 and 1 joins two digits into a byte
+    const __m128i weights = _mm_set1_epi16(0x0110);
+
+    std::size_t processed = 0;
+    for (; processed + 32 <= length; processed += 32) {
+        __m128i invalid = _mm_setzero_si128();
+        const auto src = reinterpret_cast<const __m128i*>(hex + processed);
+        const __m128i first = hexValuesSsse3(_mm_loadu_si128(src), invalid);
+        const __m128i second = hexValuesSsse3(_mm_loadu_si128(src + 1), invalid);
+        if (_mm_movemask_epi8(invalid) != 0) {
+            break;
+        }
+        const __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(first, weights), _mm_maddubs_epi16(second, weights));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + processed / 2), bytes);
+    }
+    return processed;
+}
+
+
+__attribute__((target("avx2"))) std::size_t fromHexAvx2(const char* hex, std::size_t length, base::Byte* out) noexcept
+{
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+
+    std::size_t processed = 0;
+    for (; processed + 64 <= length; processed += 64) {
+        __m256i invalid = _mm256_setzero_si256();
+        const auto src = reinterpret_cast<const __m256i*>(hex + processed);
+        const __m256i first = hexValuesAvx2(_mm256_loadu_si256(src), invalid);
+        const __m256i second = hexValuesAvx2(_mm256_loadu_si256(src + 1), invalid);
+        if (_mm256_movemask_epi8(invalid) != 0) {
+            break;
+        }
+        const __m256i packed =
+          _mm256_packus_epi16(_mm256_maddubs_epi16(first, weights), _mm256_maddubs_epi16(second, weights));
+        // packing interleaves 64-bit quarters of both inputs
+        const __m256i bytes = _mm256_permute4x64_epi64(packed, 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + processed / 2), bytes);
+    }
+    return processed;
+}
+
+
+// the base64 kernels follow W. Mula and D. Lemire, "Faster Base64 Encoding and Decoding Using AVX2 Instructions"
+
+// spreads every 3 bytes of the 12 low ones to 4 bytes holding 6-bit values
+__attribute__((target("ssse3"), always_inline)) inline __m128i base64SplitSsse3(__m128i input) noexcept
+{
+    input = _mm_shuffle_epi8(input, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    const __m128i first_and_third =
+      _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+    const __m128i second_and_fourth =
+      _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(first_and_third, second_and_fourth);
+}
+
+
+// maps 6-bit values to symbols by adding an offset chosen for the range the value is in
+__attribute__((target("ssse3"), always_inline)) inline __m128i base64OffsetsLut() noexcept
+{
+    return _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                         '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+}
+
+
+__attribute__((target("ssse3"), always_inline)) inline __m128i base64SymbolsSsse3(__m128i values) noexcept
+{
+    __m128i range = _mm_subs_epu8(values, _mm_set1_epi8(51));
+    range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), values), _mm_set1_epi8(13)));
+    return _mm_add_epi8(values, _mm_shuffle_epi8(base64OffsetsLut(), range));
+}
+
+
+__attribute__((target("ssse3"))) std::size_t base64EncodeSsse3(const base::Byte* data,
+                                                               std::size_t length,
+                                                               char* out) noexcept
+{
+    std::size_t processed = 0;
+    // every step consumes 12 bytes, but loads 16
+    for (; processed + 16 <= length; processed += 12) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + processed));
+        const __m128i symbols = base64SymbolsSsse3(base64SplitSsse3(input));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + processed / 3 * 4), symbols);
+    }
+    return processed;
+}
+
+
+__attribute__((target("avx2"))) std::size_t base64EncodeAvx2(const base::Byte* data,
+                                                             std::size_t length,
+                                                             char* out) noexcept
+{
+    const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5,
+                                             4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i offsets = _mm256_broadcastsi128_si256(base64OffsetsLut());
+
+    std::size_t processed = 0;
+    // every step consumes 24 bytes, 12 for each lane, but loads 28
+    for (; processed + 28 <= length; processed += 24) {
+        const auto src = data + processed;
+        __m256i input = _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+        input = _mm256_inserti128_si256(input, _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 12)), 1);
+        input = _mm256_shuffle_epi8(input, shuffle);
+
+        const __m256i first_and_third =
+          _mm256_mulhi_epu16(_mm256_and_si256(input, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+        const __m256i second_and_fourth =
+          _mm256_mullo_epi16(_mm256_and_si256(input, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+        const __m256i values = _mm256_or_si256(first_and_third, second_and_fourth);
+
+        __m256i range = _mm256_subs_epu8(values, _mm256_set1_epi8(51));
+        range = _mm256_or_si256(
+          range, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), values), _mm256_set1_epi8(13)));
+        const __m256i symbols = _mm256_add_epi8(values, _mm256_shuffle_epi8(offsets, range));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + processed / 3 * 4), symbols);
+    }
+    return processed;
+}
+
+
+// the symbol's high nibble selects an offset turning it to its value; the low nibble selects the set of high
+// nibbles valid with it, which catches every non-base64 character
+__attribute__((target("ssse3"), always_inline)) inline __m128i base64OffsetsByHighNibbleLut() noexcept
+{
+    return _mm_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+}
+
+
+__attribute__((target("ssse3"), always_inline)) inline __m128i base64ValidHighNibblesLut() noexcept
+{
+    const auto b = [](int bits) { return static_cast<char>(bits); };
+    return _mm_setr_epi8(
+      b(0xA8), b(0xF8), b(0xF8), b(0xF8), b(0xF8), b(0xF8), b(0xF8), b(0xF8), b(0xF8), b(0xF8), b(0xF0), b(0x54),
+      b(0x50), b(0x50), b(0x50), b(0x54));
+}
+
+
+__attribute__((target("ssse3"), always_inline)) inline __m128i base64HighNibbleBitLut() noexcept
+{
+    return _mm_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, static_cast<char>(0x80), 0, 0, 0, 0, 0, 0, 0, 0);
+}
+
+
+__attribute__((target("ssse3"))) std::size_t base64DecodeSsse3(const char* base64,
+                                                               std::size_t length,
+                                                               base::Byte* out) noexcept
+{
+    const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+    const __m128i slash = _mm_set1_epi8('/');
+    const __m128i slash_offset = _mm_set1_epi8('?' - '/');
+
+    std::size_t processed = 0;
+    for (; processed + 16 <= length; processed += 16) {
+        const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(base64 + processed));
+        const __m128i high = _mm_and_si128(_mm_srli_epi32(input, 4), nibble_mask);
+        const __m128i low = _mm_and_si128(input, nibble_mask);
+
+        const __m128i valid_high = _mm_shuffle_epi8(base64ValidHighNibblesLut(), low);
+        const __m128i high_bit = _mm_shuffle_epi8(base64HighNibbleBitLut(), high);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(valid_high, high_bit), _mm_setzero_si128())) != 0) {
+            break;
+        }
+
+        // '/' shares its high nibble with '+', so it gets its own offset
+        const __m128i is_slash = _mm_cmpeq_epi8(input, slash);
+        const __m128i offset = _mm_or_si128(
+          _mm_andnot_si128(is_slash, _mm_shuffle_epi8(base64OffsetsByHighNibbleLut(), high)),
+          _mm_and_si128(is_slash, slash_offset));
+        const __m128i values = _mm_add_epi8(input, offset);
+
+        // join 4 values of 6 bits into 3 bytes, which go in the reversed order in each 32-bit lane
+        const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        const __m128i triples = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        const __m128i bytes =
+          _mm_shuffle_epi8(triples, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+        auto dst = out + processed / 4 * 3;
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), bytes);
+        const auto tail = static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(bytes, 8)));
+        std::memcpy(dst + 8, &tail, sizeof(tail));
+    }
+    return processed;
+}
+
+
+__attribute__((target("avx2"))) std::size_t base64DecodeAvx2(const char* base64,
+                                                             std::size_t length,
+                                                             base::Byte* out) noexcept
+{
+    const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+    const __m256i slash = _mm256_set1_epi8('/');
+    const __m256i slash_offset = _mm256_set1_epi8('?' - '/');
+    const __m256i offsets = _mm256_broadcastsi128_si256(base64OffsetsByHighNibbleLut());
+    const __m256i valid_highs = _mm256_broadcastsi128_si256(base64ValidHighNibblesLut());
+    const __m256i high_bits = _mm256_broadcastsi128_si256(base64HighNibbleBitLut());
+    const __m256i reverse = _mm256_broadcastsi128_si256(
+      _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+    std::size_t processed = 0;
+    for (; processed + 32 <= length; processed += 32) {
+        const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base64 + processed));
+        const __m256i high = _mm256_and_si256(_mm256_srli_epi32(input, 4), nibble_mask);
+        const __m256i low = _mm256_and_si256(input, nibble_mask);
+
+        const __m256i valid =
+          _mm256_and_si256(_mm256_shuffle_epi8(valid_highs, low), _mm256_shuffle_epi8(high_bits, high));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(valid, _mm256_setzero_si256())) != 0) {
+            break;
+        }
+
+        const __m256i is_slash = _mm256_cmpeq_epi8(input, slash);
+        const __m256i offset = _mm256_or_si256(_mm256_andnot_si256(is_slash, _mm256_shuffle_epi8(offsets, high)),
+                                               _mm256_and_si256(is_slash, slash_offset));
+        const __m256i values = _mm256_add_epi8(input, offset);
+
+        const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        const __m256i triples = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        // each lane holds 12 bytes, which are moved together into the low 24
+        const __m256i bytes = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(triples, reverse),
+                                                          _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+
+        auto dst = out + processed / 4 * 3;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(bytes));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 16), _mm256_extracti128_si256(bytes, 1));
+    }
+    return processed;
+}
+
+#endif
+
+} // namespace
+
+
+std::size_t base64EncodedSize(std::size_t bytes_length) noexcept
+{
+    return (bytes_length + 2) / 3 * 4;
+}
+
+
+void base64EncodeInto(const BytesView& bytes, char* out) noexcept
+{
+    std::size_t processed = 0;
+#ifdef BYTES_CODECS_HAVE_X86_SIMD
+    if (cpuHasAvx2()) {
+        processed = base64EncodeAvx2(bytes.getData(), bytes.size(), out);
+    }
+    if (cpuHasSsse3()) {
+        processed += base64EncodeSsse3(bytes.getData() + processed, bytes.size() - processed, out + processed / 3 * 4);
+    }
+#endif
+    base64EncodeScalar(bytes.getData() + processed, bytes.size() - processed, out + processed / 3 * 4);
+}
+
+
+std::size_t base64DecodedSize(std::string_view base64)
+{
+    if (base64.size() % 4 == 1) {
+        RAISE_ERROR(InvalidArgument, "Invalid base64 string length");
+    }
+    return (base64.size() - base64PaddingLength(base64)) * 3 / 4;
+}
+
+
+void base64DecodeInto(std::string_view base64, Byte* out)
+{
+    if (base64.size() % 4 == 1) {
+        RAISE_ERROR(InvalidArgument, "Invalid base64 string length");
+    }
+
+    const auto length = base64.size() - base64PaddingLength(base64);
+    std::size_t processed = 0;
+#ifdef BYTES_CODECS_HAVE_X86_SIMD
+    if (cpuHasAvx2()) {
+        processed = base64DecodeAvx2(base64.data(), length, out);
+    }
+    if (cpuHasSsse3()) {
+        processed += base64DecodeSsse3(base64.data() + processed, length - processed, out + processed / 4 * 3);
+    }
+#endif
+    base64DecodeScalar(base64.data() + processed, length - processed, out + processed / 4 * 3);
+}
+
+
+base::Bytes base64Decode(std::string_view base64)
+{
+    base::Bytes ret(base64DecodedSize(base64));
+    base64DecodeInto(base64, ret.getData());
     return ret;
 }
 
+
+void toHexInto(const BytesView& bytes, char* out) noexcept
+{
+    std::size_t processed = 0;
+#ifdef BYTES_CODECS_HAVE_X86_SIMD
+    if (cpuHasAvx2()) {
+        processed = toHexAvx2(bytes.getData(), bytes.size(), out);
+    }
+    if (cpuHasSsse3()) {
+        processed += toHexSsse3(bytes.getData() + processed, bytes.size() - processed, out + processed * 2);
+    }
+#endif
+    toHexScalar(bytes.getData() + processed, bytes.size() - processed, out + processed * 2);
+}
+
+
+void fromHexInto(std::string_view hex_view, Byte* out)
+{
+    if (hex_view.size() % 2 != 0) {
+        RAISE_ERROR(InvalidArgument, "Invalid string length. Odd line length.");
+    }
+
+    std::size_t processed = 0;
+#ifdef BYTES_CODECS_HAVE_X86_SIMD
+    if (cpuHasAvx2()) {
+        processed = fromHexAvx2(hex_view.data(), hex_view.size(), out);
+    }
+    if (cpuHasSsse3()) {
+        processed += fromHexSsse3(hex_view.data() + processed, hex_view.size() - processed, out + processed / 2);
+    }
+#endif
+    fromHexScalar(hex_view.data() + processed, hex_view.size() - processed, out + processed / 2);
+}
+
 // clang-format off
 static constexpr int8_t mapBase58[256] = {
      -1,-1,-1,-1,-1,-1,-1,-1, -1,-1,-1,-1,-1,-1,-1,-1,
@@ -303,5 +898,5 @@ base::Bytes base58Decode(std::string_view base58)
 
 std::size_t std::hash<base::Bytes>::operator()(const base::Bytes& k) const
 {
-    return boost::hash_value(k.toVector());
+    return boost::hash_range(k.getData(), k.getData() + k.size());
 }
@@ -2,11 +2,14 @@
 
 #include "base/types.hpp"
 
+#include <boost/container/small_vector.hpp>
+
 #include <array>
 #include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace base
@@ -18,6 +21,10 @@ class FixedBytes;
 class Bytes
 {
   public:
+    //------------------------
+    // bytes up to this size are kept inside the object, which covers hashes, addresses, EVM words
+    // and database keys made of a prefix byte and a hash
+    static constexpr std::size_t INLINE_CAPACITY = 40;
     //------------------------
     Bytes() = default;
     explicit Bytes(std::size_t size);
@@ -57,9 +64,6 @@ class Bytes
     const Byte* getData() const;
     Byte* getData();
     //------------------------
-    [[nodiscard]] std::vector<Byte>& toVector() noexcept;
-    [[nodiscard]] const std::vector<Byte>& toVector() const noexcept;
-    //------------------------
     [[nodiscard]] std::string toString() const;
     //------------------------
     bool operator==(const Bytes& another) const;
@@ -73,7 +77,7 @@ class Bytes
     //==============
 
   private:
-    std::vector<Byte> _raw;
+    boost::container::small_vector<Byte, INLINE_CAPACITY> _raw;
 };
 
 base::Bytes operator+(const base::Bytes& a, const base::Bytes& b);
@@ -125,21 +129,78 @@ class FixedBytes
 };
 
 
+// non-owning view of a contiguous range of bytes, so the viewed memory must outlive the view
+class BytesView
+{
+  public:
+    //------------------------
+    BytesView() = default;
+    BytesView(const Byte* bytes, std::size_t length);
+    BytesView(const Bytes& bytes);
+    template<std::size_t S>
+    BytesView(const FixedBytes<S>& bytes);
+    explicit BytesView(std::string_view s);
+    BytesView(const BytesView&) = default;
+    BytesView& operator=(const BytesView&) = default;
+    ~BytesView() = default;
+    //------------------------
+    const Byte& operator[](std::size_t index) const;
+    //------------------------
+    [[nodiscard]] BytesView subView(std::size_t begin_index, std::size_t one_past_end_index) const;
+    //------------------------
+    std::size_t size() const noexcept;
+    bool isEmpty() const noexcept;
+    //------------------------
+    const Byte* getData() const noexcept;
+    //------------------------
+    [[nodiscard]] Bytes toBytes() const;
+    [[nodiscard]] std::string toString() const;
+    //------------------------
+    bool operator==(const BytesView& another) const;
+    bool operator!=(const BytesView& another) const;
+    //==============
+
+  private:
+    const Byte* _data{ nullptr };
+    std::size_t _size{ 0 };
+};
+
+std::ostream& operator<<(std::ostream& os, const BytesView& bytes);
+
+
 template<typename T>
 std::string base64Encode(const T& bytes);
 base::Bytes base64Decode(std::string_view base64);
 
+// streaming variants that write into a caller-provided buffer of base64EncodedSize / base64DecodedSize bytes;
+// output is padded, decoding raises InvalidArgument on a malformed string
+std::size_t base64EncodedSize(std::size_t bytes_length) noexcept;
+void base64EncodeInto(const BytesView& bytes, char* out) noexcept;
+std::size_t base64DecodedSize(std::string_view base64);
+void base64DecodeInto(std::string_view base64, Byte* out);
+
 
 template<typename T>
 std::string base58Encode(const T& bytes);
 base::Bytes base58Decode(std::string_view base58);
 
+// same results as the general functions, but work on fixed-size numbers without allocations;
+// decoding raises InvalidArgument if the string doesn't decode to exactly S bytes
+template<std::size_t S>
+std::string base58Encode(const FixedBytes<S>& bytes);
+template<std::size_t S>
+FixedBytes<S> base58Decode(std::string_view base58);
+
 template<typename T>
 [[nodiscard]] std::string toHex(const T& bytes);
 
 template<typename T>
 [[nodiscard]] T fromHex(const std::string_view& hex_view);
 
+// streaming variants: toHexInto writes bytes.size() * 2 characters, fromHexInto writes hex_view.size() / 2 bytes
+void toHexInto(const BytesView& bytes, char* out) noexcept;
+void fromHexInto(std::string_view hex_view, Byte* out);
+
 } // namespace base
 
 namespace std
@@ -5,40 +5,19 @@
 #include "base/assert.hpp"
 #include "base/error.hpp"
 
-#include <openssl/pem.h>
-
 #include <boost/container_hash/hash.hpp>
 
 #include <algorithm>
-
-namespace
-{
-
-std::size_t hexToInt(char hex)
-{
-    if ('0' <= hex && hex <= '9') {
-        return hex - '0';
-    }
-    else if ('a' <= hex && hex <= 'f') {
-        return hex - 'a' + 10;
-    }
-    else if ('A' <= hex && hex <= 'F') {
-        return hex - 'A' + 10;
-    }
-    else {
-        RAISE_ERROR(base::InvalidArgument, "Non hex symbol");
-    }
-}
-
-} // namespace
-
+#include <array>
+#include <iterator>
+#include <type_traits>
 
 namespace base
 {
 
 template<std::size_t S>
 Bytes::Bytes(const FixedBytes<S>& bytes)
-  : _raw(bytes.getData(), S)
+  : _raw(bytes.getData(), bytes.getData() + S)
 {}
 
 template<typename I>
@@ -47,6 +26,13 @@ Bytes::Bytes(I begin, I end)
 {}
 
 
+template<std::size_t S>
+BytesView::BytesView(const FixedBytes<S>& bytes)
+  : _data{ bytes.getData() }
+  , _size{ S }
+{}
+
+
 template<std::size_t S>
 FixedBytes<S>::FixedBytes()
 {}
@@ -68,7 +54,7 @@ FixedBytes<S>::FixedBytes(const Bytes& bytes)
     if (S != bytes.size()) {
         RAISE_ERROR(base::InvalidArgument, "Invalid bytes size for FixedBytes");
     }
-    std::copy_n(bytes.toVector().begin(), S, _array.begin());
+    std::copy_n(bytes.getData(), S, _array.begin());
 }
 
 
@@ -221,14 +207,9 @@ bool FixedBytes<S>::operator>=(const FixedBytes<S>& another) const
 template<typename T>
 std::string toHex(const T& bytes)
 {
-    static constexpr const char HEX_DIGITS[] = "0123456789abcdef";
     // since every byte is represented by 2 hex digits, we do * 2
     std::string ret(bytes.size() * 2, static_cast<char>(0));
-    std::size_t index = 0;
-    for (const Byte& c : bytes.toString()) {
-        ret[index++] = HEX_DIGITS[c >> 4];
-        ret[index++] = HEX_DIGITS[c & 0xF];
-    }
+    toHexInto(BytesView(bytes), ret.data());
     return ret;
 }
 
@@ -240,59 +221,195 @@ T fromHex(const std::string_view& hex_view)
         RAISE_ERROR(InvalidArgument, "Invalid string length. Odd line length.");
     }
 
-    auto bytes_size = hex_view.size() / 2;
-    std::vector<Byte> bytes(bytes_size);
-    for (std::size_t current_symbol_index = 0; current_symbol_index < bytes_size; current_symbol_index++) {
-        auto index = current_symbol_index * 2;
-        auto high_part = hexToInt(hex_view[index]);
-        auto low_part = hexToInt(hex_view[index + 1]);
-        bytes[current_symbol_index] = (high_part << 4) + low_part;
+    if constexpr (std::is_same_v<T, Bytes>) {
+        Bytes ret(hex_view.size() / 2);
+        fromHexInto(hex_view, ret.getData());
+        return ret;
+    }
+    else {
+        std::vector<Byte> bytes(hex_view.size() / 2);
+        fromHexInto(hex_view, bytes.data());
+        return T(bytes);
     }
-
-    return T(bytes);
 }
 
 
 template<typename T>
 std::string base64Encode(const T& bytes)
 {
-    if (bytes.size() == 0) {
-        return "";
+    std::string ret(base64EncodedSize(bytes.size()), static_cast<char>(0));
+    base64EncodeInto(BytesView(bytes), ret.data());
+    return ret;
+}
+
+
+static constexpr char pszBase58[59] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+
+namespace
+{
+
+constexpr std::array<std::int8_t, 256> makeBase58DigitsMap()
+{
+    std::array<std::int8_t, 256> map{};
+    for (auto& digit : map) {
+        digit = -1;
+    }
+    for (std::size_t i = 0; i < 58; ++i) {
+        map[static_cast<unsigned char>(pszBase58[i])] = static_cast<std::int8_t>(i);
     }
+    return map;
+}
+
+
+constexpr std::array<std::int8_t, 256> BASE58_DIGITS_MAP = makeBase58DigitsMap();
+
+// 58^5 is the largest power of 58 that fits into 32 bits, so a number kept in 32-bit limbs is converted
+// five base58 digits at a time with 64-bit arithmetic instead of a digit at a time
+constexpr std::uint32_t BASE58_POWER_5 = 656356768;
+constexpr std::size_t BASE58_DIGITS_IN_CHUNK = 5;
+
+
+// limbs go from the most significant, the first one is padded with zero bytes if S is not a multiple of 4
+template<std::size_t S>
+constexpr std::size_t BASE58_LIMBS_COUNT = (S + 3) / 4;
+
+template<std::size_t S>
+constexpr std::size_t BASE58_LIMBS_PADDING = BASE58_LIMBS_COUNT<S> * 4 - S;
 
-    BIO* bio_temp = BIO_new(BIO_s_mem());
-    BIO* b64 = BIO_new(BIO_f_base64());
-    BUF_MEM* bufferPtr = nullptr;
 
-    std::unique_ptr<BIO, decltype(&::BIO_free_all)> bio(BIO_push(b64, bio_temp), ::BIO_free_all);
-    BIO_set_flags(bio.get(), BIO_FLAGS_BASE64_NO_NL);
-    if (BIO_write(bio.get(), bytes.getData(), static_cast<int>(bytes.size())) < 1) {
-        RAISE_ERROR(CryptoError, "Base64 encode write error");
+template<std::size_t S>
+std::string base58EncodeFixed(const Byte* bytes)
+{
+    constexpr std::size_t LIMBS_COUNT = BASE58_LIMBS_COUNT<S>;
+    std::array<std::uint32_t, LIMBS_COUNT> limbs{};
+    for (std::size_t i = 0; i < S; ++i) {
+        const auto position = i + BASE58_LIMBS_PADDING<S>;
+        limbs[position / 4] |= static_cast<std::uint32_t>(bytes[i]) << (8 * (3 - position % 4));
     }
-    if (BIO_flush(bio.get()) < 1) {
-        RAISE_ERROR(CryptoError, "Base64 encode flush error");
+
+    std::size_t zeroes_count = 0;
+    while (zeroes_count < S && bytes[zeroes_count] == 0) {
+        zeroes_count++;
     }
-    if (BIO_get_mem_ptr(bio.get(), &bufferPtr) < 1) {
-        if (bufferPtr) {
-            BUF_MEM_free(bufferPtr);
+
+    // digits are stored starting from the least significant one; the last chunk may add up to 4 extra zeroes
+    std::array<Byte, S * 138 / 100 + BASE58_DIGITS_IN_CHUNK> digits; // log(256) / log(58)
+    std::size_t digits_count = 0;
+    std::size_t first_limb = 0;
+    while (first_limb < LIMBS_COUNT && limbs[first_limb] == 0) {
+        first_limb++;
+    }
+    while (first_limb < LIMBS_COUNT) {
+        std::uint64_t remainder = 0;
+        for (std::size_t i = first_limb; i < LIMBS_COUNT; ++i) {
+            const std::uint64_t current = (remainder << 32) | limbs[i];
+            limbs[i] = static_cast<std::uint32_t>(current / BASE58_POWER_5);
+            remainder = current % BASE58_POWER_5;
+        }
+        while (first_limb < LIMBS_COUNT && limbs[first_limb] == 0) {
+            first_limb++;
         }
-        RAISE_ERROR(CryptoError, "Get pointer to memory from base64 error");
+        for (std::size_t i = 0; i < BASE58_DIGITS_IN_CHUNK; ++i) {
+            digits[digits_count++] = static_cast<Byte>(remainder % 58);
+            remainder /= 58;
+        }
+    }
+    while (digits_count > 0 && digits[digits_count - 1] == 0) {
+        digits_count--;
     }
 
-    std::string base64_bytes(bufferPtr->data, bufferPtr->length);
+    std::string str(zeroes_count + digits_count, '1');
+    for (std::size_t i = 0; i < digits_count; ++i) {
+        str[zeroes_count + i] = pszBase58[digits[digits_count - 1 - i]];
+    }
+    return str;
+}
+
+} // namespace
+
 
-    BUF_MEM_free(bufferPtr);
-    BIO_set_close(bio.get(), BIO_NOCLOSE);
-    return base64_bytes;
+template<std::size_t S>
+std::string base58Encode(const FixedBytes<S>& bytes)
+{
+    return base58EncodeFixed<S>(bytes.getData());
 }
 
 
-static constexpr char pszBase58[59] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+template<std::size_t S>
+FixedBytes<S> base58Decode(std::string_view base58)
+{
+    constexpr std::size_t LIMBS_COUNT = BASE58_LIMBS_COUNT<S>;
+    constexpr std::size_t PADDING = BASE58_LIMBS_PADDING<S>;
+
+    std::size_t zeroes_count = 0;
+    while (zeroes_count < base58.size() && base58[zeroes_count] == '1') {
+        zeroes_count++;
+    }
+
+    std::array<std::uint32_t, LIMBS_COUNT> limbs{};
+    std::size_t current_pos = zeroes_count;
+    while (current_pos != base58.size()) {
+        std::uint32_t chunk = 0;
+        std::uint32_t multiplier = 1;
+        for (std::size_t i = 0; i < BASE58_DIGITS_IN_CHUNK && current_pos != base58.size(); ++i, ++current_pos) {
+            const auto digit = BASE58_DIGITS_MAP[static_cast<unsigned char>(base58[current_pos])];
+            if (digit == -1) {
+                RAISE_ERROR(base::InvalidArgument, "Invalid base58 string");
+            }
+            chunk = chunk * 58 + static_cast<std::uint32_t>(digit);
+            multiplier *= 58;
+        }
+
+        std::uint64_t carry = chunk;
+        for (std::size_t i = LIMBS_COUNT; i-- > 0;) {
+            const std::uint64_t current = static_cast<std::uint64_t>(limbs[i]) * multiplier + carry;
+            limbs[i] = static_cast<std::uint32_t>(current);
+            carry = current >> 32;
+        }
+        if (carry != 0) {
+            RAISE_ERROR(base::InvalidArgument, "Invalid base58 string length");
+        }
+    }
+    if constexpr (PADDING != 0) {
+        if ((limbs[0] >> (8 * (4 - PADDING))) != 0) {
+            RAISE_ERROR(base::InvalidArgument, "Invalid base58 string length");
+        }
+    }
+
+    FixedBytes<S> ret;
+    for (std::size_t i = 0; i < S; ++i) {
+        const auto position = i + PADDING;
+        ret[i] = static_cast<Byte>(limbs[position / 4] >> (8 * (3 - position % 4)));
+    }
+
+    // as in the general decoder every leading '1' stands for a zero byte, so they must give exactly S bytes
+    std::size_t leading_zero_bytes = 0;
+    while (leading_zero_bytes < S && ret[leading_zero_bytes] == 0) {
+        leading_zero_bytes++;
+    }
+    if (leading_zero_bytes != zeroes_count) {
+        RAISE_ERROR(base::InvalidArgument, "Invalid base58 string length");
+    }
+    return ret;
+}
 
 
 template<typename T>
 std::string base58Encode(const T& bytes)
 {
+    if constexpr (std::is_same<T, Bytes>::value || std::is_same<T, BytesView>::value) {
+        // address-sized inputs are the common case
+        switch (bytes.size()) {
+            case 20:
+                return base58EncodeFixed<20>(bytes.getData());
+            case 25:
+                return base58EncodeFixed<25>(bytes.getData());
+            default:
+                break;
+        }
+    }
+
     std::size_t current_pos = 0;
     std::size_t zeroes_count = 0;
     std::size_t length = 0;
@@ -302,10 +419,13 @@ std::string base58Encode(const T& bytes)
     }
 
     base::Bytes b58(bytes.size() * 138 / 100 + 1); // log(256) / log(58)
+    const auto b58_begin = b58.getData();
+    const auto b58_end = b58_begin + b58.size();
     while (current_pos != bytes.size()) {
         auto carry = static_cast<std::size_t>(bytes[current_pos]);
         std::size_t i = 0;
-        for (auto it = b58.toVector().rbegin(); (carry != 0 || i < length) && (it != b58.toVector().rend());
+        for (auto it = std::make_reverse_iterator(b58_end);
+             (carry != 0 || i < length) && (it != std::make_reverse_iterator(b58_begin));
              it++, i++) {
             carry += 256 * (*it);
             *it = carry % 58;
@@ -314,15 +434,15 @@ std::string base58Encode(const T& bytes)
         length = i;
         current_pos++;
     }
-    auto it = b58.toVector().begin() + (b58.size() - length);
-    while (it != b58.toVector().end() && *it == 0) {
+    auto it = b58_end - length;
+    while (it != b58_end && *it == 0) {
         it++;
     }
 
     std::string str;
-    str.reserve(zeroes_count + (b58.toVector().end() - it));
+    str.reserve(zeroes_count + (b58_end - it));
     str.assign(zeroes_count, '1');
-    while (it != b58.toVector().end()) {
+    while (it != b58_end) {
         str += pszBase58[*(it++)];
     }
     return str;
@@ -87,10 +87,30 @@ constexpr std::size_t BC_TARGET_BLOCKS_PER_MINUTE = 1;      // block every 60 /
 constexpr std::size_t BC_DIFFICULTY_RECALCULATION_RATE = 2; // how many blocks must be added to recalculate difficulty
 constexpr std::size_t BC_MAXIMAL_CHANGE_MULTIPLIER = 1'000'000'000; // times complexity could change at once
 constexpr std::size_t BC_EMISSION_VALUE = 1000;
+constexpr std::size_t BC_BLOCK_ARENA_INITIAL_SIZE = 64 * 1024; // memory for temporary objects of a block check
+constexpr std::size_t BC_BLOCK_ARENA_REPORT_PERIOD = 100;       // blocks between reports of the block arena usage
 //------------------------
 
 // rpc
 constexpr const std::uint32_t RPC_PUBLIC_API_VERSION = 1;
+constexpr std::size_t RPC_MAX_LOGS_IN_RESPONSE = 10'000; // logs a single query may return
+constexpr std::size_t RPC_HTTP_MAX_BATCH_SIZE = 100;      // calls in a single batch request, if not set in config
+constexpr std::size_t RPC_MAX_ITEMS_IN_REQUEST = 1'000;   // blocks or transactions a single range/batch call may take
+constexpr std::size_t RPC_SUBSCRIPTION_QUEUE_LIMIT = 1'000; // events a subscriber may lag behind before it is dropped
+constexpr std::size_t RPC_HTTP_MAX_SUBSCRIPTIONS = 32;      // subscriptions of http clients existing at once
+constexpr std::size_t RPC_HTTP_MAX_POLL_TIME = 10'000;     // milliseconds a poll of a subscription may wait for events
+constexpr std::size_t RPC_HTTP_MAX_POLLS_IN_PROGRESS = 8;  // polls waiting at once, each takes an http listener thread
+constexpr std::size_t RPC_HTTP_SUBSCRIPTION_TTL = 60'000;  // milliseconds a subscription lives without being polled
+constexpr std::size_t RPC_GRPC_ASYNC_QUEUE_LIMIT = 1'000;   // calls waiting for a worker, if not set in config
+constexpr std::size_t RPC_RESPONSE_CACHE_SIZE = 64 * 1024 * 1024; // bytes of cached responses, if not set in config
+constexpr std::size_t RPC_RESPONSE_CACHE_REPORT_PERIOD = 10'000; // lookups between reports of a cache hit ratio
+constexpr std::size_t RPC_CACHE_FINALIZATION_DEPTH = 6; // blocks above a block, so it's cached by its number
+//--------------------
+
+// vm
+constexpr std::uint64_t VM_VIEW_CALL_MAX_GAS = 10'000'000; // gas budget of a single read-only call
+constexpr std::size_t VM_VIEW_CALL_TIME_BUDGET = 5'000;    // milliseconds a read-only call may queue and run
+constexpr std::size_t VM_POOL_REPORT_PERIOD = 1'000;       // jobs between reports of the VM pool queueing
 //--------------------
 
 // database
@@ -4,6 +4,7 @@
 #include "base/error.hpp"
 
 #include <leveldb/cache.h>
+#include <leveldb/write_batch.h>
 
 namespace base
 {
@@ -55,6 +56,21 @@ void Database::open(Directory const& path)
 }
 
 
+void Database::putAll(const std::vector<std::pair<Bytes, Bytes>>& items)
+{
+    checkStatus();
+
+    leveldb::WriteBatch batch;
+    for (const auto& [key, value] : items) {
+        batch.Put(impl::toSlice(key), impl::toSlice(value));
+    }
+    auto const status = _database->Write(_write_options, &batch);
+    if (!status.ok()) {
+        RAISE_ERROR(base::DatabaseError, status.ToString());
+    }
+}
+
+
 void Database::checkStatus() const
 {
     if (!_inited) {
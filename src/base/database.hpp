@@ -10,6 +10,8 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace base
 {
@@ -28,6 +30,10 @@ class Database
     template<typename B> // expects base::Bytes or base::FixedBytes<>
     [[nodiscard]] std::optional<Bytes> get(const B& key) const;
 
+    // same as get, but doesn't copy the value into Bytes: it is meant to be read in place through a BytesView
+    template<typename B>
+    [[nodiscard]] std::optional<std::string> getRaw(const B& key) const;
+
     template<typename B>
     bool exists(const B& key) const;
 
@@ -36,6 +42,14 @@ class Database
 
     template<typename B>
     void remove(const B& key);
+
+    // writes all the pairs at once, with a single disk sync
+    void putAll(const std::vector<std::pair<Bytes, Bytes>>& items);
+
+    // calls callback(key, value) with views of the data for keys in [from_key, to_key) in their order,
+    // until the callback returns false; the views are valid only inside the callback
+    template<typename B1, typename B2, typename F>
+    void forEachInRange(const B1& from_key, const B2& to_key, F&& callback) const;
     //======================
   private:
     //======================
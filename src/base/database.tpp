@@ -1,13 +1,32 @@
 #include "database.hpp"
 
+namespace impl
+{
+
+// leveldb slice pointing to the bytes, so keys and values are passed without making a std::string copy
+inline leveldb::Slice toSlice(base::BytesView bytes)
+{
+    return leveldb::Slice(reinterpret_cast<const char*>(bytes.getData()), bytes.size());
+}
+
+
+inline base::BytesView toBytesView(const leveldb::Slice& slice)
+{
+    return base::BytesView(reinterpret_cast<const base::Byte*>(slice.data()), slice.size());
+}
+
+} // namespace impl
+
+
 namespace base
 {
+
 template<typename B1, typename B2>
 void Database::put(const B1& key, const B2& value)
 {
     checkStatus();
 
-    auto const status = _database->Put(_write_options, key.toString(), value.toString());
+    auto const status = _database->Put(_write_options, impl::toSlice(key), impl::toSlice(value));
     if (!status.ok()) {
         RAISE_ERROR(base::DatabaseError, status.ToString());
     }
@@ -16,15 +35,25 @@ void Database::put(const B1& key, const B2& value)
 
 template<typename B>
 std::optional<Bytes> Database::get(const B& key) const
+{
+    if (auto value = getRaw(key)) {
+        return Bytes(*value);
+    }
+    return std::nullopt;
+}
+
+
+template<typename B>
+std::optional<std::string> Database::getRaw(const B& key) const
 {
     checkStatus();
 
     std::string value;
-    auto const status = _database->Get(_read_options, key.toString(), &value);
+    auto const status = _database->Get(_read_options, impl::toSlice(key), &value);
     if (!status.ok()) {
         return std::nullopt;
     }
-    return Bytes(value);
+    return value;
 }
 
 
@@ -34,7 +63,7 @@ bool Database::exists(const B& key) const
     checkStatus();
 
     std::string value;
-    auto const status = _database->Get(_read_options, key.toString(), &value);
+    auto const status = _database->Get(_read_options, impl::toSlice(key), &value);
     if (status.IsNotFound()) {
         return false;
     }
@@ -51,10 +80,28 @@ void Database::remove(const B& key)
 {
     checkStatus();
 
-    auto const status = _database->Delete(_write_options, key.toString());
+    auto const status = _database->Delete(_write_options, impl::toSlice(key));
     if (!status.ok()) {
         RAISE_ERROR(base::DatabaseError, status.ToString());
     }
 }
 
+
+template<typename B1, typename B2, typename F>
+void Database::forEachInRange(const B1& from_key, const B2& to_key, F&& callback) const
+{
+    checkStatus();
+
+    const auto to_slice = impl::toSlice(to_key);
+    std::unique_ptr<leveldb::Iterator> it{ _database->NewIterator(_read_options) };
+    for (it->Seek(impl::toSlice(from_key)); it->Valid() && it->key().compare(to_slice) < 0; it->Next()) {
+        if (!callback(impl::toBytesView(it->key()), impl::toBytesView(it->value()))) {
+            return;
+        }
+    }
+    if (!it->status().ok()) {
+        RAISE_ERROR(base::DatabaseError, it->status().ToString());
+    }
+}
+
 } // namespace base
@@ -103,6 +103,12 @@ Sha256 Sha256::deserialize(SerializationIArchive& ia)
 }
 
 
+std::size_t Sha256::serializedSize() const
+{
+    return base::serializedSize(_bytes);
+}
+
+
 std::ostream& operator<<(std::ostream& os, const Sha256& sha)
 {
     return os << toHex<FixedBytes<Sha256::LENGTH>>(sha.getBytes());
@@ -198,6 +204,12 @@ Sha1 Sha1::deserialize(SerializationIArchive& ia)
 }
 
 
+std::size_t Sha1::serializedSize() const
+{
+    return base::serializedSize(_bytes);
+}
+
+
 std::ostream& operator<<(std::ostream& os, const Sha1& sha)
 {
     return os << base::toHex<FixedBytes<Sha1::LENGTH>>(sha.getBytes());
@@ -304,6 +316,12 @@ Ripemd160 Ripemd160::deserialize(SerializationIArchive& ia)
 }
 
 
+std::size_t Ripemd160::serializedSize() const
+{
+    return base::serializedSize(_bytes);
+}
+
+
 std::ostream& operator<<(std::ostream& os, const Ripemd160& ripemd)
 {
     return os << ripemd.toHex();
@@ -453,6 +471,12 @@ Sha3 Sha3::deserialize(SerializationIArchive& ia)
 }
 
 
+std::size_t Sha3::serializedSize() const
+{
+    return base::serializedSize(_bytes);
+}
+
+
 std::ostream& operator<<(std::ostream& os, const Sha3& sha)
 {
     return os << toHex<Bytes>(sha.getBytes());
@@ -786,6 +810,12 @@ Keccak256 Keccak256::deserialize(SerializationIArchive& ia)
 }
 
 
+std::size_t Keccak256::serializedSize() const
+{
+    return base::serializedSize(_bytes);
+}
+
+
 std::ostream& operator<<(std::ostream& os, const Keccak256& sha)
 {
     return os << base::toHex<FixedBytes<Keccak256::LENGTH>>(sha.getBytes());
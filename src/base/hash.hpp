@@ -40,6 +40,7 @@ class Sha256
     //----------------------------------
     void serialize(SerializationOArchive& oa) const;
     static Sha256 deserialize(SerializationIArchive& ia);
+    std::size_t serializedSize() const;
     //----------------------------------
   private:
     base::FixedBytes<LENGTH> _bytes;
@@ -95,6 +96,7 @@ class Sha1
     //----------------------------------
     void serialize(SerializationOArchive& oa) const;
     static Sha1 deserialize(SerializationIArchive& ia);
+    std::size_t serializedSize() const;
     //----------------------------------
   private:
     base::FixedBytes<LENGTH> _bytes;
@@ -150,6 +152,7 @@ class Ripemd160
     //----------------------------------
     void serialize(SerializationOArchive& oa) const;
     static Ripemd160 deserialize(SerializationIArchive& ia);
+    std::size_t serializedSize() const;
     //----------------------------------
   private:
     base::FixedBytes<LENGTH> _bytes;
@@ -210,6 +213,7 @@ class Sha3
     //----------------------------------
     void serialize(SerializationOArchive& oa) const;
     static Sha3 deserialize(SerializationIArchive& ia);
+    std::size_t serializedSize() const;
     //----------------------------------
   private:
     Sha3Type _type;
@@ -263,6 +267,7 @@ class Keccak256
     //----------------------------------
     void serialize(SerializationOArchive& oa) const;
     static Keccak256 deserialize(SerializationIArchive& ia);
+    std::size_t serializedSize() const;
     //----------------------------------
   private:
     base::FixedBytes<LENGTH> _bytes;
@@ -54,7 +54,9 @@ template<typename T>
     return nb;
 }
 
+// the loop body is never executed, so arguments of a disabled debug log are not even computed
 #define LOG_DEBUG                                                                                                      \
+    while (false)                                                                                                      \
     NullBuffer {}
 #endif
 
@@ -6,12 +6,31 @@ namespace base
 {
 
 
+SerializationOArchive::SerializationOArchive(SerializationFormat format)
+  : _format{ format }
+{}
+
+
+SerializationOArchive::SerializationOArchive(base::Bytes buffer, SerializationFormat format)
+  : _bytes{ std::move(buffer) }
+  , _format{ format }
+{
+    _bytes.clear();
+}
+
+
 void SerializationOArchive::clear()
 {
     _bytes.clear();
 }
 
 
+void SerializationOArchive::reserve(std::size_t size)
+{
+    _bytes.reserve(_bytes.size() + size);
+}
+
+
 const base::Bytes& SerializationOArchive::getBytes() const& noexcept
 {
     return _bytes;
@@ -24,10 +43,32 @@ base::Bytes&& SerializationOArchive::getBytes() && noexcept
 }
 
 
-SerializationIArchive::SerializationIArchive(const base::Bytes& raw)
+SerializationFormat SerializationOArchive::getFormat() const noexcept
+{
+    return _format;
+}
+
+
+SerializationIArchive::SerializationIArchive(BytesView raw, SerializationFormat format)
   : _bytes{ raw }
   , _index{ 0 }
+  , _format{ format }
 {}
 
 
+BytesView SerializationIArchive::getRemaining() const noexcept
+{
+    if (_index >= _bytes.size()) {
+        return BytesView{};
+    }
+    return _bytes.subView(_index, _bytes.size());
+}
+
+
+SerializationFormat SerializationIArchive::getFormat() const noexcept
+{
+    return _format;
+}
+
+
 } // namespace base
\ No newline at end of file
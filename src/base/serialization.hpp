@@ -2,6 +2,8 @@
 
 #include "base/bytes.hpp"
 
+#include <boost/preprocessor.hpp>
+
 #include <cstdint>
 #include <functional>
 #include <optional>
@@ -12,12 +14,23 @@
 namespace base
 {
 
+// FIXED is the canonical layout: this is what hashes and network messages are built on.
+// COMPACT stores BigInteger as a binary magnitude instead of a decimal string, and integers wider than a byte,
+// lengths included, as LEB128 varints (signed ones are zigzag-encoded), so records that are only stored
+// can be made smaller and faster to load
+enum class SerializationFormat
+{
+    FIXED,
+    COMPACT
+};
+
+
 class SerializationIArchive
 {
   public:
     //=================
     // it doesn't copy, so the client must be sure that passed bytes are not removed while this class is used
-    SerializationIArchive(const Bytes& raw);
+    SerializationIArchive(BytesView raw, SerializationFormat format = SerializationFormat::FIXED);
 
     // TODO: work if some of this types is not defined
     //=================
@@ -27,10 +40,19 @@ class SerializationIArchive
     template<typename U, typename V>
     std::pair<U, V> deserialize();
 
+    // reads the same data as deserialize<T>() for T being Bytes, std::string or FixedBytes,
+    // but returns a view into the archive buffer instead of a copy
+    template<typename T>
+    BytesView deserializeView();
+    //=================
+    // part of the buffer that is not read yet
+    BytesView getRemaining() const noexcept;
+    SerializationFormat getFormat() const noexcept;
     //=================
   private:
-    const base::Bytes& _bytes;
+    BytesView _bytes;
     std::size_t _index;
+    SerializationFormat _format;
 };
 
 
@@ -39,9 +61,13 @@ class SerializationOArchive
   public:
     //=================
     SerializationOArchive() = default;
+    explicit SerializationOArchive(SerializationFormat format);
+    // writes into the passed buffer: its content is dropped, but the allocated memory is reused
+    explicit SerializationOArchive(base::Bytes buffer, SerializationFormat format = SerializationFormat::FIXED);
     // TODO: work if some of this types is not defined
     //=================
     void clear();
+    void reserve(std::size_t size);
     //=================
     template<typename T>
     void serialize(const T& v);
@@ -51,23 +77,40 @@ class SerializationOArchive
     //=================
     const base::Bytes& getBytes() const& noexcept;
     base::Bytes&& getBytes() && noexcept;
+    SerializationFormat getFormat() const noexcept;
     //=================
 
   private:
     base::Bytes _bytes;
+    SerializationFormat _format{ SerializationFormat::FIXED };
 };
 
 
+// size of value after serialization; types can provide it with a "std::size_t serializedSize() const" member.
+// It is exact for the FIXED format and only an estimate for the COMPACT one
+template<typename T>
+std::size_t serializedSize(const T& value);
+
+
 template<typename T>
-base::Bytes toBytes(const T& value);
+base::Bytes toBytes(const T& value, SerializationFormat format = SerializationFormat::FIXED);
 
 
+// same as toBytes, but serializes into buffer reusing its memory, so a buffer can be kept and reused between calls
 template<typename T>
-T fromBytes(const base::Bytes& bytes);
+void serializeInto(const T& value, base::Bytes& buffer);
+
+
+template<typename T>
+T fromBytes(const base::Bytes& bytes, SerializationFormat format = SerializationFormat::FIXED);
 
 
 template<typename T, std::size_t S>
-T fromBytes(const base::FixedBytes<S>& bytes);
+T fromBytes(const base::FixedBytes<S>& bytes, SerializationFormat format = SerializationFormat::FIXED);
+
+
+template<typename T>
+T fromBytes(BytesView bytes, SerializationFormat format = SerializationFormat::FIXED);
 
 template<typename T>
 T nativeToBig(const T& value) noexcept;
@@ -79,4 +122,33 @@ T bigToNative(const T& value) noexcept;
 
 } // namespace base
 
+
+#define X_DEFINE_SERIALIZATION_FIELDS_SERIALIZE(r, data, field) oa.serialize(field);
+
+#define X_DEFINE_SERIALIZATION_FIELDS_DESERIALIZE(r, data, i, field)                                                   \
+    BOOST_PP_COMMA_IF(i) ia.deserialize<std::decay_t<decltype(data::field)>>()
+
+#define X_DEFINE_SERIALIZATION_FIELDS_SIZE(r, data, field) +base::serializedSize(field)
+
+// defines inline serialize, deserialize and serializedSize members, that process the listed fields in order.
+// The class is built from the fields with name{ field1, field2, ... }, so it must be either an aggregate
+// with exactly these fields, or have a constructor taking them in the same order.
+// Usage inside the class body: DEFINE_SERIALIZATION_FIELDS(Connect, (address)(public_port)(top_block_hash))
+#define DEFINE_SERIALIZATION_FIELDS(name, fields)                                                                      \
+    void serialize(base::SerializationOArchive& oa) const                                                              \
+    {                                                                                                                  \
+        BOOST_PP_SEQ_FOR_EACH(X_DEFINE_SERIALIZATION_FIELDS_SERIALIZE, name, fields)                                   \
+    }                                                                                                                  \
+                                                                                                                       \
+    [[nodiscard]] static name deserialize(base::SerializationIArchive& ia)                                             \
+    {                                                                                                                  \
+        /* elements of a braced list are evaluated from left to right, so fields are read in order */                  \
+        return name{ BOOST_PP_SEQ_FOR_EACH_I(X_DEFINE_SERIALIZATION_FIELDS_DESERIALIZE, name, fields) };               \
+    }                                                                                                                  \
+                                                                                                                       \
+    std::size_t serializedSize() const                                                                                 \
+    {                                                                                                                  \
+        return 0 BOOST_PP_SEQ_FOR_EACH(X_DEFINE_SERIALIZATION_FIELDS_SIZE, name, fields);                              \
+    }
+
 #include "serialization.tpp"
@@ -4,11 +4,16 @@
 
 #include "base/assert.hpp"
 #include "base/big_integer.hpp"
+#include "base/error.hpp"
 
 #include <boost/asio.hpp>
 #include <boost/endian/conversion.hpp>
 
+#include <algorithm>
+#include <array>
 #include <functional>
+#include <iterator>
+#include <limits>
 
 namespace impl
 {
@@ -54,6 +59,110 @@ void chooseSerializationMethod(base::SerializationOArchive& oa, T&& t)
 }
 
 
+// single-byte integers are stored as is, so containers of them can be copied in one go
+template<typename T>
+constexpr bool is_byte_like_v = std::is_integral<T>::value && sizeof(T) == 1 && !std::is_same<T, bool>::value;
+
+
+template<typename T>
+struct is_fixed_bytes : std::false_type
+{};
+
+
+template<std::size_t S>
+struct is_fixed_bytes<base::FixedBytes<S>> : std::true_type
+{
+    static constexpr std::size_t SIZE = S;
+};
+
+
+template<typename T>
+std::make_unsigned_t<T> zigzagEncode(T value) noexcept
+{
+    using U = std::make_unsigned_t<T>;
+    return static_cast<U>(static_cast<U>(value) << 1) ^ static_cast<U>(value >> (sizeof(T) * 8 - 1));
+}
+
+
+template<typename T>
+T zigzagDecode(std::make_unsigned_t<T> value) noexcept
+{
+    using U = std::make_unsigned_t<T>;
+    return static_cast<T>(static_cast<U>(value >> 1) ^ static_cast<U>(~(value & 1) + 1));
+}
+
+
+template<typename U>
+void appendVarint(base::Bytes& bytes, U value)
+{
+    static_assert(std::is_unsigned<U>::value, "only unsigned values are stored as varints");
+    std::array<base::Byte, (sizeof(U) * 8 + 6) / 7> buffer;
+    std::size_t length = 0;
+    do {
+        auto byte = static_cast<base::Byte>(value & 0x7F);
+        value >>= 7;
+        if (value != 0) {
+            byte |= 0x80;
+        }
+        buffer[length++] = byte;
+    } while (value != 0);
+    bytes.append(buffer.data(), length);
+}
+
+
+// FIXED keeps BigInteger as a decimal string, because block and transaction hashes and network messages are built
+// on it. In COMPACT a BigInteger is this sign byte, a varint length of the magnitude and the magnitude itself
+// in big-endian order without leading zeros
+enum class BigIntegerSign : base::Byte
+{
+    NON_NEGATIVE = 0x01,
+    NEGATIVE = 0x02
+};
+
+
+template<typename T>
+std::size_t bigIntegerMagnitudeLength(const base::BigInteger<T>& magnitude)
+{
+    return magnitude == 0 ? 0 : boost::multiprecision::msb(magnitude) / 8 + 1;
+}
+
+
+// returns a pointer to the next length bytes and moves the index past them
+inline const base::Byte* takeRawBytes(base::BytesView bytes, std::size_t& index, std::size_t length)
+{
+    if (index > bytes.size() || length > bytes.size() - index) {
+        RAISE_ERROR(base::InvalidArgument, "not enough bytes to deserialize");
+    }
+    const base::Byte* ret = bytes.getData() + index;
+    index += length;
+    return ret;
+}
+
+
+// reads a varint written by appendVarint and moves the index past it; only the shortest encoding is accepted
+template<typename U>
+U takeVarint(base::BytesView bytes, std::size_t& index)
+{
+    static_assert(std::is_unsigned<U>::value, "only unsigned values are stored as varints");
+    constexpr unsigned BITS = sizeof(U) * 8;
+    U value = 0;
+    for (unsigned shift = 0;; shift += 7) {
+        const auto byte = *takeRawBytes(bytes, index, 1);
+        const auto payload = static_cast<U>(byte & 0x7F);
+        if (shift >= BITS || (BITS - shift < 7 && (payload >> (BITS - shift)) != 0)) {
+            RAISE_ERROR(base::InvalidArgument, "varint is too long for its type");
+        }
+        value |= static_cast<U>(payload << shift);
+        if ((byte & 0x80) == 0) {
+            if (byte == 0 && shift > 0) {
+                RAISE_ERROR(base::InvalidArgument, "varint is not in its shortest form");
+            }
+            return value;
+        }
+    }
+}
+
+
 template<typename, typename T>
 struct has_deserialize
 {
@@ -83,13 +192,24 @@ template<typename T>
 class global_deserialize
 {
   public:
-    T deserialize(base::SerializationIArchive& ia, const base::Bytes& _bytes, std::size_t& _index)
+    T deserialize(base::SerializationIArchive& ia, base::BytesView _bytes, std::size_t& _index)
     {
         if constexpr (std::is_integral<T>::value) {
             T v;
             static_assert(sizeof(v) == 1 || sizeof(v) == 2 || sizeof(v) == 4 || sizeof(v) == 8,
                           "this integral type is not serializable");
 
+            if constexpr (sizeof(v) != 1) {
+                if (ia.getFormat() == base::SerializationFormat::COMPACT) {
+                    if constexpr (std::is_signed<T>::value) {
+                        return zigzagDecode<T>(takeVarint<std::make_unsigned_t<T>>(_bytes, _index));
+                    }
+                    else {
+                        return takeVarint<T>(_bytes, _index);
+                    }
+                }
+            }
+
             if (_index + sizeof(T) > _bytes.size()) {
                 _index += 120;
             }
@@ -117,14 +237,22 @@ template<typename T>
 class global_deserialize<std::vector<T>>
 {
   public:
-    std::vector<T> deserialize(base::SerializationIArchive& ia, const base::Bytes&, std::size_t&)
+    std::vector<T> deserialize(base::SerializationIArchive& ia, base::BytesView _bytes, std::size_t& _index)
     {
-        std::vector<T> v;
         std::size_t size = ia.deserialize<std::size_t>();
-        for (std::size_t i = 0; i < size; i++) {
-            v.push_back(ia.deserialize<T>());
+        if constexpr (is_byte_like_v<T>) {
+            auto data = reinterpret_cast<const T*>(takeRawBytes(_bytes, _index, size));
+            return std::vector<T>(data, data + size);
+        }
+        else {
+            std::vector<T> v;
+            // every element takes at least one byte, so a corrupted size can't make us reserve too much
+            v.reserve(std::min(size, _bytes.size() - std::min(_index, _bytes.size())));
+            for (std::size_t i = 0; i < size; i++) {
+                v.push_back(ia.deserialize<T>());
+            }
+            return v;
         }
-        return v;
     }
 };
 
@@ -133,14 +261,12 @@ template<typename T>
 class global_deserialize<std::optional<T>>
 {
   public:
-    std::optional<T> deserialize(base::SerializationIArchive& ia, const base::Bytes&, std::size_t&)
+    std::optional<T> deserialize(base::SerializationIArchive& ia, base::BytesView, std::size_t&)
     {
         auto do_we_have_a_value = ia.deserialize<bool>();
         std::optional<T> v;
         if (do_we_have_a_value) {
-            T t;
-            ia >> t;
-            v = t;
+            v = ia.deserialize<T>();
         }
         else {
             v = std::nullopt;
@@ -155,14 +281,9 @@ template<std::size_t S>
 class global_deserialize<base::FixedBytes<S>>
 {
   public:
-    base::FixedBytes<S> deserialize(base::SerializationIArchive& ia, const base::Bytes&, std::size_t&)
+    base::FixedBytes<S> deserialize(base::SerializationIArchive&, base::BytesView _bytes, std::size_t& _index)
     {
-        base::FixedBytes<S> fb;
-        for (std::size_t i = 0; i < S; ++i) {
-            auto b = ia.deserialize<base::Byte>();
-            fb[i] = b;
-        }
-        return fb;
+        return base::FixedBytes<S>(takeRawBytes(_bytes, _index, S), S);
     }
 };
 
@@ -171,15 +292,10 @@ template<>
 class global_deserialize<base::Bytes>
 {
   public:
-    base::Bytes deserialize(base::SerializationIArchive& ia, const base::Bytes&, std::size_t&)
+    base::Bytes deserialize(base::SerializationIArchive& ia, base::BytesView _bytes, std::size_t& _index)
     {
         auto size = ia.deserialize<std::size_t>();
-        base::Bytes bytes(size);
-        for (std::size_t i = 0; i < size; ++i) {
-            auto b = ia.deserialize<base::Byte>();
-            bytes[i] = b;
-        }
-        return bytes;
+        return base::Bytes(takeRawBytes(_bytes, _index, size), size);
     }
 };
 
@@ -188,11 +304,11 @@ template<>
 class global_deserialize<std::string>
 {
   public:
-    std::string deserialize(base::SerializationIArchive& ia, const base::Bytes&, std::size_t&)
+    std::string deserialize(base::SerializationIArchive& ia, base::BytesView _bytes, std::size_t& _index)
     {
-        base::Bytes bytes = ia.deserialize<base::Bytes>();
-        std::string str = bytes.toString();
-        return str;
+        auto size = ia.deserialize<std::size_t>();
+        auto data = reinterpret_cast<const char*>(takeRawBytes(_bytes, _index, size));
+        return std::string(data, size);
     }
 };
 
@@ -201,9 +317,41 @@ template<typename T>
 class global_deserialize<base::BigInteger<T>>
 {
   public:
-    base::BigInteger<T> deserialize(base::SerializationIArchive& ia, const base::Bytes&, std::size_t&)
+    base::BigInteger<T> deserialize(base::SerializationIArchive& ia, base::BytesView _bytes, std::size_t& _index)
     {
-        return base::BigInteger<T>{ ia.deserialize<std::string>() };
+        if (ia.getFormat() == base::SerializationFormat::FIXED) {
+            return base::BigInteger<T>{ ia.deserialize<std::string>() };
+        }
+
+        const auto sign = static_cast<BigIntegerSign>(*takeRawBytes(_bytes, _index, 1));
+        if (sign != BigIntegerSign::NON_NEGATIVE && sign != BigIntegerSign::NEGATIVE) {
+            RAISE_ERROR(base::InvalidArgument, "unknown big integer sign");
+        }
+
+        const auto length = ia.deserialize<std::size_t>();
+        if constexpr (std::numeric_limits<base::BigInteger<T>>::is_bounded) {
+            if (length > (std::numeric_limits<base::BigInteger<T>>::digits + 7) / 8) {
+                RAISE_ERROR(base::InvalidArgument, "big integer is too long for its type");
+            }
+        }
+        const auto* magnitude = takeRawBytes(_bytes, _index, length);
+        if (length > 0 && magnitude[0] == 0) {
+            RAISE_ERROR(base::InvalidArgument, "big integer magnitude has leading zeros");
+        }
+
+        base::BigInteger<T> n{ 0 };
+        if (length > 0) {
+            boost::multiprecision::import_bits(n, magnitude, magnitude + length, 8);
+        }
+        if (sign == BigIntegerSign::NEGATIVE) {
+            if constexpr (std::numeric_limits<base::BigInteger<T>>::is_signed) {
+                n = -n;
+            }
+            else {
+                RAISE_ERROR(base::InvalidArgument, "negative value for an unsigned big integer");
+            }
+        }
+        return n;
     }
 };
 
@@ -244,6 +392,15 @@ class global_serialize
                           "this integral type is not serializable");
 
             if constexpr (sizeof(v) != 1) {
+                if (oa.getFormat() == base::SerializationFormat::COMPACT) {
+                    if constexpr (std::is_signed<T>::value) {
+                        appendVarint(_bytes, zigzagEncode(v));
+                    }
+                    else {
+                        appendVarint(_bytes, v);
+                    }
+                    return;
+                }
                 auto t = base::bigToNative(v);
                 _bytes.append(reinterpret_cast<base::Byte*>(&t), sizeof(v));
             }
@@ -265,11 +422,16 @@ template<typename T>
 class global_serialize<std::vector<T>>
 {
   public:
-    void serialize(base::SerializationOArchive& oa, const std::vector<T>& v, base::Bytes&)
+    void serialize(base::SerializationOArchive& oa, const std::vector<T>& v, base::Bytes& _bytes)
     {
         oa.serialize(v.size());
-        for (const auto& x : v) {
-            oa.serialize(x);
+        if constexpr (is_byte_like_v<T>) {
+            _bytes.append(reinterpret_cast<const base::Byte*>(v.data()), v.size());
+        }
+        else {
+            for (const auto& x : v) {
+                oa.serialize(x);
+            }
         }
     }
 };
@@ -296,11 +458,9 @@ template<std::size_t S>
 class global_serialize<base::FixedBytes<S>>
 {
   public:
-    void serialize(base::SerializationOArchive& oa, const base::FixedBytes<S>& fb, base::Bytes&)
+    void serialize(base::SerializationOArchive&, const base::FixedBytes<S>& fb, base::Bytes& _bytes)
     {
-        for (std::size_t i = 0; i < S; i++) {
-            oa.serialize(fb[i]);
-        }
+        _bytes.append(fb.getData(), S);
     }
 };
 
@@ -309,12 +469,10 @@ template<>
 class global_serialize<base::Bytes>
 {
   public:
-    void serialize(base::SerializationOArchive& oa, const base::Bytes& bytes, base::Bytes&)
+    void serialize(base::SerializationOArchive& oa, const base::Bytes& bytes, base::Bytes& _bytes)
     {
         oa.serialize(bytes.size());
-        for (auto b : bytes.toVector()) {
-            oa.serialize(b);
-        }
+        _bytes.append(bytes);
     }
 };
 
@@ -323,9 +481,11 @@ template<>
 class global_serialize<std::string>
 {
   public:
-    void serialize(base::SerializationOArchive& oa, const std::string& str, base::Bytes&)
+    void serialize(base::SerializationOArchive& oa, const std::string& str, base::Bytes& _bytes)
     {
-        oa.serialize(base::Bytes(str));
+        // same layout as base::Bytes, but without a temporary copy
+        oa.serialize(str.size());
+        _bytes.append(reinterpret_cast<const base::Byte*>(str.data()), str.size());
     }
 };
 
@@ -334,13 +494,215 @@ template<typename T>
 class global_serialize<base::BigInteger<T>>
 {
   public:
-    void serialize(base::SerializationOArchive& oa, const base::BigInteger<T>& n, base::Bytes&)
+    void serialize(base::SerializationOArchive& oa, const base::BigInteger<T>& n, base::Bytes& _bytes)
     {
-        oa.serialize(n.str());
+        if (oa.getFormat() == base::SerializationFormat::FIXED) {
+            oa.serialize(n.str());
+            return;
+        }
+
+        const base::BigInteger<T> magnitude = boost::multiprecision::abs(n);
+        const auto length = bigIntegerMagnitudeLength(magnitude);
+        _bytes.append(static_cast<base::Byte>(n < 0 ? BigIntegerSign::NEGATIVE : BigIntegerSign::NON_NEGATIVE));
+        oa.serialize(length);
+        if (length == 0) {
+            return;
+        }
+        if constexpr (std::numeric_limits<base::BigInteger<T>>::is_bounded) {
+            std::array<base::Byte, (std::numeric_limits<base::BigInteger<T>>::digits + 7) / 8> buffer;
+            boost::multiprecision::export_bits(magnitude, buffer.data(), 8);
+            _bytes.append(buffer.data(), length);
+        }
+        else {
+            std::vector<base::Byte> buffer;
+            buffer.reserve(length);
+            boost::multiprecision::export_bits(magnitude, std::back_inserter(buffer), 8);
+            _bytes.append(buffer.data(), length);
+        }
     }
 };
 
 
+template<typename, typename T>
+struct has_serialized_size
+{
+    static_assert(std::integral_constant<T, false>::value, "Second template parameter needs to be of function type.");
+};
+
+
+template<typename C, typename Ret, typename... Args>
+struct has_serialized_size<C, Ret(Args...)>
+{
+  private:
+    template<typename T>
+    static constexpr auto check(T*) ->
+      typename std::is_same<decltype(std::declval<T>().serializedSize(std::declval<Args>()...)), Ret>::type;
+
+    template<typename>
+    static constexpr std::false_type check(...);
+
+    typedef decltype(check<C>(0)) type;
+
+  public:
+    static constexpr bool value = type::value;
+};
+
+
+// tells whether the size of serialized T can be found without serializing it
+template<typename T>
+struct is_size_precomputable
+{
+    static constexpr bool value = std::is_integral<T>::value || std::is_enum<T>::value ||
+                                  has_serialized_size<const T, std::size_t()>::value;
+};
+
+
+template<typename T>
+struct is_size_precomputable<std::vector<T>> : is_size_precomputable<T>
+{};
+
+
+template<typename T>
+struct is_size_precomputable<std::optional<T>> : is_size_precomputable<T>
+{};
+
+
+template<typename U, typename V>
+struct is_size_precomputable<std::pair<U, V>>
+{
+    static constexpr bool value = is_size_precomputable<U>::value && is_size_precomputable<V>::value;
+};
+
+
+template<std::size_t S>
+struct is_size_precomputable<base::FixedBytes<S>> : std::true_type
+{};
+
+
+template<>
+struct is_size_precomputable<base::Bytes> : std::true_type
+{};
+
+
+template<>
+struct is_size_precomputable<std::string> : std::true_type
+{};
+
+
+template<typename T>
+struct is_size_precomputable<base::BigInteger<T>> : std::true_type
+{};
+
+
+template<typename T>
+class global_serialized_size
+{
+  public:
+    std::size_t serializedSize(const T&)
+    {
+        if constexpr (std::is_integral<T>::value) {
+            return sizeof(T);
+        }
+        else if constexpr (std::is_enum<T>::value) {
+            return sizeof(typename std::underlying_type<T>::type);
+        }
+        else {
+            static_assert(impl::TrickFalse<T>::value, "serialized size of the type cannot be precomputed");
+        }
+    }
+};
+
+
+template<typename T>
+class global_serialized_size<std::vector<T>>
+{
+  public:
+    std::size_t serializedSize(const std::vector<T>& v)
+    {
+        if constexpr (std::is_integral<T>::value || std::is_enum<T>::value) {
+            return sizeof(std::size_t) + v.size() * sizeof(T);
+        }
+        else {
+            std::size_t ret = sizeof(std::size_t);
+            for (const auto& x : v) {
+                ret += base::serializedSize(x);
+            }
+            return ret;
+        }
+    }
+};
+
+
+template<typename T>
+class global_serialized_size<std::optional<T>>
+{
+  public:
+    std::size_t serializedSize(const std::optional<T>& v)
+    {
+        return sizeof(bool) + (v ? base::serializedSize(*v) : 0);
+    }
+};
+
+
+template<typename U, typename V>
+class global_serialized_size<std::pair<U, V>>
+{
+  public:
+    std::size_t serializedSize(const std::pair<U, V>& p)
+    {
+        return base::serializedSize(p.first) + base::serializedSize(p.second);
+    }
+};
+
+
+template<std::size_t S>
+class global_serialized_size<base::FixedBytes<S>>
+{
+  public:
+    std::size_t serializedSize(const base::FixedBytes<S>&) { return S; }
+};
+
+
+template<>
+class global_serialized_size<base::Bytes>
+{
+  public:
+    std::size_t serializedSize(const base::Bytes& bytes) { return sizeof(std::size_t) + bytes.size(); }
+};
+
+
+template<>
+class global_serialized_size<std::string>
+{
+  public:
+    std::size_t serializedSize(const std::string& str) { return sizeof(std::size_t) + str.size(); }
+};
+
+
+template<typename T>
+class global_serialized_size<base::BigInteger<T>>
+{
+  public:
+    std::size_t serializedSize(const base::BigInteger<T>& n)
+    {
+        // the number is stored as a decimal string, but its length is found from the bit length to avoid conversion
+        if (n == 0) {
+            return sizeof(std::size_t) + 1;
+        }
+        const base::BigInteger<T> magnitude = boost::multiprecision::abs(n);
+        const std::size_t bits = boost::multiprecision::msb(magnitude) + 1;
+        std::size_t digits = (bits - 1) * 1233 / 4096 + 1; // lower bound, 1233 / 4096 is a bit less than log10(2)
+        // power is 10^(digits - 1) and never exceeds the magnitude, so it can't overflow
+        base::BigInteger<T> power = boost::multiprecision::pow(base::BigInteger<T>{ 10 }, digits - 1);
+        const base::BigInteger<T> tenth = magnitude / 10;
+        while (power <= tenth) {
+            ++digits;
+            power *= 10;
+        }
+        return sizeof(std::size_t) + (n < 0 ? 1 : 0) + digits;
+    }
+};
+
 } // namespace impl
 
 
@@ -368,6 +730,23 @@ std::pair<U, V> SerializationIArchive::deserialize()
 }
 
 
+template<typename T>
+BytesView SerializationIArchive::deserializeView()
+{
+    if constexpr (std::is_same<T, base::Bytes>::value || std::is_same<T, std::string>::value) {
+        auto size = deserialize<std::size_t>();
+        return BytesView(impl::takeRawBytes(_bytes, _index, size), size);
+    }
+    else if constexpr (impl::is_fixed_bytes<T>::value) {
+        return BytesView(impl::takeRawBytes(_bytes, _index, impl::is_fixed_bytes<T>::SIZE),
+                         impl::is_fixed_bytes<T>::SIZE);
+    }
+    else {
+        static_assert(impl::TrickFalse<T>::value, "type cannot be viewed in place");
+    }
+}
+
+
 template<typename T>
 void SerializationOArchive::serialize(const T& v)
 {
@@ -389,27 +768,63 @@ void SerializationOArchive::serialize(const std::pair<U, V>& p)
 
 
 template<typename T>
-base::Bytes toBytes(const T& value)
+std::size_t serializedSize(const T& value)
+{
+    if constexpr (impl::has_serialized_size<const T, std::size_t()>::value) {
+        return value.serializedSize();
+    }
+    else {
+        return impl::global_serialized_size<T>{}.serializedSize(value);
+    }
+}
+
+
+template<typename T>
+base::Bytes toBytes(const T& value, SerializationFormat format)
 {
-    SerializationOArchive oa;
+    SerializationOArchive oa{ format };
+    if constexpr (impl::is_size_precomputable<T>::value) {
+        oa.reserve(serializedSize(value));
+    }
     oa.serialize(value);
     return std::move(std::move(oa).getBytes());
 }
 
 
 template<typename T>
-T fromBytes(const base::Bytes& bytes)
+void serializeInto(const T& value, base::Bytes& buffer)
+{
+    SerializationOArchive oa{ std::move(buffer) };
+    if constexpr (impl::is_size_precomputable<T>::value) {
+        oa.reserve(serializedSize(value));
+    }
+    oa.serialize(value);
+    buffer = std::move(oa).getBytes();
+}
+
+
+template<typename T>
+T fromBytes(const base::Bytes& bytes, SerializationFormat format)
 {
-    SerializationIArchive ia(bytes);
+    SerializationIArchive ia(bytes, format);
     T t = ia.deserialize<T>();
     return t;
 }
 
 
 template<typename T, std::size_t S>
-T fromBytes(const base::FixedBytes<S>& bytes)
+T fromBytes(const base::FixedBytes<S>& bytes, SerializationFormat format)
+{
+    SerializationIArchive ia(bytes, format);
+    T t = ia.deserialize<T>();
+    return t;
+}
+
+
+template<typename T>
+T fromBytes(BytesView bytes, SerializationFormat format)
 {
-    SerializationIArchive ia(bytes);
+    SerializationIArchive ia(bytes, format);
     T t = ia.deserialize<T>();
     return t;
 }
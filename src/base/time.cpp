@@ -92,6 +92,12 @@ Time Time::deserialize(SerializationIArchive& ia)
 }
 
 
+std::size_t Time::serializedSize() const
+{
+    return sizeof(SerializationType);
+}
+
+
 std::ostream& operator<<(std::ostream& os, const Time& time)
 {
     return os << time.getSeconds();
@@ -41,6 +41,7 @@ class Time
     //=====================
     void serialize(SerializationOArchive& oa) const;
     static Time deserialize(SerializationIArchive& ia);
+    std::size_t serializedSize() const;
     //=====================
   private:
     //=====================
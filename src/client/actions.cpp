@@ -18,9 +18,19 @@
 #include "base/property_tree.hpp"
 #include "base/time.hpp"
 
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
 #include <cstring>
+#include <filesystem>
 #include <iostream>
+#include <optional>
 #include <string>
+#include <thread>
 
 namespace
 {
@@ -36,6 +46,13 @@ constexpr const char* CODE_PATH_OPTION = "code";
 constexpr const char* MESSAGE_OPTION = "message";
 constexpr const char* HASH_OPTION = "hash";
 constexpr const char* NUMBER_OPTION = "number";
+constexpr const char* NO_CACHE_OPTION = "no_cache";
+constexpr const char* METHOD_OPTION = "method";
+constexpr const char* CALLS_OPTION = "calls";
+constexpr const char* THREADS_OPTION = "threads";
+
+constexpr std::size_t DEFAULT_LOAD_TEST_CALLS = 10'000;
+constexpr std::size_t DEFAULT_LOAD_TEST_THREADS = 16;
 
 
 bool checkOptionEmptyAndWriteMessage(const base::ProgramOptionsParser& parser, const char* const option)
@@ -109,9 +126,77 @@ void writeTransactionStatus(const lk::TransactionStatus& status)
         std::cout << "\tMessage: " << status.getMessage() << std::endl;
     }
 
+    for (const auto& log : status.getLogs()) {
+        std::cout << "\tLog: address " << log.address << '\n';
+        for (const auto& topic : log.topics) {
+            std::cout << "\t\tTopic: " << base::toHex(topic) << '\n';
+        }
+        std::cout << "\t\tData: " << base::toHex(log.data) << '\n';
+    }
+
     std::cout.flush();
 }
 
+
+void writeViewCallResult(const lk::ViewCallResult& result)
+{
+    std::string status_message;
+    switch (result.status) {
+        case lk::TransactionStatus::StatusCode::Success:
+            status_message = "success";
+            break;
+        case lk::TransactionStatus::StatusCode::NotEnoughBalance:
+            status_message = "not_enough_balance";
+            break;
+        case lk::TransactionStatus::StatusCode::BadQueryForm:
+            status_message = "bad_query_form";
+            break;
+        case lk::TransactionStatus::StatusCode::Revert:
+            status_message = "revert";
+            break;
+        default:
+            status_message = "failed";
+            break;
+    }
+
+    std::cout << "\tStatus: " << status_message << '\n'
+              << "\tGas used: " << result.gas_used << '\n'
+              << "\tMessage: " << base::toHex(result.output) << std::endl;
+}
+
+
+// cached bytecode is deployed as is, so the cache is kept in a folder, that only the user can access;
+// std::nullopt if there is no such folder, then the compiler is always run
+std::optional<std::filesystem::path> findCompilationCacheFolder()
+{
+    std::filesystem::path cache_home;
+    if (const char* xdg_cache_home = std::getenv("XDG_CACHE_HOME"); xdg_cache_home && *xdg_cache_home) {
+        cache_home = xdg_cache_home;
+    }
+    else if (const char* home = std::getenv("HOME"); home && *home) {
+        cache_home = std::filesystem::path{ home } / ".cache";
+    }
+    else {
+        return std::nullopt;
+    }
+
+    auto folder = cache_home / config::COMPILATION_CACHE_FOLDER;
+    std::error_code ec;
+    std::filesystem::create_directories(folder, ec);
+    std::filesystem::permissions(folder, std::filesystem::perms::owner_all, std::filesystem::perm_options::replace, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+
+    // a folder, that was planted by another user, is not trusted even if it has the right permissions
+    struct stat folder_stat;
+    if (::lstat(folder.c_str(), &folder_stat) != 0 || !S_ISDIR(folder_stat.st_mode) ||
+        folder_stat.st_uid != ::getuid() || (folder_stat.st_mode & (S_IRWXG | S_IRWXO)) != 0) {
+        return std::nullopt;
+    }
+    return folder;
+}
+
 } // namespace
 
 //====================================
@@ -559,6 +644,7 @@ const std::string_view& ActionCompile::getName() const
 void ActionCompile::setupOptionsParser(base::ProgramOptionsParser& parser)
 {
     parser.addOption<std::string>(CODE_PATH_OPTION, "path to a Solidity code");
+    parser.addFlag(NO_CACHE_OPTION, "is set always run the compiler, even if the code was compiled before");
 }
 
 
@@ -568,6 +654,7 @@ int ActionCompile::loadOptions(const base::ProgramOptionsParser& parser)
         return base::config::EXIT_FAIL;
     }
     _code_file_path = parser.getValue<std::string>(CODE_PATH_OPTION);
+    _use_cache = !parser.hasOption(NO_CACHE_OPTION);
 
     return base::config::EXIT_OK;
 }
@@ -577,7 +664,19 @@ int ActionCompile::execute()
 {
     std::optional<vm::Contracts> contracts;
     try {
-        contracts = vm::compile(_code_file_path);
+        std::optional<std::filesystem::path> cache_folder;
+        if (_use_cache) {
+            cache_folder = findCompilationCacheFolder();
+            if (!cache_folder) {
+                LOG_WARNING << "no private folder for the compilation cache, the compiler is run without it";
+            }
+        }
+        if (cache_folder) {
+            contracts = vm::compile(_code_file_path, *cache_folder);
+        }
+        else {
+            contracts = vm::compile(_code_file_path);
+        }
     }
     catch (const base::ParsingError& er) {
         std::cerr << er.what();
@@ -1072,6 +1171,106 @@ int ActionContractCall::execute()
 
 //====================================
 
+ActionContractView::ActionContractView(base::SubprogramRouter& router)
+  : ActionBase{ router }
+  , _fee{ 0 }
+{}
+
+
+const std::string_view& ActionContractView::getName() const
+{
+    static const std::string_view name = "ContractView";
+    return name;
+}
+
+
+void ActionContractView::setupOptionsParser(base::ProgramOptionsParser& parser)
+{
+    parser.addOption<std::string>(HOST_OPTION, "address of host");
+    parser.addOption<std::string>(TO_ADDRESS_OPTION, "address of \"to\" contract");
+    parser.addOption<lk::Balance>(AMOUNT_OPTION, "amount count");
+    parser.addOption<std::uint64_t>(FEE_OPTION, "gas limit of the call");
+    parser.addOption<std::string>(KEYS_DIRECTORY_OPTION, "path to a directory with keys");
+    parser.addOption<std::string>(MESSAGE_OPTION, "message for call smart contract");
+    parser.addFlag(IS_HTTP_CLIENT_OPTION, "is set enable http client call");
+}
+
+
+int ActionContractView::loadOptions(const base::ProgramOptionsParser& parser)
+{
+    if (checkOptionEmptyAndWriteMessage(parser, HOST_OPTION)) {
+        return base::config::EXIT_FAIL;
+    }
+    _host_address = parser.getValue<std::string>(HOST_OPTION);
+
+    if (checkOptionEmptyAndWriteMessage(parser, TO_ADDRESS_OPTION)) {
+        return base::config::EXIT_FAIL;
+    }
+    _to_address = lk::Address{ parser.getValue<std::string>(TO_ADDRESS_OPTION) };
+
+    if (checkOptionEmptyAndWriteMessage(parser, AMOUNT_OPTION)) {
+        return base::config::EXIT_FAIL;
+    }
+    _amount = parser.getValue<lk::Balance>(AMOUNT_OPTION);
+
+    if (checkOptionEmptyAndWriteMessage(parser, FEE_OPTION)) {
+        return base::config::EXIT_FAIL;
+    }
+    _fee = parser.getValue<std::uint64_t>(FEE_OPTION);
+
+    if (checkOptionEmptyAndWriteMessage(parser, KEYS_DIRECTORY_OPTION)) {
+        return base::config::EXIT_FAIL;
+    }
+    _keys_dir = parser.getValue<std::string>(KEYS_DIRECTORY_OPTION);
+
+    if (checkOptionEmptyAndWriteMessage(parser, MESSAGE_OPTION)) {
+        return base::config::EXIT_FAIL;
+    }
+    _message = parser.getValue<std::string>(MESSAGE_OPTION);
+
+    _is_http_mode = parser.hasOption(IS_HTTP_CLIENT_OPTION);
+
+    return base::config::EXIT_OK;
+}
+
+
+int ActionContractView::execute()
+{
+    auto private_key_path = base::config::makePrivateKeyPath(_keys_dir);
+    auto priv = base::Secp256PrivateKey::load(private_key_path);
+    auto from_address = lk::Address(priv.toPublicKey());
+
+    lk::TransactionBuilder txb;
+    txb.setAmount(_amount);
+    txb.setFrom(from_address);
+    txb.setTo(_to_address);
+    txb.setTimestamp(base::Time::now());
+    txb.setFee(_fee);
+    txb.setData(base::fromHex<base::Bytes>(_message));
+
+    auto call = std::move(txb).build(); // view calls are not signed
+
+    LOG_INFO << "Try to connect to rpc server by: " << _host_address;
+    std::unique_ptr<rpc::BaseRpc> client;
+    if (_is_http_mode) {
+        client = rpc::createRpcClient(rpc::ClientMode::HTTP, _host_address);
+    }
+    else {
+        client = rpc::createRpcClient(rpc::ClientMode::GRPC, _host_address);
+    }
+
+    auto result = client->callContractView(call);
+
+    writeViewCallResult(result);
+
+    if (result.status == lk::TransactionStatus::StatusCode::Success) {
+        return base::config::EXIT_OK;
+    }
+    return base::config::EXIT_FAIL;
+}
+
+//====================================
+
 ActionGetTransaction::ActionGetTransaction(base::SubprogramRouter& router)
   : ActionBase{ router }
 {}
@@ -1320,3 +1519,165 @@ int ActionGetBlock::execute()
 
     return base::config::EXIT_OK;
 }
+
+//====================================
+
+ActionLoadTest::ActionLoadTest(base::SubprogramRouter& router)
+  : ActionBase{ router }
+  , _calls_count{ DEFAULT_LOAD_TEST_CALLS }
+  , _threads_count{ DEFAULT_LOAD_TEST_THREADS }
+  , _fee{ 0 }
+{}
+
+
+const std::string_view& ActionLoadTest::getName() const
+{
+    static const std::string_view name = "LoadTest";
+    return name;
+}
+
+
+void ActionLoadTest::setupOptionsParser(base::ProgramOptionsParser& parser)
+{
+    parser.addOption<std::string>(HOST_OPTION, "address of host");
+    parser.addOption<std::string>(METHOD_OPTION, "push_transaction or get_account");
+    parser.addOption<std::size_t>(CALLS_OPTION, "total number of calls, 10000 by default");
+    parser.addOption<std::size_t>(THREADS_OPTION, "number of threads making calls at once, 16 by default");
+    parser.addOption<std::string>(KEYS_DIRECTORY_OPTION, "path to keys of a sender, for push_transaction");
+    parser.addOption<std::uint64_t>(FEE_OPTION, "fee of each transaction, for push_transaction");
+    parser.addOption<std::string>(ADDRESS_OPTION, "address of an account, for get_account");
+    parser.addFlag(IS_HTTP_CLIENT_OPTION, "is set enable http client call");
+}
+
+
+int ActionLoadTest::loadOptions(const base::ProgramOptionsParser& parser)
+{
+    if (checkOptionEmptyAndWriteMessage(parser, HOST_OPTION)) {
+        return base::config::EXIT_FAIL;
+    }
+    _host_address = parser.getValue<std::string>(HOST_OPTION);
+
+    if (checkOptionEmptyAndWriteMessage(parser, METHOD_OPTION)) {
+        return base::config::EXIT_FAIL;
+    }
+    _method = parser.getValue<std::string>(METHOD_OPTION);
+
+    if (_method == "push_transaction") {
+        if (checkOptionEmptyAndWriteMessage(parser, KEYS_DIRECTORY_OPTION)) {
+            return base::config::EXIT_FAIL;
+        }
+        _keys_dir = parser.getValue<std::string>(KEYS_DIRECTORY_OPTION);
+
+        if (checkOptionEmptyAndWriteMessage(parser, FEE_OPTION)) {
+            return base::config::EXIT_FAIL;
+        }
+        _fee = parser.getValue<std::uint64_t>(FEE_OPTION);
+    }
+    else if (_method == "get_account") {
+        if (checkOptionEmptyAndWriteMessage(parser, ADDRESS_OPTION)) {
+            return base::config::EXIT_FAIL;
+        }
+        _account_address = lk::Address{ parser.getValue<std::string>(ADDRESS_OPTION) };
+    }
+    else {
+        std::cerr << "Unknown method " << _method << ", push_transaction or get_account is expected\n";
+        return base::config::EXIT_FAIL;
+    }
+
+    if (parser.hasOption(CALLS_OPTION)) {
+        _calls_count = parser.getValue<std::size_t>(CALLS_OPTION);
+    }
+    if (parser.hasOption(THREADS_OPTION)) {
+        _threads_count = parser.getValue<std::size_t>(THREADS_OPTION);
+    }
+    if (_calls_count == 0 || _threads_count == 0) {
+        std::cerr << "Numbers of calls and threads must be positive\n";
+        return base::config::EXIT_FAIL;
+    }
+
+    _is_http_mode = parser.hasOption(IS_HTTP_CLIENT_OPTION);
+
+    return base::config::EXIT_OK;
+}
+
+
+int ActionLoadTest::execute()
+{
+    using Clock = std::chrono::steady_clock;
+
+    // transactions are signed in advance to measure only the node; amounts differ, so each one is new to the node
+    std::vector<lk::Transaction> txs;
+    if (_method == "push_transaction") {
+        auto private_key = base::Secp256PrivateKey::load(base::config::makePrivateKeyPath(_keys_dir));
+        auto from_address = lk::Address(private_key.toPublicKey());
+        txs.reserve(_calls_count);
+        for (std::size_t i = 0; i < _calls_count; ++i) {
+            lk::TransactionBuilder txb;
+            txb.setFrom(from_address);
+            txb.setTo(from_address);
+            txb.setAmount(lk::Balance{ i + 1 });
+            txb.setTimestamp(base::Time::now());
+            txb.setFee(_fee);
+            txb.setData({});
+            auto tx = std::move(txb).build();
+            tx.sign(private_key);
+            txs.push_back(std::move(tx));
+        }
+    }
+
+    std::vector<std::unique_ptr<rpc::BaseRpc>> clients;
+    for (std::size_t i = 0; i < _threads_count; ++i) {
+        clients.push_back(
+          rpc::createRpcClient(_is_http_mode ? rpc::ClientMode::HTTP : rpc::ClientMode::GRPC, _host_address));
+    }
+
+    std::vector<std::chrono::microseconds> latencies(_calls_count);
+    std::atomic<std::size_t> next_call{ 0 };
+    std::atomic<std::size_t> failed_calls{ 0 };
+
+    auto make_calls = [&](rpc::BaseRpc& client) {
+        for (auto i = next_call++; i < _calls_count; i = next_call++) {
+            auto started_at = Clock::now();
+            try {
+                if (_method == "push_transaction") {
+                    client.pushTransaction(txs[i]);
+                }
+                else {
+                    client.getAccountInfo(_account_address);
+                }
+            }
+            catch (const std::exception& e) {
+                LOG_DEBUG << "call failed: " << e.what();
+                ++failed_calls;
+            }
+            latencies[i] = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - started_at);
+        }
+    };
+
+    LOG_INFO << "Load test of " << _method << " with " << _calls_count << " calls from " << _threads_count
+             << " threads to rpc server " << _host_address;
+    auto started_at = Clock::now();
+    std::vector<std::thread> threads;
+    for (auto& client : clients) {
+        threads.emplace_back(make_calls, std::ref(*client));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto elapsed = std::chrono::duration<double>(Clock::now() - started_at);
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](std::size_t percent) {
+        return latencies[std::min(latencies.size() - 1, latencies.size() * percent / 100)].count();
+    };
+
+    std::cout << "Calls: " << _calls_count << ", failed: " << failed_calls << '\n'
+              << "Threads: " << _threads_count << '\n'
+              << "Time: " << elapsed.count() << " s\n"
+              << "Throughput: " << static_cast<double>(_calls_count) / elapsed.count() << " calls/s\n"
+              << "Latency p50: " << percentile(50) << " us\n"
+              << "Latency p99: " << percentile(99) << " us\n"
+              << "Latency max: " << latencies.back().count() << " us" << std::endl;
+
+    return failed_calls == 0 ? base::config::EXIT_OK : base::config::EXIT_FAIL;
+}
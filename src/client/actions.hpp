@@ -155,6 +155,7 @@ class ActionCompile : public ActionBase
   private:
     //====================================
     std::filesystem::path _code_file_path;
+    bool _use_cache{ true };
     //====================================
 };
 
@@ -267,6 +268,30 @@ class ActionContractCall : public ActionBase
 };
 
 
+class ActionContractView : public ActionBase
+{
+  public:
+    //====================================
+    explicit ActionContractView(base::SubprogramRouter& router);
+    //====================================
+    const std::string_view& getName() const override;
+    void setupOptionsParser(base::ProgramOptionsParser& parser) override;
+    int loadOptions(const base::ProgramOptionsParser& parser) override;
+    int execute() override;
+    //====================================
+  private:
+    //====================================
+    std::string _host_address;
+    lk::Address _to_address{ lk::Address::null() };
+    lk::Balance _amount;
+    std::uint64_t _fee;
+    std::filesystem::path _keys_dir;
+    std::string _message;
+    bool _is_http_mode{ false };
+    //====================================
+};
+
+
 class ActionGetTransaction : public ActionBase
 {
   public:
@@ -326,3 +351,29 @@ class ActionGetBlock : public ActionBase
     bool _is_http_mode{ false };
     //====================================
 };
+
+
+// measures latency and throughput of a node under calls from several threads
+class ActionLoadTest : public ActionBase
+{
+  public:
+    //====================================
+    explicit ActionLoadTest(base::SubprogramRouter& router);
+    //====================================
+    const std::string_view& getName() const override;
+    void setupOptionsParser(base::ProgramOptionsParser& parser) override;
+    int loadOptions(const base::ProgramOptionsParser& parser) override;
+    int execute() override;
+    //====================================
+  private:
+    //====================================
+    std::string _host_address;
+    std::string _method;
+    std::size_t _calls_count;
+    std::size_t _threads_count;
+    std::uint64_t _fee;
+    std::filesystem::path _keys_dir;
+    lk::Address _account_address{ lk::Address::null() };
+    bool _is_http_mode{ false };
+    //====================================
+};
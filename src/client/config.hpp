@@ -10,5 +10,7 @@ constexpr uint32_t API_VERSION = base::config::RPC_PUBLIC_API_VERSION;
 constexpr std::string_view CLIENT_VERSION = "0.1";
 constexpr std::string_view CONTRACT_BINARY_FILE = "compiled_code.bin";
 constexpr std::string_view METADATA_JSON_FILE = "metadata.json";
+// created in the cache directory of the user ($XDG_CACHE_HOME or ~/.cache), accessible only by the user
+constexpr std::string_view COMPILATION_CACHE_FOLDER = "likelib_compilation_cache";
 
 } // namespace config
\ No newline at end of file
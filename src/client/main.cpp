@@ -61,12 +61,17 @@ int main(int argc, char** argv)
           "transfer", "use transfer balance from one address to another address", run<ActionTransfer>);
         router.addSubprogram("push_contract", "deploy a smart contract", run<ActionPushContract>);
         router.addSubprogram("call_contract", "create message to call smart contract", run<ActionContractCall>);
+        router.addSubprogram(
+          "call_contract_view", "call smart contract without creating a transaction", run<ActionContractView>);
 
         router.addSubprogram("get_transaction", "get transaction information", run<ActionGetTransaction>);
         router.addSubprogram(
           "get_transaction_status", "get transaction result information", run<ActionGetTransactionStatus>);
         router.addSubprogram("get_block", "get block information", run<ActionGetBlock>);
 
+        router.addSubprogram(
+          "load_test", "measure latency and throughput of push_transaction or get_account", run<ActionLoadTest>);
+
         return router.process(argc, argv);
     }
     catch (const std::exception& error) {
@@ -13,7 +13,7 @@ Address::Address(const base::FixedBytes<SIGNATURE_LENGTH>& sign)
 
 
 Address::Address(const std::string_view& base58_address)
-  : _address(base::base58Decode(base58_address))
+  : _address(base::base58Decode<Address::LENGTH_IN_BYTES>(base58_address))
 {}
 
 
@@ -42,7 +42,7 @@ bool Address::isNull() const
 
 std::string Address::toString() const
 {
-    return base::base58Encode(_address.toBytes());
+    return base::base58Encode(_address);
 }
 
 
@@ -66,7 +66,7 @@ bool Address::operator!=(const Address& another) const
 
 bool Address::operator<(const Address& other) const
 {
-    return toString() < other.toString();
+    return _address < other._address;
 }
 
 
@@ -82,6 +82,12 @@ void Address::serialize(base::SerializationOArchive& oa) const
 }
 
 
+std::size_t Address::serializedSize() const
+{
+    return LENGTH_IN_BYTES;
+}
+
+
 std::ostream& operator<<(std::ostream& os, const Address& address)
 {
     return os << address.toString();
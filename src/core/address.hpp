@@ -35,6 +35,7 @@ class Address
     bool operator<(const Address& another) const;
     //=============================
     static Address deserialize(base::SerializationIArchive& ia);
+    std::size_t serializedSize() const;
     void serialize(base::SerializationOArchive& oa) const;
     //=============================
 
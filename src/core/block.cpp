@@ -25,35 +25,7 @@ ImmutableBlock::ImmutableBlock(lk::BlockDepth depth,
 
 base::Sha256 ImmutableBlock::computeThisBlockHash()
 {
-    base::SerializationOArchive oa;
-    oa.serialize(*this);
-    return base::Sha256::compute(std::move(oa).getBytes());
-}
-
-
-void ImmutableBlock::serialize(base::SerializationOArchive& oa) const
-{
-    oa.serialize(_depth);
-    oa.serialize(_nonce);
-    oa.serialize(_prev_block_hash);
-    oa.serialize(_timestamp);
-    oa.serialize(_coinbase);
-    oa.serialize(_txs);
-}
-
-
-ImmutableBlock ImmutableBlock::deserialize(base::SerializationIArchive& ia)
-{
-    auto depth = ia.deserialize<BlockDepth>();
-    auto nonce = ia.deserialize<NonceInt>();
-    auto prev_block_hash = ia.deserialize<base::Sha256>();
-    auto timestamp = ia.deserialize<base::Time>();
-    auto coinbase = ia.deserialize<lk::Address>();
-    auto txs = ia.deserialize<TransactionsSet>();
-
-    ImmutableBlock ret{ depth,         nonce, std::move(prev_block_hash), std::move(timestamp), std::move(coinbase),
-                        std::move(txs) };
-    return ret;
+    return base::Sha256::compute(base::toBytes(*this));
 }
 
 
@@ -115,32 +87,6 @@ MutableBlock::MutableBlock(lk::BlockDepth depth,
 {}
 
 
-void MutableBlock::serialize(base::SerializationOArchive& oa) const
-{
-    oa.serialize(_depth);
-    oa.serialize(_nonce);
-    oa.serialize(_prev_block_hash);
-    oa.serialize(_timestamp);
-    oa.serialize(_coinbase);
-    oa.serialize(_txs);
-}
-
-
-MutableBlock MutableBlock::deserialize(base::SerializationIArchive& ia)
-{
-    auto depth = ia.deserialize<BlockDepth>();
-    auto nonce = ia.deserialize<NonceInt>();
-    auto prev_block_hash = ia.deserialize<base::Sha256>();
-    auto timestamp = ia.deserialize<base::Time>();
-    auto coinbase = ia.deserialize<lk::Address>();
-    auto txs = ia.deserialize<TransactionsSet>();
-
-    MutableBlock ret{ depth,         nonce, std::move(prev_block_hash), std::move(timestamp), std::move(coinbase),
-                      std::move(txs) };
-    return ret;
-}
-
-
 lk::BlockDepth MutableBlock::getDepth() const noexcept
 {
     return _depth;
@@ -33,8 +33,7 @@ class ImmutableBlock
 
     ~ImmutableBlock() = default;
     //=================
-    void serialize(base::SerializationOArchive& oa) const;
-    [[nodiscard]] static ImmutableBlock deserialize(base::SerializationIArchive& ia);
+    DEFINE_SERIALIZATION_FIELDS(ImmutableBlock, (_depth)(_nonce)(_prev_block_hash)(_timestamp)(_coinbase)(_txs))
     //=================
     BlockDepth getDepth() const noexcept;
     const base::Sha256& getPrevBlockHash() const noexcept;
@@ -79,8 +78,7 @@ class MutableBlock
 
     ~MutableBlock() = default;
     //=================
-    void serialize(base::SerializationOArchive& oa) const;
-    [[nodiscard]] static MutableBlock deserialize(base::SerializationIArchive& ia);
+    DEFINE_SERIALIZATION_FIELDS(MutableBlock, (_depth)(_nonce)(_prev_block_hash)(_timestamp)(_coinbase)(_txs))
     //=================
     BlockDepth getDepth() const noexcept;
     NonceInt getNonce() const noexcept;
@@ -13,8 +13,9 @@ namespace
 enum class DataType
 {
     SYSTEM = 1,
-    BLOCK = 2,
-    PREVIOUS_BLOCK_HASH = 3
+    BLOCK = 2, // block serialized in FIXED format, written by older versions and still readable
+    PREVIOUS_BLOCK_HASH = 3,
+    COMPACT_BLOCK = 4 // block serialized in COMPACT format
 };
 
 
@@ -246,13 +247,14 @@ IBlockchain::AdditionResult PersistentBlockchain::tryAddBlock(const ImmutableBlo
 void PersistentBlockchain::pushForwardToPersistentStorage(const ImmutableBlock& block)
 {
     const auto raw_block_hash = block.getHash().getBytes();
-    auto serialized_block = base::toBytes(block);
+    auto serialized_block = base::toBytes(block, base::SerializationFormat::COMPACT);
     {
         std::lock_guard lk(_database_rw_mutex);
-        if (_database.exists(toBytes(DataType::BLOCK, raw_block_hash))) {
+        if (_database.exists(toBytes(DataType::COMPACT_BLOCK, raw_block_hash)) ||
+            _database.exists(toBytes(DataType::BLOCK, raw_block_hash))) {
             return;
         }
-        _database.put(toBytes(DataType::BLOCK, raw_block_hash), serialized_block);
+        _database.put(toBytes(DataType::COMPACT_BLOCK, raw_block_hash), serialized_block);
         _database.put(toBytes(DataType::PREVIOUS_BLOCK_HASH, raw_block_hash), block.getPrevBlockHash().getBytes());
         _database.put(LAST_BLOCK_HASH_KEY, raw_block_hash);
     }
@@ -274,12 +276,15 @@ std::optional<base::Sha256> PersistentBlockchain::getLastBlockHashAtPersistentSt
 std::optional<ImmutableBlock> PersistentBlockchain::findBlockAtPersistentStorage(const base::Sha256& block_hash) const
 {
     std::shared_lock lk(_database_rw_mutex);
-    auto block_data = _database.get(toBytes(DataType::BLOCK, block_hash.getBytes()));
-    if (!block_data) {
-        return std::nullopt;
+    if (auto block_data = _database.getRaw(toBytes(DataType::COMPACT_BLOCK, block_hash.getBytes()))) {
+        base::SerializationIArchive ia(base::BytesView(*block_data), base::SerializationFormat::COMPACT);
+        return ia.deserialize<ImmutableBlock>();
+    }
+    if (auto block_data = _database.getRaw(toBytes(DataType::BLOCK, block_hash.getBytes()))) {
+        base::SerializationIArchive ia{ base::BytesView(*block_data) };
+        return ia.deserialize<ImmutableBlock>();
     }
-    base::SerializationIArchive ia(block_data.value());
-    return ia.deserialize<ImmutableBlock>();
+    return std::nullopt;
 }
 
 
@@ -1,10 +1,35 @@
 #include "core.hpp"
 
 #include "base/log.hpp"
+#include "core/gas_estimation.hpp"
 #include "vm/error.hpp"
 #include "vm/tools.hpp"
 
 #include <algorithm>
+#include <sstream>
+#include <utility>
+
+namespace
+{
+
+std::size_t calcVmPoolThreadsNum(const base::PropertyTree& config)
+{
+    if (config.hasKey("vm_pool.threads")) {
+        return config.get<std::size_t>("vm_pool.threads");
+    }
+    else {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+
+bool isVmTraceEnabled(const base::PropertyTree& config)
+{
+    return config.hasKey("vm_trace.enabled") && config.get<bool>("vm_trace.enabled");
+}
+
+} // namespace
+
 
 namespace lk
 {
@@ -14,8 +39,11 @@ Core::Core(const base::PropertyTree& config, const base::KeyVault& key_vault)
   , _vault{ key_vault }
   , _this_node_address{ _vault.getKey().toPublicKey() }
   , _blockchain{ getGenesisBlock(), _config }
+  , _log_index{ _config }
   , _host{ _config, 0xFFFF, *this }
   , _vm{ vm::load() }
+  , _vm_tracer{ isVmTraceEnabled(config) }
+  , _vm_pool{ calcVmPoolThreadsNum(config) }
 {
     _state_manager.updateFromGenesis(getGenesisBlock());
 
@@ -25,7 +53,9 @@ Core::Core(const base::PropertyTree& config, const base::KeyVault& key_vault)
         for (const auto& tx : block.getTransactions()) {
             tryPerformTransaction(tx, block);
         }
+        indexBlockLogs(block);
     }
+    updateTopSnapshot(_blockchain.getTopBlock());
 
     subscribeToNewPendingTransaction([this](const lk::Transaction& tx) { _host.broadcast(tx); });
 
@@ -93,7 +123,7 @@ TransactionStatus Core::addPendingTransaction(const lk::Transaction& tx)
         return status;
     }
 
-    std::map<lk::Address, lk::Balance> current_pending_balance;
+    std::pmr::map<lk::Address, lk::Balance> current_pending_balance;
     {
         std::shared_lock lk(_pending_transactions_mutex);
         if (_pending_transactions.find(tx)) {
@@ -107,9 +137,11 @@ TransactionStatus Core::addPendingTransaction(const lk::Transaction& tx)
         current_pending_balance = lk::calcCost(_pending_transactions);
     }
 
+    // the state of the node is changed by the block processing, so only committed balances are checked
+    const auto state = getTopSnapshot().state;
     const auto& pending_from_account_balance = current_pending_balance.find(tx.getFrom());
-    if ((pending_from_account_balance != current_pending_balance.end()) && (_state_manager.hasAccount(tx.getFrom()))) {
-        auto current_account_balance = _state_manager.getAccount(tx.getFrom()).getBalance();
+    if ((pending_from_account_balance != current_pending_balance.end()) && (state->hasAccount(tx.getFrom()))) {
+        auto current_account_balance = state->getAccount(tx.getFrom()).getBalance();
         if (pending_from_account_balance->second + transaction_cost < current_account_balance) {
             TransactionStatus status{
                 TransactionStatus::StatusCode::NotEnoughBalance, TransactionStatus::ActionType::None, 0, ""
@@ -119,7 +151,7 @@ TransactionStatus Core::addPendingTransaction(const lk::Transaction& tx)
         }
     }
 
-    if (!_state_manager.checkTransaction(tx)) {
+    if (!state->checkTransaction(tx)) {
         TransactionStatus status{
             TransactionStatus::StatusCode::NotEnoughBalance, TransactionStatus::ActionType::None, 0, ""
         };
@@ -156,13 +188,177 @@ std::optional<TransactionStatus> Core::getTransactionOutput(const base::Sha256&
 
 void Core::addTransactionOutput(const base::Sha256& tx, const TransactionStatus& status)
 {
-    std::unique_lock lk(_tx_outputs_mutex);
-    if (auto it = _tx_outputs.find(tx); it != _tx_outputs.end()) {
-        it->second = status;
+    {
+        std::unique_lock lk(_tx_outputs_mutex);
+        if (auto it = _tx_outputs.find(tx); it != _tx_outputs.end()) {
+            it->second = status;
+        }
+        else {
+            _tx_outputs.insert({ tx, status });
+        }
+    }
+    _event_transaction_status_changed.notify(tx, status);
+}
+
+
+void Core::updateTopSnapshot(const ImmutableBlock& top_block)
+{
+    // only accounts changed by the block are copied, the first snapshot is a copy of the loaded state
+    auto state = _state_manager.makeSnapshot(_top_snapshot.state);
+    _top_snapshot = TopSnapshot{ std::make_shared<const ImmutableBlock>(top_block), std::move(state) };
+}
+
+
+Core::TopSnapshot Core::getTopSnapshot() const
+{
+    std::shared_lock lk{ _blockchain_mutex };
+    return _top_snapshot;
+}
+
+
+ViewCallResult Core::callContractView(const lk::Transaction& call)
+{
+    auto snapshot = getTopSnapshot();
+
+    auto gas = std::min(call.getFee(), base::config::VM_VIEW_CALL_MAX_GAS);
+    auto capped_call = std::make_shared<const lk::Transaction>(
+      call.getFrom(), call.getTo(), call.getAmount(), gas, call.getTimestamp(), call.getData());
+
+    // the job owns the call and the snapshot, since it may outlive this call if the time budget runs out
+    return _vm_pool.run(
+      [this, snapshot, capped_call](evmc::VM& vm) {
+          StateManager view{ snapshot.state };
+          return performContractView(vm, view, *snapshot.block, *capped_call);
+      },
+      std::chrono::milliseconds{ base::config::VM_VIEW_CALL_TIME_BUDGET });
+}
+
+
+std::uint64_t Core::estimateGas(const lk::Transaction& tx)
+{
+    auto snapshot = getTopSnapshot();
+    auto estimated_tx = std::make_shared<const lk::Transaction>(tx);
+
+    return _vm_pool.run(
+      [this, snapshot, estimated_tx](evmc::VM& vm) {
+          StateManager overlay{ snapshot.state };
+          return performGasEstimation(vm, overlay, *snapshot.block, *estimated_tx);
+      },
+      std::chrono::milliseconds{ base::config::VM_VIEW_CALL_TIME_BUDGET });
+}
+
+
+std::vector<ContractTrace> Core::getVmTraces() const
+{
+    return _vm_tracer.getTraces();
+}
+
+
+ViewCallResult Core::performContractView(evmc::VM& vm,
+                                         StateManager& view,
+                                         const ImmutableBlock& top_block,
+                                         const lk::Transaction& call)
+{
+    // accounts are looked up through the const view, so they aren't copied into the overlay
+    if (!view.hasAccount(call.getTo()) ||
+        std::as_const(view).getAccount(call.getTo()).getType() != AccountType::CONTRACT) {
+        RAISE_ERROR(base::InvalidArgument, "cannot call view of non-contract account");
+    }
+
+    if (call.getData().size() < 4) { // message must start with a function selector
+        return { TransactionStatus::StatusCode::BadQueryForm, {}, 0 };
+    }
+
+    if (call.getAmount() > 0 && !view.tryTransferMoney(call.getFrom(), call.getTo(), call.getAmount())) {
+        return { TransactionStatus::StatusCode::NotEnoughBalance, {}, 0 };
+    }
+
+    auto code = std::as_const(view).getAccount(call.getTo()).getSharedRuntimeCode();
+    std::vector<EventLog> logs; // views are not mined, so their logs are dropped
+    auto eval_result = callContractVm(vm, view, top_block, call, *code, call.getData(), logs);
+
+    ViewCallResult result{ TransactionStatus::StatusCode::BadQueryForm, {}, call.getFee() - eval_result.gas_left };
+    if (eval_result.status_code == evmc_status_code::EVMC_SUCCESS) {
+        result.status = TransactionStatus::StatusCode::Success;
+        result.output = vm::copy(eval_result.output_data, eval_result.output_size);
+        if (!result.output.isEmpty()) { // same layout as the output of a mined contract call
+            result.output = call.getData().takePart(0, 4).append(result.output);
+        }
+    }
+    else if (eval_result.status_code == evmc_status_code::EVMC_REVERT) {
+        result.status = TransactionStatus::StatusCode::Revert;
+        result.output = vm::copy(eval_result.output_data, eval_result.output_size);
+    }
+    return result;
+}
+
+
+std::uint64_t Core::performGasEstimation(evmc::VM& vm,
+                                         StateManager& overlay,
+                                         const ImmutableBlock& top_block,
+                                         const lk::Transaction& tx)
+{
+    lk::Balance balance{ 0 };
+    if (overlay.hasAccount(tx.getFrom())) {
+        balance = std::as_const(overlay).getAccount(tx.getFrom()).getBalance();
+    }
+    constexpr std::uint64_t MAX_GAS = base::config::VM_VIEW_CALL_MAX_GAS;
+    auto payable_gas = calcPayableGas(balance, tx.getAmount(), MAX_GAS);
+
+    if (tx.getTo() != lk::Address::null()) {
+        if (!overlay.hasAccount(tx.getTo()) ||
+            std::as_const(overlay).getAccount(tx.getTo()).getType() != AccountType::CONTRACT) {
+            return 0; // transfers don't run the VM and are mined with any fee
+        }
+        if (tx.getData().isEmpty()) {
+            RAISE_ERROR(base::InvalidArgument, "contract call has no message");
+        }
+    }
+
+    auto gas = findMinimalGas(payable_gas, [&](std::uint64_t attempt_gas) {
+        return tryRunSpeculatively(vm, overlay, top_block, tx, attempt_gas);
+    });
+    if (gas) {
+        return *gas;
+    }
+    if (payable_gas < MAX_GAS) {
+        RAISE_ERROR(base::InvalidArgument,
+                    "transaction fails with all the gas the balance pays for, " + std::to_string(payable_gas));
+    }
+    RAISE_ERROR(base::InvalidArgument, "transaction fails even with maximal gas " + std::to_string(MAX_GAS));
+}
+
+
+std::optional<std::uint64_t> Core::tryRunSpeculatively(evmc::VM& vm,
+                                                       StateManager& overlay,
+                                                       const ImmutableBlock& top_block,
+                                                       const lk::Transaction& tx,
+                                                       std::uint64_t gas)
+{
+    StateTransaction attempt_state{ overlay }; // never committed, so every attempt starts from the same state
+    lk::Transaction attempt{ tx.getFrom(), tx.getTo(), tx.getAmount(), gas, tx.getTimestamp(), tx.getData() };
+
+    std::optional<evmc::result> eval_result;
+    std::vector<EventLog> logs;
+    if (tx.getTo() == lk::Address::null()) {
+        auto contract_address = overlay.createContractAccount(tx.getFrom(), base::Sha256::compute(tx.getData()));
+        if (!overlay.tryTransferMoney(tx.getFrom(), contract_address, tx.getAmount())) {
+            RAISE_ERROR(base::InvalidArgument, "not enough balance");
+        }
+        eval_result.emplace(callInitContractVm(vm, overlay, top_block, attempt, contract_address, tx.getData(), logs));
     }
     else {
-        _tx_outputs.insert({ tx, status });
+        if (tx.getAmount() > 0 && !overlay.tryTransferMoney(tx.getFrom(), tx.getTo(), tx.getAmount())) {
+            RAISE_ERROR(base::InvalidArgument, "not enough balance");
+        }
+        auto code = std::as_const(overlay).getAccount(tx.getTo()).getSharedRuntimeCode();
+        eval_result.emplace(callContractVm(vm, overlay, top_block, attempt, *code, tx.getData(), logs));
+    }
+
+    if (eval_result->status_code != evmc_status_code::EVMC_SUCCESS) {
+        return std::nullopt;
     }
+    return eval_result->gas_left;
 }
 
 
@@ -200,7 +396,10 @@ Blockchain::AdditionResult Core::_tryAddBlock(const ImmutableBlock& b)
 {
     ASSERT(!_blockchain_mutex.try_lock());
 
-    if (!checkBlockTransactions(b)) { // TODO: place after blockchain checks that are inside tryAddBlock
+    // the balances summed up by checkBlockTransactions live here and are released at once when it's over
+    base::Arena block_arena{ base::config::BC_BLOCK_ARENA_INITIAL_SIZE };
+
+    if (!checkBlockTransactions(b, block_arena)) { // TODO: place after blockchain checks that are inside tryAddBlock
         return Blockchain::AdditionResult::INVALID_TRANSACTIONS;
     }
 
@@ -216,10 +415,29 @@ Blockchain::AdditionResult Core::_tryAddBlock(const ImmutableBlock& b)
     LOG_DEBUG << "Applying transactions from block #" << b.getDepth();
 
     applyBlockTransactions(b);
+    updateTopSnapshot(b);
+    reportBlockArenaIfNeeded(block_arena);
     return Blockchain::AdditionResult::ADDED;
 }
 
 
+void Core::reportBlockArenaIfNeeded(const base::Arena& block_arena)
+{
+    auto& statistics = _block_arena_statistics;
+    ++statistics.blocks;
+    statistics.allocations += block_arena.getAllocationsCount();
+    statistics.bytes += block_arena.getAllocatedBytes();
+    statistics.max_bytes = std::max(statistics.max_bytes, block_arena.getAllocatedBytes());
+
+    if (statistics.blocks % base::config::BC_BLOCK_ARENA_REPORT_PERIOD != 0) {
+        return;
+    }
+    LOG_INFO << "Block arena: " << statistics.blocks << " blocks checked, average "
+             << statistics.allocations / statistics.blocks << " allocations of " << statistics.bytes / statistics.blocks
+             << " bytes per block, max " << statistics.max_bytes << " bytes";
+}
+
+
 std::optional<ImmutableBlock> Core::findBlock(const base::Sha256& hash) const
 {
     return _blockchain.findBlock(hash);
@@ -238,6 +456,14 @@ std::optional<lk::Transaction> Core::findTransaction(const base::Sha256& hash) c
 }
 
 
+std::vector<LogRecord> Core::findLogs(const LogsFilter& filter) const
+{
+    auto bounded_filter = filter;
+    bounded_filter.to_depth = std::min(filter.to_depth, getTopBlock().getDepth());
+    return _log_index.find(bounded_filter, base::config::RPC_MAX_LOGS_IN_RESPONSE);
+}
+
+
 /*
  * Not-thread safe: it is only a helper-function for tryAddBlock.
  * So, it is not meant to be called by anyone else: without locks,
@@ -245,13 +471,13 @@ std::optional<lk::Transaction> Core::findTransaction(const base::Sha256& hash) c
  * chain or state information, but later usage of it becomes useless:
  * until addition the state and chain might have been changed.
  */
-bool Core::checkBlockTransactions(const ImmutableBlock& block) const
+bool Core::checkBlockTransactions(const ImmutableBlock& block, base::Arena& block_arena) const
 {
-    if (_blockchain.findBlock(base::Sha256::compute(base::toBytes(block)))) {
+    if (_blockchain.findBlock(block.getHash())) {
         return false;
     }
 
-    auto block_balance = lk::calcCost(block.getTransactions());
+    auto block_balance = lk::calcCost(block.getTransactions(), &block_arena);
     for (const auto& tx : block.getTransactions()) {
         if (_state_manager.hasAccount(tx.getFrom())) {
             auto current_account_balance = _state_manager.getAccount(tx.getFrom()).getBalance();
@@ -278,7 +504,7 @@ std::pair<MutableBlock, lk::Complexity> Core::getMiningData() const
     auto& complexity = p.second;
 
     lk::BlockDepth depth = top_block.getDepth() + 1;
-    auto prev_hash = base::Sha256::compute(base::toBytes(top_block));
+    auto prev_hash = top_block.getHash();
 
     TransactionsSet pending;
     {
@@ -304,8 +530,9 @@ std::pair<MutableBlock, lk::Complexity> Core::getMiningData() const
 
 lk::AccountInfo Core::getAccountInfo(const lk::Address& address) const
 {
-    if (_state_manager.hasAccount(address)) {
-        auto info = _state_manager.getAccount(address).toInfo();
+    const auto state = getTopSnapshot().state;
+    if (state->hasAccount(address)) {
+        auto info = state->getAccount(address).toInfo();
         info.address = address;
         return info;
     }
@@ -339,6 +566,33 @@ void Core::applyBlockTransactions(const ImmutableBlock& block)
     for (const auto& tx : block.getTransactions()) {
         tryPerformTransaction(tx, block);
     }
+    indexBlockLogs(block);
+
+    // tracing is turned on by the node config, so whoever did it reads the table in a release log too
+    if (_vm_tracer.isEnabled()) {
+        std::ostringstream dump;
+        _vm_tracer.dump(dump);
+        LOG_INFO << "VM trace after block " << block.getDepth() << ":\n" << dump.str();
+    }
+}
+
+
+void Core::indexBlockLogs(const ImmutableBlock& block)
+{
+    if (_log_index.isIndexed(block.getDepth())) {
+        return;
+    }
+
+    std::vector<LogRecord> logs;
+    for (const auto& tx : block.getTransactions()) {
+        auto transaction_hash = tx.hashOfTransaction();
+        if (auto status = getTransactionOutput(transaction_hash)) {
+            for (const auto& log : status->getLogs()) {
+                logs.push_back(LogRecord{ block.getDepth(), transaction_hash, log });
+            }
+        }
+    }
+    _log_index.addBlock(block.getDepth(), logs);
 }
 
 
@@ -348,16 +602,17 @@ void Core::tryPerformTransaction(const lk::Transaction& tx, const ImmutableBlock
     LOG_DEBUG << "Performing transactions with hash " << transaction_hash;
     _state_manager.getAccount(tx.getFrom()).addTransactionHash(transaction_hash);
 
-    auto tx_manager{ _state_manager.createCopy() }; // TODO: temporary of course, fix it using tree of states
+    // changes are undone on any failure, the fee of a reverted call is charged after the rollback
+    StateTransaction tx_state{ _state_manager };
 
     if (tx.getTo() == lk::Address::null()) {
         try {
-            tx_manager.getAccount(tx.getFrom()).subBalance(tx.getFee());
+            _state_manager.getAccount(tx.getFrom()).subBalance(tx.getFee());
 
             auto contract_data_hash = base::Sha256::compute(tx.getData());
-            lk::Address contract_address = tx_manager.createContractAccount(tx.getFrom(), contract_data_hash);
+            lk::Address contract_address = _state_manager.createContractAccount(tx.getFrom(), contract_data_hash);
 
-            if (!tx_manager.tryTransferMoney(tx.getFrom(), contract_address, tx.getAmount())) {
+            if (!_state_manager.tryTransferMoney(tx.getFrom(), contract_address, tx.getAmount())) {
                 TransactionStatus status(TransactionStatus::StatusCode::NotEnoughBalance,
                                          TransactionStatus::ActionType::ContractCreation,
                                          tx.getFee(),
@@ -366,23 +621,26 @@ void Core::tryPerformTransaction(const lk::Transaction& tx, const ImmutableBlock
                 return;
             }
 
-            auto eval_result = callInitContractVm(tx_manager, block_where_tx, tx, contract_address, tx.getData());
+            std::vector<EventLog> logs;
+            auto eval_result =
+              callInitContractVm(_vm, _state_manager, block_where_tx, tx, contract_address, tx.getData(), logs);
 
             if (eval_result.status_code == evmc_status_code::EVMC_SUCCESS) {
                 auto runtime_code = vm::copy(eval_result.output_data, eval_result.output_size);
-                tx_manager.getAccount(contract_address).setRuntimeCode(runtime_code);
+                _state_manager.getAccount(contract_address).setRuntimeCode(runtime_code);
                 LOG_DEBUG << "Deployed contract to address "
                           << base::base58Encode(contract_address.getBytes().toBytes());
                 TransactionStatus status(TransactionStatus::StatusCode::Success,
                                          TransactionStatus::ActionType::ContractCreation,
                                          eval_result.gas_left,
-                                         base::base58Encode(contract_address.getBytes()));
+                                         base::base58Encode(contract_address.getBytes()),
+                                         std::move(logs));
 
                 addTransactionOutput(transaction_hash, status);
-                tx_manager.getAccount(block_where_tx.getCoinbase()).addBalance(tx.getFee() - eval_result.gas_left);
-                tx_manager.getAccount(tx.getFrom()).addBalance(eval_result.gas_left);
+                _state_manager.getAccount(block_where_tx.getCoinbase()).addBalance(tx.getFee() - eval_result.gas_left);
+                _state_manager.getAccount(tx.getFrom()).addBalance(eval_result.gas_left);
 
-                _state_manager.applyChanges(std::move(tx_manager));
+                tx_state.commit();
 
                 return;
             }
@@ -393,6 +651,7 @@ void Core::tryPerformTransaction(const lk::Transaction& tx, const ImmutableBlock
                                          "");
 
                 addTransactionOutput(transaction_hash, status);
+                tx_state.rollback();
                 _state_manager.getAccount(tx.getFrom()).subBalance(eval_result.gas_left);
                 _state_manager.getAccount(block_where_tx.getCoinbase()).addBalance(tx.getFee() - eval_result.gas_left);
                 return;
@@ -403,6 +662,7 @@ void Core::tryPerformTransaction(const lk::Transaction& tx, const ImmutableBlock
                                          eval_result.gas_left,
                                          "");
                 addTransactionOutput(transaction_hash, status);
+                tx_state.rollback();
                 _state_manager.getAccount(tx.getFrom()).subBalance(eval_result.gas_left);
                 _state_manager.getAccount(block_where_tx.getCoinbase()).addBalance(tx.getFee() - eval_result.gas_left);
                 return;
@@ -418,11 +678,9 @@ void Core::tryPerformTransaction(const lk::Transaction& tx, const ImmutableBlock
         ASSERT(false);
     }
     else {
-        lk::AccountState to_account_recovery{ _state_manager.getAccount(tx.getTo()) };
+        _state_manager.getAccount(tx.getFrom()).subBalance(tx.getFee());
 
-        tx_manager.getAccount(tx.getFrom()).subBalance(tx.getFee());
-
-        if (tx_manager.getAccount(tx.getTo()).getType() == AccountType::CONTRACT) {
+        if (_state_manager.getAccount(tx.getTo()).getType() == AccountType::CONTRACT) {
             try {
 
                 if (tx.getData().isEmpty()) {
@@ -434,7 +692,7 @@ void Core::tryPerformTransaction(const lk::Transaction& tx, const ImmutableBlock
                     return;
                 }
 
-                if (tx.getAmount() > 0 && !tx_manager.tryTransferMoney(tx.getFrom(), tx.getTo(), tx.getAmount())) {
+                if (tx.getAmount() > 0 && !_state_manager.tryTransferMoney(tx.getFrom(), tx.getTo(), tx.getAmount())) {
                     TransactionStatus status(TransactionStatus::StatusCode::NotEnoughBalance,
                                              TransactionStatus::ActionType::ContractCall,
                                              tx.getFee(),
@@ -443,8 +701,9 @@ void Core::tryPerformTransaction(const lk::Transaction& tx, const ImmutableBlock
                     return;
                 }
 
-                auto code = tx_manager.getAccount(tx.getTo()).getRuntimeCode();
-                auto eval_result = callContractVm(tx_manager, block_where_tx, tx, code, tx.getData());
+                auto code = _state_manager.getAccount(tx.getTo()).getSharedRuntimeCode();
+                std::vector<EventLog> logs;
+                auto eval_result = callContractVm(_vm, _state_manager, block_where_tx, tx, *code, tx.getData(), logs);
 
 
                 if (eval_result.status_code == evmc_status_code::EVMC_SUCCESS) {
@@ -456,12 +715,14 @@ void Core::tryPerformTransaction(const lk::Transaction& tx, const ImmutableBlock
                     TransactionStatus status(TransactionStatus::StatusCode::Success,
                                              TransactionStatus::ActionType::ContractCall,
                                              eval_result.gas_left,
-                                             base::base64Encode(output_data));
+                                             base::base64Encode(output_data),
+                                             std::move(logs));
 
                     addTransactionOutput(transaction_hash, status);
-                    tx_manager.getAccount(block_where_tx.getCoinbase()).addBalance(tx.getFee() - eval_result.gas_left);
-                    tx_manager.getAccount(tx.getFrom()).addBalance(eval_result.gas_left);
-                    _state_manager.applyChanges(std::move(tx_manager));
+                    _state_manager.getAccount(block_where_tx.getCoinbase())
+                      .addBalance(tx.getFee() - eval_result.gas_left);
+                    _state_manager.getAccount(tx.getFrom()).addBalance(eval_result.gas_left);
+                    tx_state.commit();
                     return;
                 }
                 else if (eval_result.status_code == evmc_status_code::EVMC_REVERT) {
@@ -471,6 +732,7 @@ void Core::tryPerformTransaction(const lk::Transaction& tx, const ImmutableBlock
                                              "");
 
                     addTransactionOutput(transaction_hash, status);
+                    tx_state.rollback();
                     _state_manager.getAccount(tx.getFrom()).subBalance(eval_result.gas_left);
                     _state_manager.getAccount(block_where_tx.getCoinbase())
                       .addBalance(tx.getFee() - eval_result.gas_left);
@@ -482,6 +744,7 @@ void Core::tryPerformTransaction(const lk::Transaction& tx, const ImmutableBlock
                                              eval_result.gas_left,
                                              "");
                     addTransactionOutput(transaction_hash, status);
+                    tx_state.rollback();
                     _state_manager.getAccount(tx.getFrom()).subBalance(eval_result.gas_left);
                     _state_manager.getAccount(block_where_tx.getCoinbase())
                       .addBalance(tx.getFee() - eval_result.gas_left);
@@ -497,7 +760,7 @@ void Core::tryPerformTransaction(const lk::Transaction& tx, const ImmutableBlock
         }
         else {
             try {
-                if (!tx_manager.tryTransferMoney(tx.getFrom(), tx.getTo(), tx.getAmount())) {
+                if (!_state_manager.tryTransferMoney(tx.getFrom(), tx.getTo(), tx.getAmount())) {
                     TransactionStatus status(TransactionStatus::StatusCode::NotEnoughBalance,
                                              TransactionStatus::ActionType::Transfer,
                                              tx.getFee(),
@@ -509,8 +772,8 @@ void Core::tryPerformTransaction(const lk::Transaction& tx, const ImmutableBlock
                   TransactionStatus::StatusCode::Success, TransactionStatus::ActionType::Transfer, 0, {});
 
                 addTransactionOutput(transaction_hash, status);
-                tx_manager.getAccount(block_where_tx.getCoinbase()).addBalance(tx.getFee());
-                _state_manager.applyChanges(std::move(tx_manager));
+                _state_manager.getAccount(block_where_tx.getCoinbase()).addBalance(tx.getFee());
+                tx_state.commit();
                 return;
             }
             catch (const base::Error&) {
@@ -526,11 +789,13 @@ void Core::tryPerformTransaction(const lk::Transaction& tx, const ImmutableBlock
 }
 
 
-evmc::result Core::callInitContractVm(StateManager& state_manager,
+evmc::result Core::callInitContractVm(evmc::VM& vm,
+                                      StateManager& state_manager,
                                       const ImmutableBlock& associated_block,
                                       const Transaction& tx,
                                       const Address& contract_address,
-                                      const base::Bytes& code)
+                                      const base::Bytes& code,
+                                      std::vector<EventLog>& logs)
 {
     evmc_message message{};
     message.kind = evmc_call_kind::EVMC_CALL;
@@ -541,15 +806,17 @@ evmc::result Core::callInitContractVm(StateManager& state_manager,
     message.destination = vm::toEthAddress(contract_address);
     message.value = vm::toEvmcUint256(tx.getAmount());
     message.create2_salt = evmc_bytes32();
-    return callVm(state_manager, associated_block, tx, message, code);
+    return callVm(vm, state_manager, associated_block, tx, message, code, logs);
 }
 
 
-evmc::result Core::callContractVm(StateManager& state_manager,
+evmc::result Core::callContractVm(evmc::VM& vm,
+                                  StateManager& state_manager,
                                   const ImmutableBlock& associated_block,
                                   const Transaction& tx,
                                   const base::Bytes& code,
-                                  const base::Bytes& message_data)
+                                  const base::Bytes& message_data,
+                                  std::vector<EventLog>& logs)
 {
     evmc_message message{};
     message.kind = evmc_call_kind::EVMC_CALL;
@@ -561,18 +828,31 @@ evmc::result Core::callContractVm(StateManager& state_manager,
     message.value = vm::toEvmcUint256(tx.getAmount());
     message.input_data = message_data.getData();
     message.input_size = message_data.size();
-    return callVm(state_manager, associated_block, tx, message, code);
+    return callVm(vm, state_manager, associated_block, tx, message, code, logs);
 }
 
 
-evmc::result Core::callVm(StateManager& state_manager,
+evmc::result Core::callVm(evmc::VM& vm,
+                          StateManager& state_manager,
                           const ImmutableBlock& associated_block,
                           const lk::Transaction& associated_tx,
                           const evmc_message& message,
-                          const base::Bytes& code)
+                          const base::Bytes& code,
+                          std::vector<EventLog>& logs)
 {
-    EthHost _eth_host{ *this, state_manager, associated_block, associated_tx };
-    return _vm.execute(_eth_host, evmc_revision::EVMC_ISTANBUL, message, code.getData(), code.size());
+    // only block application runs on the state of the node, views and gas estimates aren't traced
+    if (!_vm_tracer.isEnabled() || &state_manager != &_state_manager) {
+        EthHost _eth_host{ *this, vm, state_manager, associated_block, associated_tx, logs, nullptr };
+        return vm.execute(_eth_host, evmc_revision::EVMC_ISTANBUL, message, code.getData(), code.size());
+    }
+
+    VmTracer::Frame frame{ vm::toNativeAddress(message.destination), static_cast<std::uint32_t>(message.depth) };
+    EthHost _eth_host{ *this, vm, state_manager, associated_block, associated_tx, logs, &frame };
+    auto result = vm.execute(_eth_host, evmc_revision::EVMC_ISTANBUL, message, code.getData(), code.size());
+    const auto gas_used = message.gas > result.gas_left ? message.gas - result.gas_left : 0;
+    _vm_tracer.record(
+      frame, static_cast<std::uint64_t>(gas_used), result.status_code == evmc_status_code::EVMC_SUCCESS);
+    return result;
 }
 
 
@@ -594,14 +874,26 @@ void Core::subscribeToNewPendingTransaction(decltype(Core::_event_new_pending_tr
 }
 
 
+void Core::subscribeToTransactionStatusChange(decltype(Core::_event_transaction_status_changed)::CallbackType callback)
+{
+    _event_transaction_status_changed.subscribe(std::move(callback));
+}
+
+
 EthHost::EthHost(lk::Core& core,
+                 evmc::VM& vm,
                  lk::StateManager& state_manager,
                  const ImmutableBlock& associated_block,
-                 const lk::Transaction& associated_tx)
+                 const lk::Transaction& associated_tx,
+                 std::vector<EventLog>& logs,
+                 VmTracer::Frame* trace_frame)
   : _core{ core }
+  , _vm{ vm }
   , _state_manager{ state_manager }
   , _associated_block{ associated_block }
   , _associated_tx{ associated_tx }
+  , _logs{ logs }
+  , _trace_frame{ trace_frame }
 {}
 
 
@@ -623,13 +915,16 @@ evmc::bytes32 EthHost::get_storage(const evmc::address& addr, const evmc::bytes3
 {
 
     LOG_DEBUG << "Core::get_storage";
+    if (_trace_frame) {
+        ++_trace_frame->host_calls.storage_reads;
+    }
     try {
         auto address = vm::toNativeAddress(addr);
         LOG_DEBUG << "Core::get_storage from address " << base::base58Encode(address.getBytes().toBytes());
         base::Bytes key(ethKey.bytes, 32);
         if (_state_manager.hasAccount(address)) {
-            auto storage_value = _state_manager.getAccount(address).getStorageValue(base::Sha256(key)).data;
-            return vm::toEvmcBytes32(storage_value);
+            const auto& account_state = std::as_const(_state_manager).getAccount(address);
+            return vm::toEvmcBytes32(account_state.getStorageValue(base::Sha256(key)).data);
         }
         return {};
     }
@@ -644,6 +939,9 @@ evmc_storage_status EthHost::set_storage(const evmc::address& addr,
                                          const evmc::bytes32& evalue) noexcept
 {
     LOG_DEBUG << "Core::set_storage";
+    if (_trace_frame) {
+        ++_trace_frame->host_calls.storage_writes;
+    }
     try {
         static const base::Bytes NULL_VALUE(32);
         auto address = vm::toNativeAddress(addr);
@@ -687,11 +985,14 @@ evmc_storage_status EthHost::set_storage(const evmc::address& addr,
 evmc::uint256be EthHost::get_balance(const evmc::address& addr) const noexcept
 {
     LOG_DEBUG << "Core::get_balance";
+    if (_trace_frame) {
+        ++_trace_frame->host_calls.balance_reads;
+    }
     try {
         auto address = vm::toNativeAddress(addr);
         LOG_DEBUG << "Core::get_balance to address " << base::base58Encode(address.getBytes().toBytes());
         if (_state_manager.hasAccount(address)) {
-            auto balance = _state_manager.getAccount(address).getBalance();
+            auto balance = std::as_const(_state_manager).getAccount(address).getBalance();
             return vm::toEvmcUint256(balance);
         }
         return {};
@@ -705,14 +1006,15 @@ evmc::uint256be EthHost::get_balance(const evmc::address& addr) const noexcept
 size_t EthHost::get_code_size(const evmc::address& addr) const noexcept
 {
     LOG_DEBUG << "Core::get_code_size";
+    if (_trace_frame) {
+        ++_trace_frame->host_calls.code_reads;
+    }
     try {
         auto address = vm::toNativeAddress(addr);
         LOG_DEBUG << "Core::get_code_size to address " << base::base58Encode(address.getBytes().toBytes());
 
         if (_state_manager.hasAccount(address)) {
-            auto account = _state_manager.getAccount(address);
-            const auto& code = _state_manager.getAccount(address).getRuntimeCode();
-            return code.size();
+            return std::as_const(_state_manager).getAccount(address).getRuntimeCode().size();
         }
         return 0;
     }
@@ -725,6 +1027,9 @@ size_t EthHost::get_code_size(const evmc::address& addr) const noexcept
 evmc::bytes32 EthHost::get_code_hash(const evmc::address& addr) const noexcept
 {
     LOG_DEBUG << "Core::get_code_hash";
+    if (_trace_frame) {
+        ++_trace_frame->host_calls.code_reads;
+    }
     try {
         auto address = vm::toNativeAddress(addr);
         LOG_DEBUG << "Core::get_code_hash to address " << base::base58Encode(address.getBytes().toBytes());
@@ -741,10 +1046,13 @@ size_t EthHost::copy_code(const evmc::address& addr, size_t code_offset, uint8_t
   noexcept
 {
     LOG_DEBUG << "Core::copy_code";
+    if (_trace_frame) {
+        ++_trace_frame->host_calls.code_reads;
+    }
     try {
         auto address = vm::toNativeAddress(addr);
         LOG_DEBUG << "Core::copy_code to address " << base::base58Encode(address.getBytes().toBytes());
-        if (auto code = _state_manager.getAccount(address).getRuntimeCode(); code.isEmpty()) {
+        if (const auto& code = _state_manager.getAccount(address).getRuntimeCode(); code_offset >= code.size()) {
             return 0;
         }
         else {
@@ -782,12 +1090,30 @@ void EthHost::selfdestruct(const evmc::address& eaddr, const evmc::address& eben
 evmc::result EthHost::call(const evmc_message& msg) noexcept
 {
     LOG_DEBUG << "Core::call";
+    if (_trace_frame) {
+        ++_trace_frame->host_calls.calls;
+    }
     try {
         lk::Address to = vm::toNativeAddress(msg.destination);
         LOG_DEBUG << "Core::call to address " << base::base58Encode(to.getBytes().toBytes());
         if (_state_manager.hasAccount(to) && _state_manager.getAccount(to).getType() == lk::AccountType::CONTRACT) {
-            const auto& code = _state_manager.getAccount(to).getRuntimeCode();
-            return _core.callVm(_state_manager, _associated_block, _associated_tx, msg, code);
+            // the callee may selfdestruct, so the code is held until the call returns
+            auto code = _state_manager.getAccount(to).getSharedRuntimeCode();
+            // state changes and logs of a failed call are dropped, while the caller may still succeed
+            StateTransaction call_state{ _state_manager };
+            std::vector<EventLog> call_logs;
+            const auto started_at = _trace_frame ? VmTracer::Clock::now() : VmTracer::Clock::time_point{};
+            auto result = _core.callVm(_vm, _state_manager, _associated_block, _associated_tx, msg, *code, call_logs);
+            if (_trace_frame) {
+                _trace_frame->addNestedCallTime(VmTracer::Clock::now() - started_at);
+            }
+            if (result.status_code == evmc_status_code::EVMC_SUCCESS) {
+                call_state.commit();
+                _logs.insert(_logs.end(),
+                             std::make_move_iterator(call_logs.begin()),
+                             std::make_move_iterator(call_logs.end()));
+            }
+            return result;
         }
         else {
             lk::Address from = vm::toNativeAddress(msg.sender);
@@ -840,10 +1166,28 @@ evmc::bytes32 EthHost::get_block_hash(int64_t block_number) const noexcept
 }
 
 
-void EthHost::emit_log(const evmc::address&, const uint8_t*, size_t, const evmc::bytes32[], size_t) noexcept
+void EthHost::emit_log(const evmc::address& addr,
+                       const uint8_t* data,
+                       size_t data_size,
+                       const evmc::bytes32 topics[],
+                       size_t num_topics) noexcept
 {
     LOG_DEBUG << "Core::emit_log";
-    LOG_WARNING << "emit_log is denied. For more information, see docs";
+    if (_trace_frame) {
+        ++_trace_frame->host_calls.logs;
+    }
+    try {
+        EventLog log{ vm::toNativeAddress(addr), {}, base::Bytes(data, data_size) };
+        log.topics.reserve(num_topics);
+        for (std::size_t i = 0; i < num_topics; ++i) {
+            log.topics.emplace_back(topics[i].bytes, sizeof(topics[i].bytes));
+        }
+        LOG_DEBUG << "Core::emit_log from address " << base::base58Encode(log.address.getBytes().toBytes());
+        _logs.push_back(std::move(log));
+    }
+    catch (...) { // cannot pass exceptions since noexcept
+        LOG_ERROR << "Core::emit_log failed to save a log";
+    }
 }
 
 
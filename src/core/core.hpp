@@ -1,13 +1,17 @@
 #pragma once
 
+#include "base/arena.hpp"
 #include "base/crypto.hpp"
 #include "base/property_tree.hpp"
 #include "base/utility.hpp"
 #include "core/block.hpp"
 #include "core/blockchain.hpp"
 #include "core/host.hpp"
+#include "core/log_index.hpp"
 #include "core/managers.hpp"
+#include "core/vm_tracer.hpp"
 
+#include "vm/pool.hpp"
 #include "vm/vm.hpp"
 
 #include <shared_mutex>
@@ -17,6 +21,15 @@ namespace lk
 
 class EthHost;
 
+
+struct ViewCallResult
+{
+    TransactionStatus::StatusCode status;
+    base::Bytes output;
+    std::uint64_t gas_used;
+};
+
+
 class Core
 {
     friend EthHost;
@@ -47,12 +60,52 @@ class Core
     std::optional<TransactionStatus> getTransactionOutput(const base::Sha256& tx_hash);
     void addTransactionOutput(const base::Sha256& tx, const TransactionStatus& status);
     //==================
+    /**
+     *  @brief Executes a contract call against the state at the top block.
+     *
+     *  Nothing is mined and the state of the node is left untouched: the call changes only its own overlay
+     *  of the state snapshot. The fee of the call is used as the gas limit, capped by VM_VIEW_CALL_MAX_GAS;
+     *  the signature is not checked. Runs on the VM pool, so views don't wait for the block processing.
+     *
+     *  @threadsafe
+     */
+    ViewCallResult callContractView(const lk::Transaction& call);
+    /**
+     *  @brief Finds the minimal gas the transaction needs to succeed at the top block.
+     *
+     *  The transaction is run on an overlay of the state snapshot with a binary search on gas,
+     *  up to VM_VIEW_CALL_MAX_GAS or the gas the sender's balance pays for after the amount, if it's less;
+     *  every attempt is rolled back. Transfers need no gas, but the balance must cover the amount.
+     *  Raises if the balance doesn't cover the amount or the transaction fails even with the maximal gas.
+     *
+     *  @threadsafe
+     */
+    std::uint64_t estimateGas(const lk::Transaction& tx);
+    /**
+     *  @brief Statistics of contract executions per contract, collected while the tracing is enabled.
+     *
+     *  Only executions of mined transactions are traced, view calls and gas estimation are not.
+     *
+     *  Tracing is enabled by "vm_trace.enabled" in config, otherwise the result is empty.
+     *  With tracing, the whole table is also written to the info log after each applied block.
+     *
+     *  @threadsafe
+     */
+    std::vector<ContractTrace> getVmTraces() const;
+    //==================
     Blockchain::AdditionResult tryAddBlock(const ImmutableBlock& b);
     Blockchain::AdditionResult tryAddMinedBlock(const ImmutableBlock& b);
     //==================
     std::optional<ImmutableBlock> findBlock(const base::Sha256& hash) const;
     std::optional<base::Sha256> findBlockHash(const lk::BlockDepth& depth) const;
     std::optional<lk::Transaction> findTransaction(const base::Sha256& hash) const;
+    /**
+     *  @brief Finds logs of mined transactions, the range of the filter is limited by the top block.
+     *
+     *  @throws base::InvalidArgument if more than RPC_MAX_LOGS_IN_RESPONSE logs match.
+     *  @threadsafe
+     */
+    std::vector<LogRecord> findLogs(const LogsFilter& filter) const;
     ImmutableBlock getTopBlock() const;
     base::Sha256 getTopBlockHash() const;
     //==================
@@ -69,17 +122,43 @@ class Core
     base::Observable<const ImmutableBlock&> _event_block_added;
     base::Observable<const ImmutableBlock&> _event_block_mined;
     base::Observable<const lk::Transaction&> _event_new_pending_transaction;
+    base::Observable<const base::Sha256&, const TransactionStatus&> _event_transaction_status_changed;
     //==================
+    // changed in place by the block processing, so other threads read _top_snapshot instead
     StateManager _state_manager;
 
     mutable std::shared_mutex _blockchain_mutex;
     PersistentBlockchain _blockchain;
+    LogIndex _log_index;
+
+    // the top block and the state after it, that are shared by read-only calls
+    struct TopSnapshot
+    {
+        std::shared_ptr<const ImmutableBlock> block;
+        std::shared_ptr<const StateManager> state; // never changed, every call runs on its own overlay of it
+    };
+    TopSnapshot _top_snapshot; // guarded by _blockchain_mutex
+    // made once per applied block, under the unique lock
+    void updateTopSnapshot(const ImmutableBlock& top_block);
+    TopSnapshot getTopSnapshot() const;
 
     Blockchain::AdditionResult _tryAddBlock(const ImmutableBlock& b);
 
+    // allocations made in the arenas of added blocks, guarded by _blockchain_mutex
+    struct BlockArenaStatistics
+    {
+        std::size_t blocks{ 0 };
+        std::size_t allocations{ 0 };
+        std::size_t bytes{ 0 };
+        std::size_t max_bytes{ 0 }; // of a single block
+    };
+    BlockArenaStatistics _block_arena_statistics;
+    void reportBlockArenaIfNeeded(const base::Arena& block_arena);
+
     lk::Host _host;
     //==================
     evmc::VM _vm;
+    VmTracer _vm_tracer;
     //==================
     lk::TransactionsSet _pending_transactions;
     mutable std::shared_mutex _pending_transactions_mutex;
@@ -87,29 +166,57 @@ class Core
     std::unordered_map<base::Sha256, TransactionStatus> _tx_outputs;
     mutable std::shared_mutex _tx_outputs_mutex;
     //==================
+    // serves read-only calls outside of the block processing. Declared last, so it's destroyed first:
+    // its jobs use other members of the core and are finished before these members are destroyed
+    vm::Pool _vm_pool;
+    //==================
     static const ImmutableBlock& getGenesisBlock();
     void applyBlockTransactions(const ImmutableBlock& block);
+    // must be called after transactions of the block were performed
+    void indexBlockLogs(const ImmutableBlock& block);
     //==================
     // Only called from tryAddBlock -- just a helper function, not thread safe
-    bool checkBlockTransactions(const ImmutableBlock& block) const;
+    bool checkBlockTransactions(const ImmutableBlock& block, base::Arena& block_arena) const;
     //==================
     void tryPerformTransaction(const lk::Transaction& tx, const ImmutableBlock& block_where_tx);
     //==================
-    evmc::result callInitContractVm(StateManager& state_manager,
+    ViewCallResult performContractView(evmc::VM& vm,
+                                       StateManager& view,
+                                       const ImmutableBlock& top_block,
+                                       const lk::Transaction& call);
+    std::uint64_t performGasEstimation(evmc::VM& vm,
+                                       StateManager& overlay,
+                                       const ImmutableBlock& top_block,
+                                       const lk::Transaction& tx);
+    // returns gas left, if the transaction succeeds with the given gas
+    std::optional<std::uint64_t> tryRunSpeculatively(evmc::VM& vm,
+                                                     StateManager& overlay,
+                                                     const ImmutableBlock& top_block,
+                                                     const lk::Transaction& tx,
+                                                     std::uint64_t gas);
+    //==================
+    evmc::result callInitContractVm(evmc::VM& vm,
+                                    StateManager& state_manager,
                                     const ImmutableBlock& associated_block,
                                     const lk::Transaction& tx,
                                     const lk::Address& contract_address,
-                                    const base::Bytes& code);
-    evmc::result callContractVm(StateManager& state_manager,
+                                    const base::Bytes& code,
+                                    std::vector<EventLog>& logs);
+    evmc::result callContractVm(evmc::VM& vm,
+                                StateManager& state_manager,
                                 const ImmutableBlock& associated_block,
                                 const lk::Transaction& tx,
                                 const base::Bytes& code,
-                                const base::Bytes& message_data);
-    evmc::result callVm(StateManager& state_manager,
+                                const base::Bytes& message_data,
+                                std::vector<EventLog>& logs);
+    // logs emitted by the call are appended to logs
+    evmc::result callVm(evmc::VM& vm,
+                        StateManager& state_manager,
                         const ImmutableBlock& associated_block,
                         const lk::Transaction& associated_tx,
                         const evmc_message& message,
-                        const base::Bytes& code);
+                        const base::Bytes& code,
+                        std::vector<EventLog>& logs);
 
   public:
     //==================
@@ -121,6 +228,9 @@ class Core
 
     // notifies if some transaction was added to set of pending
     void subscribeToNewPendingTransaction(decltype(_event_new_pending_transaction)::CallbackType callback);
+
+    // notifies if an output of some transaction was set: on its push and then on its execution in a block
+    void subscribeToTransactionStatusChange(decltype(_event_transaction_status_changed)::CallbackType callback);
     //==================
 };
 
@@ -129,9 +239,12 @@ class EthHost : public evmc::Host
 {
   public:
     EthHost(lk::Core& core,
+            evmc::VM& vm,
             lk::StateManager& state_manager,
             const ImmutableBlock& associated_block,
-            const lk::Transaction& associated_tx);
+            const lk::Transaction& associated_tx,
+            std::vector<EventLog>& logs,
+            VmTracer::Frame* trace_frame);
 
     bool account_exists(const evmc::address& addr) const noexcept override;
 
@@ -158,13 +271,20 @@ class EthHost : public evmc::Host
 
     evmc::bytes32 get_block_hash(int64_t block_number) const noexcept override;
 
-    void emit_log(const evmc::address&, const uint8_t*, size_t, const evmc::bytes32[], size_t) noexcept;
+    void emit_log(const evmc::address& addr,
+                  const uint8_t* data,
+                  size_t data_size,
+                  const evmc::bytes32 topics[],
+                  size_t num_topics) noexcept override;
 
   private:
     Core& _core;
+    evmc::VM& _vm;
     StateManager& _state_manager;
     const ImmutableBlock& _associated_block;
     const Transaction& _associated_tx;
+    std::vector<EventLog>& _logs;
+    VmTracer::Frame* _trace_frame; // nullptr if tracing is disabled
 };
 
 } // namespace core
@@ -0,0 +1,102 @@
+#include "event_log.hpp"
+
+namespace
+{
+
+// 3 bits set by a value: each is taken from a pair of bytes of its hash
+template<typename F>
+void forEachBloomBit(const base::Bytes& value, F&& f)
+{
+    constexpr std::size_t BITS_COUNT = lk::LogsBloom::SIZE_IN_BYTES * 8;
+    const auto hash = base::Keccak256::compute(value).getBytes();
+    for (std::size_t i = 0; i < 6; i += 2) {
+        std::size_t bit = ((static_cast<std::size_t>(hash[i]) << 8) | hash[i + 1]) % BITS_COUNT;
+        f(lk::LogsBloom::SIZE_IN_BYTES - 1 - bit / 8, static_cast<base::Byte>(1 << (bit % 8)));
+    }
+}
+
+} // namespace
+
+
+namespace lk
+{
+
+bool EventLog::operator==(const EventLog& other) const
+{
+    return address == other.address && topics == other.topics && data == other.data;
+}
+
+
+bool EventLog::operator!=(const EventLog& other) const
+{
+    return !(*this == other);
+}
+
+
+LogsBloom::LogsBloom(const base::FixedBytes<SIZE_IN_BYTES>& bits)
+  : _bits{ bits }
+{}
+
+
+void LogsBloom::add(const EventLog& log)
+{
+    add(base::Bytes(log.address.getBytes()));
+    for (const auto& topic : log.topics) {
+        add(base::Bytes(topic));
+    }
+}
+
+
+void LogsBloom::add(const base::Bytes& value)
+{
+    forEachBloomBit(value, [this](std::size_t byte_index, base::Byte mask) { _bits[byte_index] |= mask; });
+}
+
+
+bool LogsBloom::mayContain(const base::Bytes& value) const
+{
+    bool ret = true;
+    forEachBloomBit(value, [this, &ret](std::size_t byte_index, base::Byte mask) {
+        ret = ret && (_bits[byte_index] & mask) != 0;
+    });
+    return ret;
+}
+
+
+const base::FixedBytes<LogsBloom::SIZE_IN_BYTES>& LogsBloom::getBytes() const noexcept
+{
+    return _bits;
+}
+
+
+bool LogsFilter::matches(const EventLog& log) const
+{
+    if (address && *address != log.address) {
+        return false;
+    }
+    if (topics.size() > log.topics.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < topics.size(); ++i) {
+        if (topics[i] && *topics[i] != log.topics[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+bool LogsFilter::mayMatch(const LogsBloom& bloom) const
+{
+    if (address && !bloom.mayContain(base::Bytes(address->getBytes()))) {
+        return false;
+    }
+    for (const auto& topic : topics) {
+        if (topic && !bloom.mayContain(base::Bytes(*topic))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace lk
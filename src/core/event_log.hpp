@@ -0,0 +1,79 @@
+#pragma once
+
+#include "core/address.hpp"
+#include "core/types.hpp"
+
+#include "base/bytes.hpp"
+#include "base/hash.hpp"
+#include "base/serialization.hpp"
+
+#include <optional>
+#include <vector>
+
+namespace lk
+{
+
+using LogTopic = base::FixedBytes<32>;
+
+
+// event emitted by a contract with one of LOG0..LOG4 instructions
+struct EventLog
+{
+    Address address;
+    std::vector<LogTopic> topics;
+    base::Bytes data;
+    //=================
+    bool operator==(const EventLog& other) const;
+    bool operator!=(const EventLog& other) const;
+    //=================
+    DEFINE_SERIALIZATION_FIELDS(EventLog, (address)(topics)(data))
+};
+
+
+// log together with the place where it was emitted
+struct LogRecord
+{
+    BlockDepth block_depth;
+    base::Sha256 transaction_hash;
+    EventLog log;
+    //=================
+    DEFINE_SERIALIZATION_FIELDS(LogRecord, (block_depth)(transaction_hash)(log))
+};
+
+
+// 2048 bits filter of addresses and topics of logs, built the same way as the logs bloom of Ethereum
+class LogsBloom
+{
+  public:
+    //=================
+    static constexpr std::size_t SIZE_IN_BYTES = 256;
+    //=================
+    LogsBloom() = default;
+    explicit LogsBloom(const base::FixedBytes<SIZE_IN_BYTES>& bits);
+    //=================
+    void add(const EventLog& log);
+    void add(const base::Bytes& value);
+    // false means that the value was never added, true may be a false positive
+    bool mayContain(const base::Bytes& value) const;
+    //=================
+    const base::FixedBytes<SIZE_IN_BYTES>& getBytes() const noexcept;
+    //=================
+  private:
+    base::FixedBytes<SIZE_IN_BYTES> _bits;
+};
+
+
+struct LogsFilter
+{
+    BlockDepth from_depth{ 0 };
+    BlockDepth to_depth{ 0 }; // inclusive
+    std::optional<Address> address;
+    // topic at the same position of a log must be equal, std::nullopt matches any topic
+    std::vector<std::optional<LogTopic>> topics;
+    //=================
+    bool matches(const EventLog& log) const;
+    // false means that the block with this bloom has no matching logs
+    bool mayMatch(const LogsBloom& bloom) const;
+};
+
+} // namespace lk
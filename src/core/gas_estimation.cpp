@@ -0,0 +1,46 @@
+#include "gas_estimation.hpp"
+
+#include "base/error.hpp"
+
+namespace lk
+{
+
+std::optional<std::uint64_t> findMinimalGas(std::uint64_t max_gas, const GasRunFn& try_run)
+{
+    auto gas_left = try_run(max_gas);
+    if (!gas_left) {
+        return std::nullopt;
+    }
+
+    std::uint64_t failing_gas = max_gas - *gas_left;
+    if (try_run(failing_gas)) {
+        return failing_gas;
+    }
+
+    std::uint64_t succeeding_gas = max_gas;
+    while (succeeding_gas - failing_gas > 1) {
+        auto middle_gas = failing_gas + (succeeding_gas - failing_gas) / 2;
+        if (try_run(middle_gas)) {
+            succeeding_gas = middle_gas;
+        }
+        else {
+            failing_gas = middle_gas;
+        }
+    }
+    return succeeding_gas;
+}
+
+
+std::uint64_t calcPayableGas(const Balance& balance, const Balance& amount, std::uint64_t max_gas)
+{
+    if (balance < amount) {
+        RAISE_ERROR(base::InvalidArgument, "not enough balance");
+    }
+    auto payable = balance - amount;
+    if (payable > max_gas) {
+        return max_gas;
+    }
+    return payable.convert_to<std::uint64_t>();
+}
+
+} // namespace lk
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "core/types.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+namespace lk
+{
+
+// runs a transaction with the given gas on a state that is rolled back afterwards, returns gas left if it succeeded
+using GasRunFn = std::function<std::optional<std::uint64_t>(std::uint64_t gas)>;
+
+
+/**
+ *  @brief Finds the minimal gas, up to max_gas, with which the transaction succeeds.
+ *
+ *  Gas used with max_gas is the lower bound and in most cases it's already enough. Otherwise, e.g. if a contract
+ *  checks gas left before a nested call, the gas is found by a binary search between the two bounds.
+ *
+ *  @return std::nullopt if the transaction fails even with max_gas.
+ */
+std::optional<std::uint64_t> findMinimalGas(std::uint64_t max_gas, const GasRunFn& try_run);
+
+
+/**
+ *  @brief Gas a sender can pay for a transaction, the fee is taken from the balance left after the amount.
+ *
+ *  @return at most max_gas.
+ *  @throws base::InvalidArgument if the balance doesn't cover the amount.
+ */
+std::uint64_t calcPayableGas(const Balance& balance, const Balance& amount, std::uint64_t max_gas);
+
+} // namespace lk
@@ -0,0 +1,165 @@
+#include "log_index.hpp"
+
+#include "base/assert.hpp"
+#include "base/error.hpp"
+#include "base/log.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <limits>
+
+namespace
+{
+
+constexpr const char* LOGS_DATABASE_FOLDER = "logs";
+
+
+enum class DataType
+{
+    INDEXED_BLOCK = 1, // marks a processed block, whether it has logs or not
+    BLOCK_LOGS = 2,    // all logs of a block in the order of emission
+    BLOOM = 3,         // bloom of a block with logs
+    ADDRESS = 4,       // address emitted a log in the block
+    TOPIC = 5          // some log of the block has the topic
+};
+
+
+// depth is written in big endian, so that keys of one type and prefix are ordered by depth
+base::Bytes toKey(DataType type, const base::Bytes& prefix, lk::BlockDepth depth)
+{
+    const auto big_endian_depth = base::nativeToBig(depth);
+    base::Bytes key;
+    key.append(static_cast<base::Byte>(type));
+    key.append(prefix);
+    key.append(reinterpret_cast<const base::Byte*>(&big_endian_depth), sizeof(big_endian_depth));
+    return key;
+}
+
+
+lk::BlockDepth depthFromKey(base::BytesView key)
+{
+    lk::BlockDepth big_endian_depth;
+    ASSERT(key.size() >= sizeof(big_endian_depth));
+    std::copy_n(key.getData() + key.size() - sizeof(big_endian_depth),
+                sizeof(big_endian_depth),
+                reinterpret_cast<base::Byte*>(&big_endian_depth));
+    return base::bigToNative(big_endian_depth);
+}
+
+} // namespace
+
+
+namespace lk
+{
+
+LogIndex::LogIndex(const base::PropertyTree& config)
+{
+    // lives inside the blockchain database folder, so it is cleaned together with the blocks logs are made of
+    auto database_path = std::filesystem::path(config.get<std::string>("database.path")) / LOGS_DATABASE_FOLDER;
+    _database = base::createDefaultDatabaseInstance(base::Directory(database_path));
+    LOG_INFO << "Loaded logs database by path: " << database_path;
+}
+
+
+void LogIndex::addBlock(BlockDepth depth, const std::vector<LogRecord>& logs)
+{
+    if (isIndexed(depth)) {
+        return;
+    }
+
+    std::vector<std::pair<base::Bytes, base::Bytes>> items;
+    if (!logs.empty()) {
+        LogsBloom bloom;
+        for (const auto& record : logs) {
+            bloom.add(record.log);
+            items.emplace_back(toKey(DataType::ADDRESS, base::Bytes(record.log.address.getBytes()), depth),
+                               base::Bytes{});
+            for (const auto& topic : record.log.topics) {
+                items.emplace_back(toKey(DataType::TOPIC, base::Bytes(topic), depth), base::Bytes{});
+            }
+        }
+        items.emplace_back(toKey(DataType::BLOCK_LOGS, {}, depth), base::toBytes(logs));
+        items.emplace_back(toKey(DataType::BLOOM, {}, depth), base::Bytes(bloom.getBytes()));
+    }
+    // written last, so a block is marked as indexed only together with its logs
+    items.emplace_back(toKey(DataType::INDEXED_BLOCK, {}, depth), base::Bytes{});
+    _database.putAll(items);
+}
+
+
+bool LogIndex::isIndexed(BlockDepth depth) const
+{
+    return _database.exists(toKey(DataType::INDEXED_BLOCK, {}, depth));
+}
+
+
+std::optional<LogsBloom> LogIndex::findBloom(BlockDepth depth) const
+{
+    if (auto bloom_data = _database.get(toKey(DataType::BLOOM, {}, depth))) {
+        return LogsBloom{ base::FixedBytes<LogsBloom::SIZE_IN_BYTES>(*bloom_data) };
+    }
+    return std::nullopt;
+}
+
+
+std::vector<LogRecord> LogIndex::find(const LogsFilter& filter, std::size_t max_count) const
+{
+    std::vector<LogRecord> ret;
+    for (auto depth : findCandidateDepths(filter)) {
+        // the bloom covers all conditions of the filter, while the index was searched by one of them
+        if (auto bloom = findBloom(depth); !bloom || !filter.mayMatch(*bloom)) {
+            continue;
+        }
+
+        auto logs_data = _database.getRaw(toKey(DataType::BLOCK_LOGS, {}, depth));
+        if (!logs_data) {
+            continue;
+        }
+        base::SerializationIArchive ia{ base::BytesView(*logs_data) };
+        for (auto& record : ia.deserialize<std::vector<LogRecord>>()) {
+            if (!filter.matches(record.log)) {
+                continue;
+            }
+            if (ret.size() == max_count) {
+                RAISE_ERROR(base::InvalidArgument,
+                            "more than " + std::to_string(max_count) + " logs match the filter, narrow it down");
+            }
+            ret.push_back(std::move(record));
+        }
+    }
+    return ret;
+}
+
+
+std::vector<BlockDepth> LogIndex::findCandidateDepths(const LogsFilter& filter) const
+{
+    std::vector<BlockDepth> depths;
+    if (filter.from_depth > filter.to_depth) {
+        return depths;
+    }
+
+    // the most selective condition is searched in the index: an address, else the first set topic
+    const auto first_topic =
+      std::find_if(filter.topics.begin(), filter.topics.end(), [](const auto& topic) { return topic.has_value(); });
+    DataType type = DataType::BLOOM;
+    base::Bytes prefix;
+    if (filter.address) {
+        type = DataType::ADDRESS;
+        prefix = base::Bytes(filter.address->getBytes());
+    }
+    else if (first_topic != filter.topics.end()) {
+        type = DataType::TOPIC;
+        prefix = base::Bytes(**first_topic);
+    }
+
+    const auto to_depth = std::min(filter.to_depth, std::numeric_limits<BlockDepth>::max() - 1) + 1;
+    _database.forEachInRange(toKey(type, prefix, filter.from_depth),
+                             toKey(type, prefix, to_depth),
+                             [&depths](base::BytesView key, base::BytesView) {
+                                 depths.push_back(depthFromKey(key));
+                                 return true;
+                             });
+    return depths;
+}
+
+} // namespace lk
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "core/event_log.hpp"
+#include "core/types.hpp"
+
+#include "base/database.hpp"
+#include "base/property_tree.hpp"
+
+#include <optional>
+#include <vector>
+
+namespace lk
+{
+
+/// Keeps logs of mined transactions in a database next to the blockchain one. Logs are indexed by the block,
+/// the emitting address and topics, so a query reads only the blocks that may contain matching logs.
+class LogIndex
+{
+  public:
+    //===================
+    explicit LogIndex(const base::PropertyTree& config);
+    LogIndex(const LogIndex&) = delete;
+    LogIndex(LogIndex&&) = delete;
+    LogIndex& operator=(const LogIndex&) = delete;
+    LogIndex& operator=(LogIndex&&) = delete;
+    ~LogIndex() = default;
+    //===================
+    // logs of blocks are written once, so blocks replayed from the database are skipped
+    void addBlock(BlockDepth depth, const std::vector<LogRecord>& logs);
+    bool isIndexed(BlockDepth depth) const;
+
+    // std::nullopt if the block has no logs
+    std::optional<LogsBloom> findBloom(BlockDepth depth) const;
+
+    /**
+     *  @brief Finds logs matching the filter in the order they were emitted.
+     *
+     *  @throws base::InvalidArgument if more than max_count logs match.
+     */
+    std::vector<LogRecord> find(const LogsFilter& filter, std::size_t max_count) const;
+    //===================
+  private:
+    //===================
+    base::Database _database;
+    //===================
+    std::vector<BlockDepth> findCandidateDepths(const LogsFilter& filter) const;
+    //===================
+};
+
+} // namespace lk
@@ -1,5 +1,6 @@
 #include "managers.hpp"
 
+#include "base/assert.hpp"
 #include "base/error.hpp"
 
 namespace lk
@@ -28,6 +29,9 @@ std::uint64_t AccountState::getNonce() const noexcept
 
 void AccountState::addTransactionHash(base::Sha256 tx_hash)
 {
+    if (auto manager = _journal_link.manager; manager && manager->isInTransaction()) {
+        manager->journal(StateManager::TransactionAdded{ *_journal_link.address });
+    }
     _transactions.emplace_back(std::move(tx_hash));
     ++_nonce;
 }
@@ -41,12 +45,14 @@ lk::Balance AccountState::getBalance() const noexcept
 
 void AccountState::setBalance(lk::Balance new_balance)
 {
+    journalBalance();
     _balance = std::move(new_balance);
 }
 
 
 void AccountState::addBalance(lk::Balance delta)
 {
+    journalBalance();
     _balance += delta;
 }
 
@@ -56,6 +62,7 @@ void AccountState::subBalance(lk::Balance delta)
     if (_balance < delta) {
         RAISE_ERROR(base::LogicError, "trying to take more LK from account than it has");
     }
+    journalBalance();
     _balance -= delta;
 }
 
@@ -68,17 +75,25 @@ const base::Sha256& AccountState::getCodeHash() const noexcept
 
 void AccountState::setCodeHash(base::Sha256 code_hash)
 {
+    journalCode();
     _code_hash = std::move(code_hash);
 }
 
 
 void AccountState::setRuntimeCode(const base::Bytes& code)
 {
-    _runtime_code = code;
+    journalCode();
+    _runtime_code = vm::getCodeCache().intern(code);
 }
 
 
 const base::Bytes& AccountState::getRuntimeCode() const
+{
+    return *_runtime_code;
+}
+
+
+std::shared_ptr<const base::Bytes> AccountState::getSharedRuntimeCode() const
 {
     return _runtime_code;
 }
@@ -103,12 +118,41 @@ AccountState::StorageData AccountState::getStorageValue(const base::Sha256& key)
 
 void AccountState::setStorageValue(const base::Sha256& key, base::Bytes value)
 {
+    journalStorageValue(key);
     StorageData& sd = _storage[key];
     sd.data = std::move(value);
     sd.was_modified = true;
 }
 
 
+void AccountState::journalBalance() const
+{
+    if (auto manager = _journal_link.manager; manager && manager->isInTransaction()) {
+        manager->journal(StateManager::BalanceChanged{ *_journal_link.address, _balance });
+    }
+}
+
+
+void AccountState::journalCode() const
+{
+    if (auto manager = _journal_link.manager; manager && manager->isInTransaction()) {
+        manager->journal(StateManager::CodeChanged{ *_journal_link.address, _code_hash, _runtime_code });
+    }
+}
+
+
+void AccountState::journalStorageValue(const base::Sha256& key) const
+{
+    if (auto manager = _journal_link.manager; manager && manager->isInTransaction()) {
+        std::optional<StorageData> previous;
+        if (auto it = _storage.find(key); it != _storage.end()) {
+            previous = it->second;
+        }
+        manager->journal(StateManager::StorageChanged{ *_journal_link.address, key, std::move(previous) });
+    }
+}
+
+
 AccountInfo AccountState::toInfo() const
 {
     if (_code_hash == base::Sha256::null()) {
@@ -122,10 +166,20 @@ AccountInfo AccountState::toInfo() const
 }
 
 
+StateManager::StateManager(std::shared_ptr<const StateManager> base)
+  : _base{ std::move(base) }
+{
+    ASSERT(_base);
+}
+
+
 StateManager::StateManager(StateManager&& other)
 {
     std::shared_lock lk(other._rw_mutex);
     _states = other._states;
+    _base = other._base;
+    _erased_from_base = other._erased_from_base;
+    _changed_accounts = other._changed_accounts;
 }
 
 
@@ -133,6 +187,9 @@ StateManager& StateManager::operator=(StateManager&& other) noexcept
 {
     std::shared_lock lk(other._rw_mutex);
     _states = other._states;
+    _base = other._base;
+    _erased_from_base = other._erased_from_base;
+    _changed_accounts = other._changed_accounts;
     return *this;
 }
 
@@ -143,9 +200,11 @@ void StateManager::createClientAccount(const lk::Address& address)
         RAISE_ERROR(base::LogicError, "address already exists");
     }
 
+    journalAccountReplacement(address);
     std::unique_lock lk(_rw_mutex);
     AccountState state{ AccountType::CLIENT };
     _states.insert({ address, state });
+    _changed_accounts.insert(address);
 }
 
 
@@ -161,7 +220,10 @@ lk::Address StateManager::createContractAccount(const lk::Address& from_account_
 
     AccountState state{ AccountType::CONTRACT };
     state.setCodeHash(associated_code_hash);
+    journalAccountReplacement(account_address);
+    std::unique_lock lk(_rw_mutex);
     _states[account_address] = std::move(state);
+    _changed_accounts.insert(account_address);
     return account_address;
 }
 
@@ -169,56 +231,80 @@ lk::Address StateManager::createContractAccount(const lk::Address& from_account_
 bool StateManager::hasAccount(const lk::Address& address) const
 {
     std::shared_lock lk(_rw_mutex);
-    return _states.find(address) != _states.end();
+    return find(address) != nullptr;
 }
 
 
 bool StateManager::deleteAccount(const lk::Address& address)
 {
+    journalAccountReplacement(address);
     std::unique_lock lk(_rw_mutex);
-    if (auto it = _states.find(address); it != _states.end()) {
-        _states.erase(it);
-        return true;
-    }
-    else {
-        return false;
+    const bool is_found = find(address) != nullptr;
+    _states.erase(address);
+    _changed_accounts.insert(address);
+    if (_base) {
+        // an account, that is restored by the rollback, is placed in _states and so is seen again
+        _erased_from_base.insert(address);
     }
+    return is_found;
 }
 
 
 const AccountState& StateManager::getAccount(const lk::Address& address) const
 {
     std::shared_lock lk(_rw_mutex);
-    auto it = _states.find(address);
-    if (it == _states.end()) {
-        RAISE_ERROR(base::InvalidArgument, "cannot getAccount for non-existent account");
+    if (auto account = find(address)) {
+        return *account;
     }
     else {
-        return it->second;
+        RAISE_ERROR(base::InvalidArgument, "cannot getAccount for non-existent account");
     }
 }
 
 
 AccountState& StateManager::getAccount(const lk::Address& address)
 {
-    std::shared_lock lk(_rw_mutex);
+    // the account may be created and linked, so readers must not see it meanwhile
+    std::unique_lock lk(_rw_mutex);
+    const bool is_journaled = isInTransaction();
+    _changed_accounts.insert(address); // the account is changed through the returned reference
     auto it = _states.find(address);
     if (it == _states.end()) {
-        AccountState state(AccountType::CLIENT); // TODO: lazy creation
-        return _states[address] = state;
+        if (is_journaled) {
+            journal(AccountReplaced{ address, std::nullopt });
+        }
+        if (auto base_account = find(address)) { // copy on the first change of an account of the base
+            it = _states.insert({ address, *base_account }).first;
+        }
+        else {
+            AccountState state(AccountType::CLIENT); // TODO: lazy creation
+            it = _states.insert({ address, state }).first;
+        }
     }
-    else {
-        return it->second;
+    if (is_journaled) {
+        return link(it);
     }
+    return it->second;
 }
 
 
-StateManager StateManager::createCopy()
+StateManager StateManager::createCopy() const
 {
     StateManager copy;
     {
         std::shared_lock lk(_rw_mutex);
-        copy._states = _states;
+        if (_base) {
+            copy._states = _base->createCopy()._states;
+            for (const auto& address : _erased_from_base) {
+                copy._states.erase(address);
+            }
+            for (const auto& [address, account] : _states) {
+                copy._states.insert_or_assign(address, account);
+            }
+        }
+        else {
+            copy._states = _states;
+        }
     }
     return copy;
 }
@@ -227,19 +313,52 @@ StateManager StateManager::createCopy()
 void StateManager::applyChanges(StateManager&& state)
 {
     std::unique_lock lk(_rw_mutex);
+    // accounts of both the replaced and the new state may differ from the last snapshot
+    for (const auto& [address, account] : _states) {
+        _changed_accounts.insert(address);
+    }
+    for (const auto& [address, account] : state._states) {
+        _changed_accounts.insert(address);
+    }
     _states = std::move(state._states);
+    _base = std::move(state._base);
+    _erased_from_base = std::move(state._erased_from_base);
 }
 
 
-bool StateManager::checkTransaction(const lk::Transaction& tx) const
+std::shared_ptr<const StateManager> StateManager::makeSnapshot(std::shared_ptr<const StateManager> previous)
 {
+    ASSERT(!isInTransaction());
+    if (!previous) {
+        auto snapshot = std::make_shared<StateManager>(createCopy());
+        std::unique_lock lk(_rw_mutex);
+        _changed_accounts.clear();
+        return snapshot;
+    }
+
+    auto snapshot = std::make_shared<StateManager>(std::move(previous));
     {
-        std::shared_lock lk(_rw_mutex);
-        if (_states.find(tx.getFrom()) == _states.end()) {
-            return false;
+        std::unique_lock lk(_rw_mutex);
+        for (const auto& address : _changed_accounts) {
+            if (auto account = find(address)) {
+                snapshot->_states.insert({ address, *account });
+            }
+            else {
+                snapshot->_erased_from_base.insert(address);
+            }
         }
+        _changed_accounts.clear();
     }
-    return getAccount(tx.getFrom()).getBalance() >= tx.getAmount() + tx.getFee();
+    snapshot->mergeBaseOverlays();
+    return snapshot;
+}
+
+
+bool StateManager::checkTransaction(const lk::Transaction& tx) const
+{
+    std::shared_lock lk(_rw_mutex);
+    auto account = find(tx.getFrom());
+    return account && account->getBalance() >= tx.getAmount() + tx.getFee();
 }
 
 
@@ -270,8 +389,185 @@ void StateManager::updateFromGenesis(const ImmutableBlock& block)
         AccountState state{ AccountType::CLIENT };
         state.setBalance(tx.getAmount());
         _states.insert({ tx.getTo(), std::move(state) });
+        _changed_accounts.insert(tx.getTo());
+    }
+}
+
+
+void StateManager::beginTransaction()
+{
+    if (!isInTransaction()) {
+        std::thread::id no_owner;
+        const bool is_taken = _transaction_owner.compare_exchange_strong(no_owner, std::this_thread::get_id());
+        ASSERT(is_taken);
     }
+    _journal_checkpoints.push_back(_journal.size());
 }
 
 
+void StateManager::commitTransaction()
+{
+    ASSERT(isInTransaction());
+    _journal_checkpoints.pop_back();
+    if (_journal_checkpoints.empty()) {
+        _journal.clear();
+        _transaction_owner = std::thread::id{};
+    }
+}
+
+
+void StateManager::rollbackTransaction()
+{
+    ASSERT(isInTransaction());
+    const auto checkpoint = _journal_checkpoints.back();
+    _journal_checkpoints.pop_back();
+    // in reverse order, so every entry is undone on the state it was recorded for
+    while (_journal.size() > checkpoint) {
+        undo(_journal.back());
+        _journal.pop_back();
+    }
+    if (_journal_checkpoints.empty()) {
+        _transaction_owner = std::thread::id{};
+    }
+}
+
+
+bool StateManager::isInTransaction() const noexcept
+{
+    return _transaction_owner.load() == std::this_thread::get_id();
+}
+
+
+void StateManager::journal(JournalEntry entry)
+{
+    _journal.push_back(std::move(entry));
+}
+
+
+void StateManager::journalAccountReplacement(const lk::Address& address)
+{
+    if (!isInTransaction()) {
+        return;
+    }
+    std::shared_lock lk(_rw_mutex);
+    if (auto account = find(address)) {
+        journal(AccountReplaced{ address, *account });
+    }
+    else {
+        journal(AccountReplaced{ address, std::nullopt });
+    }
+}
+
+
+void StateManager::undo(JournalEntry& entry)
+{
+    std::unique_lock lk(_rw_mutex);
+    if (auto replaced = std::get_if<AccountReplaced>(&entry)) {
+        if (replaced->previous) {
+            _states.insert_or_assign(replaced->address, std::move(*replaced->previous));
+        }
+        else {
+            _states.erase(replaced->address);
+        }
+        return;
+    }
+
+    // other changes are made to an existing account, since its creation is undone later
+    if (auto balance = std::get_if<BalanceChanged>(&entry)) {
+        _states.at(balance->address)._balance = std::move(balance->previous);
+    }
+    else if (auto transaction = std::get_if<TransactionAdded>(&entry)) {
+        auto& account = _states.at(transaction->address);
+        account._transactions.pop_back();
+        --account._nonce;
+    }
+    else if (auto code = std::get_if<CodeChanged>(&entry)) {
+        auto& account = _states.at(code->address);
+        account._code_hash = std::move(code->previous_hash);
+        account._runtime_code = std::move(code->previous_code);
+    }
+    else if (auto storage = std::get_if<StorageChanged>(&entry)) {
+        auto& account = _states.at(storage->address);
+        if (storage->previous) {
+            account._storage[storage->key] = std::move(*storage->previous);
+        }
+        else {
+            account._storage.erase(storage->key);
+        }
+    }
+}
+
+
+const AccountState* StateManager::find(const lk::Address& address) const
+{
+    if (auto it = _states.find(address); it != _states.end()) {
+        return &it->second;
+    }
+    if (_base && _erased_from_base.find(address) == _erased_from_base.end()) {
+        // the base is never changed, so its accounts may be referenced after the lock is released
+        std::shared_lock lk(_base->_rw_mutex);
+        return _base->find(address);
+    }
+    return nullptr;
+}
+
+
+void StateManager::mergeBaseOverlays()
+{
+    const auto overlay_size = [](const StateManager& overlay) {
+        return overlay._states.size() + overlay._erased_from_base.size();
+    };
+    // the bottom state is never merged, so a snapshot costs as much as the changes, that it has
+    while (_base && _base->_base && overlay_size(*_base) <= overlay_size(*this)) {
+        auto lower = std::move(_base);
+        std::shared_lock lk(lower->_rw_mutex);
+        for (const auto& [address, account] : lower->_states) {
+            if (_erased_from_base.find(address) == _erased_from_base.end()) {
+                _states.insert({ address, account }); // an account of this overlay is newer and stays
+            }
+        }
+        _erased_from_base.insert(lower->_erased_from_base.begin(), lower->_erased_from_base.end());
+        _base = lower->_base;
+    }
+}
+
+
+AccountState& StateManager::link(std::map<lk::Address, AccountState>::iterator it)
+{
+    it->second._journal_link.manager = this;
+    it->second._journal_link.address = &it->first;
+    return it->second;
+}
+
+
+StateTransaction::StateTransaction(StateManager& state_manager)
+  : _state_manager{ state_manager }
+{
+    _state_manager.beginTransaction();
+}
+
+
+StateTransaction::~StateTransaction()
+{
+    if (_is_active) {
+        _state_manager.rollbackTransaction();
+    }
+}
+
+
+void StateTransaction::commit()
+{
+    ASSERT(_is_active);
+    _is_active = false;
+    _state_manager.commitTransaction();
+}
+
+
+void StateTransaction::rollback()
+{
+    ASSERT(_is_active);
+    _is_active = false;
+    _state_manager.rollbackTransaction();
+}
+
 } // namespace core
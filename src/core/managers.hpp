@@ -3,8 +3,17 @@
 #include "core/block.hpp"
 #include "core/transaction.hpp"
 
+#include "vm/code_cache.hpp"
+
+#include <atomic>
 #include <map>
+#include <memory>
+#include <optional>
+#include <set>
 #include <shared_mutex>
+#include <thread>
+#include <variant>
+#include <vector>
 
 namespace lk
 {
@@ -16,6 +25,9 @@ enum class AccountType : uint8_t
 };
 
 
+class StateManager;
+
+
 struct AccountInfo
 {
     AccountType type;
@@ -57,6 +69,8 @@ class AccountState
     //============================
     void setRuntimeCode(const base::Bytes& code);
     const base::Bytes& getRuntimeCode() const;
+    // keeps the code alive for the time of a call, even if the account is deleted during it
+    std::shared_ptr<const base::Bytes> getSharedRuntimeCode() const;
     //============================
     bool checkStorageValue(const base::Sha256& key) const;
     StorageData getStorageValue(const base::Sha256& key) const;
@@ -65,13 +79,32 @@ class AccountState
     AccountInfo toInfo() const;
 
   private:
+    friend StateManager;
+    //============================
+    // manager, that journals changes of the account; a copy of the account is not linked to any manager
+    struct JournalLink
+    {
+        JournalLink() = default;
+        JournalLink(const JournalLink&) noexcept {}
+        JournalLink& operator=(const JournalLink&) noexcept { return *this; }
+
+        StateManager* manager{ nullptr };
+        const lk::Address* address{ nullptr };
+    };
+    //============================
+    JournalLink _journal_link;
     AccountType _type{ AccountType::CLIENT };
     std::uint64_t _nonce{ 0 };
     lk::Balance _balance{ 0 };
     base::Sha256 _code_hash{ base::Sha256::null() };
     std::vector<base::Sha256> _transactions;
     std::map<base::Sha256, StorageData> _storage;
-    base::Bytes _runtime_code;
+    // shared between copies of the account and accounts with the same code
+    std::shared_ptr<const base::Bytes> _runtime_code{ vm::CodeCache::empty() };
+    //============================
+    void journalBalance() const;
+    void journalCode() const;
+    void journalStorageValue(const base::Sha256& key) const;
 };
 
 
@@ -80,6 +113,8 @@ class StateManager
   public:
     //================
     StateManager() = default;
+    // overlay of an immutable state: reads fall through to the base, an account of the base is copied on its change
+    explicit StateManager(std::shared_ptr<const StateManager> base);
     StateManager(const StateManager&) = delete;
     StateManager(StateManager&& other);
 
@@ -97,16 +132,117 @@ class StateManager
     bool checkTransaction(const lk::Transaction& tx) const;
     void updateFromGenesis(const ImmutableBlock& block);
     //================
+    // the reference is valid until the state is changed, so only a snapshot may be read by other threads
     const AccountState& getAccount(const lk::Address& account_address) const;
     AccountState& getAccount(const lk::Address& address);
     //================
-    StateManager createCopy();
+    // the copy of an overlay has all accounts of its base
+    StateManager createCopy() const;
     void applyChanges(StateManager&& state);
+    //================
+    /**
+     *  @brief Makes an immutable snapshot of the state, that may be read by other threads.
+     *
+     *  The snapshot is an overlay of the previous one with copies of only those accounts, that were changed
+     *  since it was made, so it costs as much as the changes do. Overlays are merged, while the lower one is
+     *  not bigger than the upper, so a lookup goes through a logarithmic number of them.
+     *  Without the previous snapshot the whole state is copied.
+     *
+     *  @param previous - the last snapshot made of this state, or nullptr.
+     *  Must not be called in a transaction, so the snapshot has only committed changes.
+     */
+    std::shared_ptr<const StateManager> makeSnapshot(std::shared_ptr<const StateManager> previous);
+    //================
+    /**
+     *  @brief State transactions record old values of changed accounts, balances, nonces, code and storage slots,
+     *      so the changes can be undone without copying the state.
+     *
+     *  Transactions nest: a committed inner transaction is still undone by the rollback of the outer one.
+     *  Must be used by the single thread that changes the state. Other threads must not read the state
+     *  meanwhile, since they would see uncommitted changes; they read a snapshot of it instead.
+     */
+    void beginTransaction();
+    void commitTransaction();
+    void rollbackTransaction();
+    // true only for the thread that has opened a transaction
+    bool isInTransaction() const noexcept;
 
   private:
+    friend AccountState;
+    //================
+    struct AccountReplaced
+    {
+        lk::Address address;
+        std::optional<AccountState> previous; // std::nullopt if the account was created
+    };
+    struct BalanceChanged
+    {
+        lk::Address address;
+        lk::Balance previous;
+    };
+    struct TransactionAdded
+    {
+        lk::Address address;
+    };
+    struct CodeChanged
+    {
+        lk::Address address;
+        base::Sha256 previous_hash;
+        std::shared_ptr<const base::Bytes> previous_code;
+    };
+    struct StorageChanged
+    {
+        lk::Address address;
+        base::Sha256 key;
+        std::optional<AccountState::StorageData> previous; // std::nullopt if the slot was created
+    };
+    using JournalEntry = std::variant<AccountReplaced, BalanceChanged, TransactionAdded, CodeChanged, StorageChanged>;
     //================
     std::map<lk::Address, AccountState> _states;
     mutable std::shared_mutex _rw_mutex;
+    //================
+    std::shared_ptr<const StateManager> _base; // nullptr if the state is not an overlay
+    std::set<lk::Address> _erased_from_base;   // accounts, that were deleted in the overlay
+    // looks through the overlay into its base. Called under a lock of _rw_mutex
+    const AccountState* find(const lk::Address& address) const;
+    // merges the overlays below this one into it, while they are not bigger than it
+    void mergeBaseOverlays();
+    //================
+    // accounts, that were created, deleted or taken for a change since the last snapshot
+    std::set<lk::Address> _changed_accounts;
+    //================
+    // the journal and checkpoints are touched only by the thread that has opened a transaction
+    std::atomic<std::thread::id> _transaction_owner;
+    std::vector<JournalEntry> _journal;
+    std::vector<std::size_t> _journal_checkpoints; // size of the journal at the beginning of each open transaction
+    //================
+    void journal(JournalEntry entry);
+    void journalAccountReplacement(const lk::Address& address);
+    void undo(JournalEntry& entry);
+    // links the account to this manager, so changes made through the returned reference are journaled.
+    // Called under the exclusive lock by the thread that has opened a transaction
+    AccountState& link(std::map<lk::Address, AccountState>::iterator it);
+};
+
+
+// state transaction, that is rolled back on destruction if it was not committed
+class StateTransaction
+{
+  public:
+    //================
+    explicit StateTransaction(StateManager& state_manager);
+    StateTransaction(const StateTransaction&) = delete;
+    StateTransaction(StateTransaction&&) = delete;
+    StateTransaction& operator=(const StateTransaction&) = delete;
+    StateTransaction& operator=(StateTransaction&&) = delete;
+    ~StateTransaction();
+    //================
+    void commit();
+    void rollback();
+    //================
+  private:
+    StateManager& _state_manager;
+    bool _is_active{ true };
 };
 
 } // namespace core
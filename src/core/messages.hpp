@@ -1,5 +1,6 @@
 #pragma once
 
+#include "base/serialization.hpp"
 #include "base/utility.hpp"
 #include "core/address.hpp"
 #include "core/block.hpp"
@@ -35,8 +36,7 @@ struct NodeIdentityInfo
     net::Endpoint endpoint;
     lk::Address address;
 
-    static NodeIdentityInfo deserialize(base::SerializationIArchive& ia);
-    void serialize(base::SerializationOArchive& oa) const;
+    DEFINE_SERIALIZATION_FIELDS(NodeIdentityInfo, (endpoint)(address))
 };
 
 
@@ -48,8 +48,7 @@ struct Connect
     std::uint16_t public_port;
     base::Sha256 top_block_hash;
 
-    void serialize(base::SerializationOArchive& oa) const;
-    static Connect deserialize(base::SerializationIArchive& ia);
+    DEFINE_SERIALIZATION_FIELDS(Connect, (address)(public_port)(top_block_hash))
 };
 
 
@@ -64,8 +63,7 @@ struct CannotAccept
     RefusionReason why_not_accepted;
     std::vector<NodeIdentityInfo> peers_info;
 
-    void serialize(base::SerializationOArchive& oa) const;
-    static CannotAccept deserialize(base::SerializationIArchive& ia);
+    DEFINE_SERIALIZATION_FIELDS(CannotAccept, (why_not_accepted)(peers_info))
 };
 
 
@@ -77,8 +75,7 @@ struct Accepted
     uint16_t public_port; // zero public port states that peer didn't provide information about his public endpoint
     base::Sha256 top_block_hash;
 
-    void serialize(base::SerializationOArchive& oa) const;
-    static Accepted deserialize(base::SerializationIArchive& ia);
+    DEFINE_SERIALIZATION_FIELDS(Accepted, (address)(public_port)(top_block_hash))
 };
 
 
@@ -88,6 +85,7 @@ struct Ping
 
     void serialize(base::SerializationOArchive& oa) const;
     static Ping deserialize(base::SerializationIArchive& ia);
+    std::size_t serializedSize() const;
 };
 
 
@@ -97,6 +95,7 @@ struct Pong
 
     void serialize(base::SerializationOArchive& oa) const;
     static Pong deserialize(base::SerializationIArchive& ia);
+    std::size_t serializedSize() const;
 };
 
 
@@ -107,8 +106,7 @@ struct Lookup
     lk::Address address;
     std::uint8_t selection_size;
 
-    void serialize(base::SerializationOArchive& oa) const;
-    static Lookup deserialize(base::SerializationIArchive& ia);
+    DEFINE_SERIALIZATION_FIELDS(Lookup, (address)(selection_size))
 };
 
 
@@ -119,8 +117,7 @@ struct LookupResponse
     lk::Address address;
     std::vector<NodeIdentityInfo> peers_info;
 
-    void serialize(base::SerializationOArchive& oa) const;
-    static LookupResponse deserialize(base::SerializationIArchive& ia);
+    DEFINE_SERIALIZATION_FIELDS(LookupResponse, (address)(peers_info))
 };
 
 
@@ -130,8 +127,7 @@ struct Transaction
 
     lk::Transaction tx;
 
-    void serialize(base::SerializationOArchive& oa) const;
-    static Transaction deserialize(base::SerializationIArchive& ia);
+    DEFINE_SERIALIZATION_FIELDS(Transaction, (tx))
 };
 
 
@@ -141,8 +137,7 @@ struct GetBlock
 
     base::Sha256 block_hash;
 
-    void serialize(base::SerializationOArchive& oa) const;
-    static GetBlock deserialize(base::SerializationIArchive& ia);
+    DEFINE_SERIALIZATION_FIELDS(GetBlock, (block_hash))
 };
 
 
@@ -153,8 +148,7 @@ struct Block
     base::Sha256 block_hash;
     ImmutableBlock block;
 
-    void serialize(base::SerializationOArchive& oa) const;
-    static Block deserialize(base::SerializationIArchive& ia);
+    DEFINE_SERIALIZATION_FIELDS(Block, (block_hash)(block))
 };
 
 
@@ -164,8 +158,7 @@ struct BlockNotFound
 
     base::Sha256 block_hash;
 
-    void serialize(base::SerializationOArchive& oa) const;
-    static BlockNotFound deserialize(base::SerializationIArchive& ia);
+    DEFINE_SERIALIZATION_FIELDS(BlockNotFound, (block_hash))
 };
 
 
@@ -176,8 +169,7 @@ struct NewBlock
     base::Sha256 block_hash;
     ImmutableBlock block;
 
-    void serialize(base::SerializationOArchive& oa) const;
-    static NewBlock deserialize(base::SerializationIArchive& ia);
+    DEFINE_SERIALIZATION_FIELDS(NewBlock, (block_hash)(block))
 };
 
 
@@ -187,6 +179,7 @@ struct Close
 
     void serialize(base::SerializationOArchive& oa) const;
     static Close deserialize(base::SerializationIArchive& ia);
+    std::size_t serializedSize() const;
 };
 
 }
\ No newline at end of file
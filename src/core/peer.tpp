@@ -25,6 +25,7 @@ template<typename T>
 base::Bytes Requests::prepareMessage(const T& msg)
 {
     base::SerializationOArchive oa;
+    oa.reserve(sizeof(_next_message_id) + sizeof(T::TYPE_ID) + base::serializedSize(msg));
     oa.serialize(_next_message_id++);
     oa.serialize(T::TYPE_ID);
     oa.serialize(msg);
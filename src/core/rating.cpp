@@ -16,21 +16,6 @@ Rating RatingManager::get(const net::Endpoint& ep)
 }
 
 
-void Rating::Data::serialize(base::SerializationOArchive& oa) const
-{
-    oa.serialize(value);
-    oa.serialize(ts);
-}
-
-
-Rating::Data Rating::Data::deserialize(base::SerializationIArchive& ia)
-{
-    auto value = ia.deserialize<Value>();
-    auto ts = ia.deserialize<base::Time>();
-    return { value, ts };
-}
-
-
 Rating::Rating(const net::Endpoint& ep, base::Database& db)
   : _serialized_ep{ base::toBytes(ep) }
   , _db{ db }
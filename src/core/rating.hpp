@@ -44,8 +44,7 @@ class Rating
         Value value;
         base::Time ts;
 
-        void serialize(base::SerializationOArchive& oa) const;
-        static Data deserialize(base::SerializationIArchive& ia);
+        DEFINE_SERIALIZATION_FIELDS(Data, (value)(ts))
     };
     Data _data;
 
@@ -124,31 +124,6 @@ base::Sha256 Transaction::hashOfTransaction() const
 }
 
 
-Transaction Transaction::deserialize(base::SerializationIArchive& ia)
-{
-    auto from = ia.deserialize<lk::Address>();
-    auto to = ia.deserialize<lk::Address>();
-    auto amount = ia.deserialize<lk::Balance>();
-    auto fee = ia.deserialize<std::uint64_t>();
-    auto timestamp = ia.deserialize<base::Time>();
-    auto data = ia.deserialize<base::Bytes>();
-    auto sign = ia.deserialize<lk::Sign>();
-    return { std::move(from), std::move(to), amount, fee, timestamp, std::move(data), std::move(sign) };
-}
-
-
-void Transaction::serialize(base::SerializationOArchive& oa) const
-{
-    oa.serialize(_from);
-    oa.serialize(_to);
-    oa.serialize(_amount);
-    oa.serialize(_fee);
-    oa.serialize(_timestamp);
-    oa.serialize(_data);
-    oa.serialize(_sign);
-}
-
-
 std::ostream& operator<<(std::ostream& os, const Transaction& tx)
 {
     return os << "from: " << tx.getFrom() << " to: " << tx.getTo() << " amount: " << tx.getAmount()
@@ -246,11 +221,13 @@ const Transaction& invalidTransaction()
 TransactionStatus::TransactionStatus(StatusCode status,
                                      ActionType type,
                                      Fee fee_left,
-                                     const std::string& message) noexcept
+                                     const std::string& message,
+                                     std::vector<EventLog> logs) noexcept
   : _status{ status }
   , _action(type)
   , _message{ message }
   , _fee_left{ fee_left }
+  , _logs{ std::move(logs) }
 {}
 
 
@@ -293,4 +270,10 @@ Fee TransactionStatus::getFeeLeft() const noexcept
     return _fee_left;
 }
 
+
+const std::vector<EventLog>& TransactionStatus::getLogs() const noexcept
+{
+    return _logs;
+}
+
 } // namespace lk
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/address.hpp"
+#include "core/event_log.hpp"
 #include "core/types.hpp"
 
 #include "base/crypto.hpp"
@@ -47,8 +48,7 @@ class Transaction
     //=================
     base::Sha256 hashOfTransaction() const;
     //=================
-    static Transaction deserialize(base::SerializationIArchive& ia);
-    void serialize(base::SerializationOArchive& oa) const;
+    DEFINE_SERIALIZATION_FIELDS(Transaction, (_from)(_to)(_amount)(_fee)(_timestamp)(_data)(_sign))
     //=================
   private:
     //=================
@@ -119,7 +119,8 @@ class TransactionStatus
     explicit TransactionStatus(StatusCode status,
                                ActionType type,
                                std::uint64_t fee_left,
-                               const std::string& message = "") noexcept;
+                               const std::string& message = "",
+                               std::vector<EventLog> logs = {}) noexcept;
 
     TransactionStatus(const TransactionStatus&) = default;
     TransactionStatus(TransactionStatus&&) = default;
@@ -139,11 +140,15 @@ class TransactionStatus
 
     std::uint64_t getFeeLeft() const noexcept;
 
+    // logs emitted during a successful execution of the transaction
+    const std::vector<EventLog>& getLogs() const noexcept;
+
   private:
     StatusCode _status;
     ActionType _action;
     std::string _message;
     Fee _fee_left;
+    std::vector<EventLog> _logs;
 };
 
 } // namespace lk
@@ -135,9 +135,15 @@ TransactionsSet TransactionsSet::deserialize(base::SerializationIArchive& ia)
 }
 
 
-std::map<Address, Balance> calcCost(const TransactionsSet& txs)
+std::size_t TransactionsSet::serializedSize() const
 {
-    std::map<Address, Balance> result;
+    return base::serializedSize(_txs);
+}
+
+
+std::pmr::map<Address, Balance> calcCost(const TransactionsSet& txs, std::pmr::memory_resource* resource)
+{
+    std::pmr::map<Address, Balance> result{ resource };
     for (const auto& tx : txs) {
         auto tx_cost = tx.getAmount() + tx.getFee();
         result.insert({ tx.getFrom(), tx_cost });
@@ -5,6 +5,7 @@
 #include "base/serialization.hpp"
 
 #include <map>
+#include <memory_resource>
 #include <vector>
 
 namespace lk
@@ -38,12 +39,15 @@ class TransactionsSet
     //=================
     void serialize(base::SerializationOArchive& oa) const;
     static TransactionsSet deserialize(base::SerializationIArchive& ia);
+    std::size_t serializedSize() const;
     //=================
   private:
     std::vector<Transaction> _txs;
 };
 
 
-std::map<Address, Balance> calcCost(const TransactionsSet& txs);
+// the map is allocated from resource, which allows to keep it in a per-block arena
+std::pmr::map<Address, Balance> calcCost(const TransactionsSet& txs,
+                                         std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
 } // namespace lk
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "vm_tracer.hpp"
+
+#include <algorithm>
+
+namespace
+{
+
+std::uint64_t toMicroseconds(std::chrono::nanoseconds time)
+{
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(time).count());
+}
+
+} // namespace
+
+
+namespace lk
+{
+
+HostCallsCounters& HostCallsCounters::operator+=(const HostCallsCounters& other) noexcept
+{
+    storage_reads += other.storage_reads;
+    storage_writes += other.storage_writes;
+    balance_reads += other.balance_reads;
+    code_reads += other.code_reads;
+    calls += other.calls;
+    logs += other.logs;
+    return *this;
+}
+
+
+VmTracer::Frame::Frame(const Address& address, std::uint32_t depth)
+  : _address{ address }
+  , _depth{ depth }
+  , _started_at{ Clock::now() }
+{}
+
+
+void VmTracer::Frame::addNestedCallTime(Clock::duration time) noexcept
+{
+    _nested_calls_time += time;
+}
+
+
+VmTracer::VmTracer(bool is_enabled)
+  : _is_enabled{ is_enabled }
+{}
+
+
+void VmTracer::setEnabled(bool is_enabled) noexcept
+{
+    _is_enabled.store(is_enabled, std::memory_order_relaxed);
+}
+
+
+bool VmTracer::isEnabled() const noexcept
+{
+    return _is_enabled.load(std::memory_order_relaxed);
+}
+
+
+void VmTracer::record(const Frame& frame, std::uint64_t gas_used, bool is_succeeded)
+{
+    const auto total_time = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - frame._started_at);
+    const auto own_time = total_time - std::chrono::duration_cast<std::chrono::nanoseconds>(frame._nested_calls_time);
+
+    std::lock_guard lk(_traces_mutex);
+    auto& trace = _traces.try_emplace(frame._address).first->second;
+    trace.address = frame._address;
+    ++trace.calls;
+    if (!is_succeeded) {
+        ++trace.failed_calls;
+    }
+    trace.gas_used += gas_used;
+    trace.total_time += total_time;
+    trace.own_time += own_time;
+    trace.max_call_time = std::max(trace.max_call_time, total_time);
+    trace.max_depth = std::max(trace.max_depth, frame._depth);
+    trace.host_calls += frame.host_calls;
+}
+
+
+std::vector<ContractTrace> VmTracer::getTraces() const
+{
+    std::vector<ContractTrace> ret;
+    {
+        std::lock_guard lk(_traces_mutex);
+        ret.reserve(_traces.size());
+        for (const auto& [address, trace] : _traces) {
+            ret.push_back(trace);
+        }
+    }
+    std::stable_sort(ret.begin(), ret.end(), [](const ContractTrace& a, const ContractTrace& b) {
+        return a.total_time > b.total_time;
+    });
+    return ret;
+}
+
+
+void VmTracer::reset()
+{
+    std::lock_guard lk(_traces_mutex);
+    _traces.clear();
+}
+
+
+void VmTracer::dump(std::ostream& os) const
+{
+    os << "contract calls failed gas total_us own_us max_us max_depth "
+          "storage_reads storage_writes balance_reads code_reads calls logs\n";
+    for (const auto& trace : getTraces()) {
+        os << trace.address << ' ' << trace.calls << ' ' << trace.failed_calls << ' ' << trace.gas_used << ' '
+           << toMicroseconds(trace.total_time) << ' ' << toMicroseconds(trace.own_time) << ' '
+           << toMicroseconds(trace.max_call_time) << ' ' << trace.max_depth << ' ' << trace.host_calls.storage_reads
+           << ' ' << trace.host_calls.storage_writes << ' ' << trace.host_calls.balance_reads << ' '
+           << trace.host_calls.code_reads << ' ' << trace.host_calls.calls << ' ' << trace.host_calls.logs << '\n';
+    }
+}
+
+} // namespace lk
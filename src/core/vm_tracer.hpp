@@ -0,0 +1,103 @@
+#pragma once
+
+#include "core/address.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace lk
+{
+
+// requests of a contract to the state, made through EthHost
+struct HostCallsCounters
+{
+    std::uint64_t storage_reads{ 0 };
+    std::uint64_t storage_writes{ 0 };
+    std::uint64_t balance_reads{ 0 };
+    std::uint64_t code_reads{ 0 }; // code size, hash and copy
+    std::uint64_t calls{ 0 };
+    std::uint64_t logs{ 0 };
+    //=================
+    HostCallsCounters& operator+=(const HostCallsCounters& other) noexcept;
+};
+
+
+// execution statistics of a contract summed over all of its calls
+struct ContractTrace
+{
+    Address address{ Address::null() };
+    std::uint64_t calls{ 0 };
+    std::uint64_t failed_calls{ 0 };
+    std::uint64_t gas_used{ 0 };
+    std::chrono::nanoseconds total_time{ 0 }; // including contracts called by this one
+    std::chrono::nanoseconds own_time{ 0 };   // excluding contracts called by this one
+    std::chrono::nanoseconds max_call_time{ 0 };
+    std::uint32_t max_depth{ 0 };
+    HostCallsCounters host_calls;
+};
+
+
+/// Profiles contract executions by the VM. When disabled, no frames are created, so the VM host only
+/// checks a null pointer on each request.
+class VmTracer
+{
+  public:
+    //===================
+    using Clock = std::chrono::steady_clock;
+    //===================
+    // one execution of a contract code, is filled by a single thread
+    class Frame
+    {
+      public:
+        Frame(const Address& address, std::uint32_t depth);
+        //===================
+        HostCallsCounters host_calls;
+        //===================
+        // time of a nested call is excluded from the own time of this frame
+        void addNestedCallTime(Clock::duration time) noexcept;
+        //===================
+      private:
+        friend VmTracer;
+        Address _address;
+        std::uint32_t _depth;
+        Clock::time_point _started_at;
+        Clock::duration _nested_calls_time{ 0 };
+    };
+    //===================
+    explicit VmTracer(bool is_enabled = false);
+    VmTracer(const VmTracer&) = delete;
+    VmTracer(VmTracer&&) = delete;
+    VmTracer& operator=(const VmTracer&) = delete;
+    VmTracer& operator=(VmTracer&&) = delete;
+    ~VmTracer() = default;
+    //===================
+    void setEnabled(bool is_enabled) noexcept;
+    bool isEnabled() const noexcept;
+    //===================
+    /**
+     *  @brief Adds the finished frame to the statistics of its contract.
+     *
+     *  @threadsafe
+     */
+    void record(const Frame& frame, std::uint64_t gas_used, bool is_succeeded);
+    // sorted by total time, the slowest contracts go first
+    std::vector<ContractTrace> getTraces() const;
+    void reset();
+    //===================
+    // human readable table of the collected statistics
+    void dump(std::ostream& os) const;
+    //===================
+  private:
+    //===================
+    std::atomic<bool> _is_enabled;
+    mutable std::mutex _traces_mutex;
+    std::map<Address, ContractTrace> _traces;
+    //===================
+};
+
+} // namespace lk
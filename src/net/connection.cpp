@@ -89,7 +89,7 @@ const Endpoint& Connection::getEndpoint() const
 void Connection::receive(std::size_t bytes_to_receive, net::Connection::ReceiveHandler receive_handler)
 {
     ba::async_read(_socket,
-                   ba::buffer(_read_buffer.toVector()),
+                   ba::buffer(_read_buffer.getData(), _read_buffer.size()),
                    ba::transfer_exactly(bytes_to_receive),
                    [connection_holder = weak_from_this(), handler = std::move(receive_handler)](
                      const boost::system::error_code& ec, const std::size_t bytes_received) mutable {
@@ -175,7 +175,7 @@ void Connection::sendPendingMessages()
     auto& callback = data.second;
 
     ba::async_write(_socket,
-                    ba::buffer(message.toVector()),
+                    ba::buffer(message.getData(), message.size()),
                     [connection_holder = weak_from_this(), callback](const boost::system::error_code& ec,
                                                                      const std::size_t bytes_sent) {
                         if (auto connection = connection_holder.lock()) {
@@ -122,4 +122,10 @@ void Endpoint::serialize(base::SerializationOArchive& oa) const
     oa.serialize(toString());
 }
 
+
+std::size_t Endpoint::serializedSize() const
+{
+    return base::serializedSize(toString());
+}
+
 } // namespace net
\ No newline at end of file
@@ -39,6 +39,7 @@ class Endpoint
     //=============
     static Endpoint deserialize(base::SerializationIArchive& ia);
     void serialize(base::SerializationOArchive& oa) const;
+    std::size_t serializedSize() const;
     //=============
   private:
     //=============
@@ -195,9 +195,11 @@ void MinerWorker::worker()
                 lk::MutableBlock& b = data.block_to_mine.value();
                 const auto complexity = data.complexity->getComparer();
                 auto attempting_nonce = mt();
+                base::Bytes serialized_block; // reused between attempts to not reallocate on every nonce
                 while (last_read_version == _common_state.getVersion()) {
                     b.setNonce(attempting_nonce++); // overflow must go by modulo 2, since unsigned
-                    if (base::Sha256::compute(base::toBytes(b)).getBytes() < complexity) {
+                    base::serializeInto(b, serialized_block);
+                    if (base::Sha256::compute(serialized_block).getBytes() < complexity) {
                         lk::BlockBuilder builder(b);
                         _common_state.callHandlerAndDrop(std::move(builder).buildImmutable());
                     }
@@ -6,12 +6,25 @@
 #include "base/hash.hpp"
 #include "base/log.hpp"
 
+#include <unordered_set>
+
 namespace node
 {
 
 GeneralServerService::GeneralServerService(lk::Core& core)
   : _core{ core }
-{}
+  , _blocks_hub{ base::config::RPC_SUBSCRIPTION_QUEUE_LIMIT }
+  , _pending_transactions_hub{ base::config::RPC_SUBSCRIPTION_QUEUE_LIMIT }
+  , _transaction_statuses_hub{ base::config::RPC_SUBSCRIPTION_QUEUE_LIMIT }
+{
+    _core.subscribeToBlockAddition([this](const lk::ImmutableBlock& block) { _blocks_hub.publish(block); });
+    _core.subscribeToNewPendingTransaction(
+      [this](const lk::Transaction& tx) { _pending_transactions_hub.publish(tx); });
+    _core.subscribeToTransactionStatusChange(
+      [this](const base::Sha256& transaction_hash, const lk::TransactionStatus& status) {
+          _transaction_statuses_hub.publish(rpc::TransactionStatusUpdate{ transaction_hash, status });
+      });
+}
 
 
 lk::AccountInfo GeneralServerService::getAccountInfo(const lk::Address& address)
@@ -80,4 +93,126 @@ lk::TransactionStatus GeneralServerService::getTransactionStatus(const base::Sha
 }
 
 
+lk::ViewCallResult GeneralServerService::callContractView(const lk::Transaction& call)
+{
+    LOG_TRACE << "Received RPC request {callContractView} with call[" << call << "]";
+    return _core.callContractView(call);
+}
+
+
+std::uint64_t GeneralServerService::estimateGas(const lk::Transaction& tx)
+{
+    LOG_TRACE << "Received RPC request {estimateGas} with tx[" << tx << "]";
+    return _core.estimateGas(tx);
+}
+
+
+std::vector<lk::LogRecord> GeneralServerService::getLogs(const lk::LogsFilter& filter)
+{
+    LOG_TRACE << "Received RPC request {getLogs} from block " << filter.from_depth << " to " << filter.to_depth;
+    return _core.findLogs(filter);
+}
+
+
+std::vector<lk::ContractTrace> GeneralServerService::getVmTraces()
+{
+    LOG_TRACE << "Received RPC request {getVmTraces}";
+    return _core.getVmTraces();
+}
+
+
+std::vector<lk::ImmutableBlock> GeneralServerService::getBlocks(uint64_t from_number, std::size_t count)
+{
+    LOG_TRACE << "Received RPC request {getBlocks} from block " << from_number << " count " << count;
+    if (count > base::config::RPC_MAX_ITEMS_IN_REQUEST) {
+        RAISE_ERROR(base::InvalidArgument,
+                    "at most " + std::to_string(base::config::RPC_MAX_ITEMS_IN_REQUEST) + " blocks can be requested");
+    }
+    std::vector<lk::ImmutableBlock> blocks;
+    blocks.reserve(count);
+    for (auto number = from_number; number - from_number < count; ++number) {
+        auto block_hash_opt = _core.findBlockHash(number);
+        if (!block_hash_opt) {
+            break;
+        }
+        auto block_opt = _core.findBlock(*block_hash_opt);
+        if (!block_opt) {
+            break;
+        }
+        blocks.push_back(std::move(*block_opt));
+    }
+    return blocks;
+}
+
+
+std::vector<lk::Transaction> GeneralServerService::getTransactions(const std::vector<base::Sha256>& transactions_hashes)
+{
+    LOG_TRACE << "Received RPC request {getTransactions} for " << transactions_hashes.size() << " transactions";
+    if (transactions_hashes.size() > base::config::RPC_MAX_ITEMS_IN_REQUEST) {
+        RAISE_ERROR(base::InvalidArgument,
+                    "at most " + std::to_string(base::config::RPC_MAX_ITEMS_IN_REQUEST) +
+                      " transactions can be requested");
+    }
+    std::vector<lk::Transaction> transactions;
+    transactions.reserve(transactions_hashes.size());
+    for (const auto& transaction_hash : transactions_hashes) {
+        transactions.push_back(getTransaction(transaction_hash));
+    }
+    return transactions;
+}
+
+
+std::vector<lk::TransactionStatus> GeneralServerService::pushTransactions(
+  const std::vector<lk::Transaction>& transactions)
+{
+    LOG_TRACE << "Received RPC request {pushTransactions} with " << transactions.size() << " transactions";
+    if (transactions.size() > base::config::RPC_MAX_ITEMS_IN_REQUEST) {
+        RAISE_ERROR(base::InvalidArgument,
+                    "at most " + std::to_string(base::config::RPC_MAX_ITEMS_IN_REQUEST) +
+                      " transactions can be pushed");
+    }
+    std::vector<lk::TransactionStatus> statuses;
+    statuses.reserve(transactions.size());
+    for (const auto& tx : transactions) {
+        statuses.push_back(_core.addPendingTransaction(tx));
+    }
+    return statuses;
+}
+
+
+std::shared_ptr<rpc::Subscription<lk::ImmutableBlock>> GeneralServerService::subscribeToBlocks()
+{
+    LOG_TRACE << "Received RPC request {subscribeToBlocks}";
+    return _blocks_hub.subscribe();
+}
+
+
+std::shared_ptr<rpc::Subscription<lk::Transaction>> GeneralServerService::subscribeToPendingTransactions()
+{
+    LOG_TRACE << "Received RPC request {subscribeToPendingTransactions}";
+    return _pending_transactions_hub.subscribe();
+}
+
+
+std::shared_ptr<rpc::Subscription<rpc::TransactionStatusUpdate>> GeneralServerService::subscribeToTransactionStatuses(
+  const std::vector<base::Sha256>& transactions_hashes)
+{
+    LOG_TRACE << "Received RPC request {subscribeToTransactionStatuses} for " << transactions_hashes.size()
+              << " transactions";
+    if (transactions_hashes.empty()) {
+        return _transaction_statuses_hub.subscribe();
+    }
+    if (transactions_hashes.size() > base::config::RPC_MAX_ITEMS_IN_REQUEST) {
+        RAISE_ERROR(base::InvalidArgument,
+                    "at most " + std::to_string(base::config::RPC_MAX_ITEMS_IN_REQUEST) +
+                      " transactions can be watched");
+    }
+    std::unordered_set<base::Sha256> watched{ transactions_hashes.begin(), transactions_hashes.end() };
+    return _transaction_statuses_hub.subscribe(
+      [watched = std::move(watched)](const rpc::TransactionStatusUpdate& update) {
+          return watched.count(update.transaction_hash) != 0;
+      });
+}
+
+
 } // namespace node
@@ -8,7 +8,7 @@
 namespace node
 {
 
-class GeneralServerService : public rpc::BaseRpc
+class GeneralServerService : public rpc::BaseRpcService
 {
   public:
     explicit GeneralServerService(lk::Core& core);
@@ -29,8 +29,34 @@ class GeneralServerService : public rpc::BaseRpc
 
     lk::TransactionStatus getTransactionStatus(const base::Sha256& transaction_hash) override;
 
+    lk::ViewCallResult callContractView(const lk::Transaction& call) override;
+
+    std::uint64_t estimateGas(const lk::Transaction& tx) override;
+
+    std::vector<lk::LogRecord> getLogs(const lk::LogsFilter& filter) override;
+
+    std::vector<lk::ContractTrace> getVmTraces() override;
+
+    std::vector<lk::ImmutableBlock> getBlocks(uint64_t from_number, std::size_t count) override;
+
+    std::vector<lk::Transaction> getTransactions(const std::vector<base::Sha256>& transactions_hashes) override;
+
+    std::vector<lk::TransactionStatus> pushTransactions(const std::vector<lk::Transaction>& transactions) override;
+
+    std::shared_ptr<rpc::Subscription<lk::ImmutableBlock>> subscribeToBlocks() override;
+
+    std::shared_ptr<rpc::Subscription<lk::Transaction>> subscribeToPendingTransactions() override;
+
+    std::shared_ptr<rpc::Subscription<rpc::TransactionStatusUpdate>> subscribeToTransactionStatuses(
+      const std::vector<base::Sha256>& transactions_hashes) override;
+
   private:
     lk::Core& _core;
+
+    // fed by events of the core, so they are copied once per subscriber and not kept for an absent one
+    rpc::SubscriptionHub<lk::ImmutableBlock> _blocks_hub;
+    rpc::SubscriptionHub<lk::Transaction> _pending_transactions_hub;
+    rpc::SubscriptionHub<rpc::TransactionStatusUpdate> _transaction_statuses_hub;
 };
 
 } // namespace node
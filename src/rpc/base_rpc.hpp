@@ -2,9 +2,13 @@
 
 #include "core/block.hpp"
 #include "core/core.hpp"
+#include "core/event_log.hpp"
 #include "core/managers.hpp"
 #include "core/transaction.hpp"
 #include "core/types.hpp"
+#include "core/vm_tracer.hpp"
+
+#include "rpc/subscription.hpp"
 
 namespace rpc
 {
@@ -17,6 +21,13 @@ struct Info
 };
 
 
+struct TransactionStatusUpdate
+{
+    base::Sha256 transaction_hash;
+    lk::TransactionStatus status;
+};
+
+
 class BaseRpc
 {
   public:
@@ -35,6 +46,37 @@ class BaseRpc
     virtual lk::TransactionStatus pushTransaction(const lk::Transaction& transaction) = 0;
 
     virtual lk::TransactionStatus getTransactionStatus(const base::Sha256& transaction_hash) = 0;
+
+    virtual lk::ViewCallResult callContractView(const lk::Transaction& call) = 0;
+
+    virtual std::uint64_t estimateGas(const lk::Transaction& tx) = 0;
+
+    virtual std::vector<lk::LogRecord> getLogs(const lk::LogsFilter& filter) = 0;
+
+    virtual std::vector<lk::ContractTrace> getVmTraces() = 0;
+
+    // blocks with numbers from from_number, less than count of them if the range goes beyond the top block
+    virtual std::vector<lk::ImmutableBlock> getBlocks(uint64_t from_number, std::size_t count) = 0;
+
+    virtual std::vector<lk::Transaction> getTransactions(const std::vector<base::Sha256>& transactions_hashes) = 0;
+
+    // statuses are in the order of transactions, a rejected transaction doesn't stop others from being pushed
+    virtual std::vector<lk::TransactionStatus> pushTransactions(const std::vector<lk::Transaction>& transactions) = 0;
+};
+
+
+// calls of a node served by rpc servers, clients don't subscribe and are BaseRpc only
+class BaseRpcService : public BaseRpc
+{
+  public:
+    // events are delivered to the subscription until it is released or overflowed
+    virtual std::shared_ptr<Subscription<lk::ImmutableBlock>> subscribeToBlocks() = 0;
+
+    virtual std::shared_ptr<Subscription<lk::Transaction>> subscribeToPendingTransactions() = 0;
+
+    // updates of the given transactions, of all transactions if transactions_hashes is empty
+    virtual std::shared_ptr<Subscription<TransactionStatusUpdate>> subscribeToTransactionStatuses(
+      const std::vector<base::Sha256>& transactions_hashes) = 0;
 };
 
 } // namespace rpc
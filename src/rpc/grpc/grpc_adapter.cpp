@@ -6,13 +6,54 @@
 #include "base/error.hpp"
 #include "base/log.hpp"
 
+#include <chrono>
+
 
 namespace rpc::grpc
 {
 
-void Adapter::init(std::shared_ptr<BaseRpc> service)
+namespace
+{
+
+constexpr std::chrono::milliseconds SUBSCRIPTION_CANCEL_CHECK_PERIOD{ 500 };
+
+
+// writes events of the subscription until the client cancels the call or the subscription is closed
+template<typename Event, typename Message, typename SerializeFn>
+::grpc::Status streamSubscription(::grpc::ServerContext* context,
+                                  Subscription<Event>& subscription,
+                                  ::grpc::ServerWriter<Message>* writer,
+                                  SerializeFn serialize)
+{
+    Message response;
+    while (!context->IsCancelled()) {
+        if (auto event = subscription.pop(SUBSCRIPTION_CANCEL_CHECK_PERIOD); event) {
+            response.Clear();
+            serialize(*event, &response);
+            if (!writer->Write(response)) {
+                break;
+            }
+        }
+        else if (subscription.isOverflowed()) {
+            LOG_DEBUG << "subscription of " << context->peer() << " was dropped";
+            return ::grpc::Status(::grpc::StatusCode::RESOURCE_EXHAUSTED, "subscriber didn't keep up with events");
+        }
+        else if (subscription.isClosed()) {
+            break;
+        }
+    }
+    return ::grpc::Status::CANCELLED;
+}
+
+} // namespace
+
+
+void Adapter::init(std::shared_ptr<BaseRpcService> service, std::size_t response_cache_size)
 {
     _service = std::move(service);
+    _blocks_cache = std::make_unique<ResponseCache<::likelib::Block>>("grpc blocks", response_cache_size / 2);
+    _transactions_cache =
+      std::make_unique<ResponseCache<::likelib::Transaction>>("grpc transactions", response_cache_size / 2);
 }
 
 
@@ -68,11 +109,18 @@ void Adapter::init(std::shared_ptr<BaseRpc> service)
 {
     LOG_DEBUG << "received RPC get_block_by_hash method call from " << context->peer();
     try {
+        auto key = "hash:" + request->bytes_base_64();
+        if (auto cached = _blocks_cache->find(key); cached) {
+            response->CopyFrom(*cached);
+            return ::grpc::Status::OK;
+        }
+
         base::Sha256 block_hash = deserializeHash(request);
 
         auto block = _service->getBlock(block_hash);
 
         serializeBlock(block, response);
+        _blocks_cache->put(key, *response, response->ByteSizeLong());
     }
     catch (const base::Error& e) {
         LOG_ERROR << e.what();
@@ -92,9 +140,19 @@ void Adapter::init(std::shared_ptr<BaseRpc> service)
 {
     LOG_DEBUG << "received RPC get_block method call from " << context->peer();
     try {
+        auto key = "number:" + std::to_string(request->number());
+        if (auto cached = _blocks_cache->find(key); cached) {
+            response->CopyFrom(*cached);
+            return ::grpc::Status::OK;
+        }
+
         auto block = _service->getBlock(request->number());
 
         serializeBlock(block, response);
+        auto top_block_number = _service->getNodeInfo().top_block_number;
+        if (request->number() + base::config::RPC_CACHE_FINALIZATION_DEPTH <= top_block_number) {
+            _blocks_cache->put(key, *response, response->ByteSizeLong());
+        }
     }
     catch (const base::Error& e) {
         LOG_ERROR << e.what();
@@ -114,11 +172,17 @@ void Adapter::init(std::shared_ptr<BaseRpc> service)
 {
     LOG_DEBUG << "received RPC get_transaction method call from " << context->peer();
     try {
+        if (auto cached = _transactions_cache->find(request->bytes_base_64()); cached) {
+            response->CopyFrom(*cached);
+            return ::grpc::Status::OK;
+        }
+
         base::Sha256 transaction_hash{ base::base64Decode(request->bytes_base_64()) };
 
         auto tx = _service->getTransaction(transaction_hash);
 
         serializeTransaction(tx, response);
+        _transactions_cache->put(request->bytes_base_64(), *response, response->ByteSizeLong());
     }
     catch (const base::Error& e) {
         LOG_ERROR << e.what();
@@ -179,4 +243,273 @@ void Adapter::init(std::shared_ptr<BaseRpc> service)
     return ::grpc::Status::OK;
 }
 
+
+::grpc::Status Adapter::call_contract_view(::grpc::ServerContext* context,
+                                           const ::likelib::Transaction* request,
+                                           ::likelib::ViewCallResult* response)
+{
+    LOG_DEBUG << "received RPC call_contract_view method call from " << context->peer();
+    try {
+        auto call = deserializeTransaction(request);
+
+        auto result = _service->callContractView(call);
+
+        serializeViewCallResult(result, response);
+    }
+    catch (const base::Error& e) {
+        LOG_ERROR << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "unexpected error: " << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+    return ::grpc::Status::OK;
+}
+
+
+::grpc::Status Adapter::estimate_gas(::grpc::ServerContext* context,
+                                     const ::likelib::Transaction* request,
+                                     ::likelib::Number* response)
+{
+    LOG_DEBUG << "received RPC estimate_gas method call from " << context->peer();
+    try {
+        auto tx = deserializeTransaction(request);
+
+        auto gas = _service->estimateGas(tx);
+
+        serializeNumber(gas, response);
+    }
+    catch (const base::Error& e) {
+        LOG_ERROR << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "unexpected error: " << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+    return ::grpc::Status::OK;
+}
+
+
+::grpc::Status Adapter::get_logs(::grpc::ServerContext* context,
+                                 const ::likelib::LogsFilter* request,
+                                 ::likelib::Logs* response)
+{
+    LOG_DEBUG << "received RPC get_logs method call from " << context->peer();
+    try {
+        auto filter = deserializeLogsFilter(request);
+
+        auto logs = _service->getLogs(filter);
+
+        for (const auto& record : logs) {
+            serializeLogRecord(record, response->mutable_logs()->Add());
+        }
+    }
+    catch (const base::Error& e) {
+        LOG_ERROR << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "unexpected error: " << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+    return ::grpc::Status::OK;
+}
+
+
+::grpc::Status Adapter::get_vm_trace(::grpc::ServerContext* context,
+                                     [[maybe_unused]] const ::likelib::None* request,
+                                     ::likelib::VmTrace* response)
+{
+    LOG_DEBUG << "received RPC get_vm_trace method call from " << context->peer();
+    try {
+        auto traces = _service->getVmTraces();
+
+        for (const auto& trace : traces) {
+            serializeContractTrace(trace, response->mutable_contracts()->Add());
+        }
+    }
+    catch (const base::Error& e) {
+        LOG_ERROR << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "unexpected error: " << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+    return ::grpc::Status::OK;
+}
+
+
+::grpc::Status Adapter::get_blocks_range(::grpc::ServerContext* context,
+                                         const ::likelib::BlocksRange* request,
+                                         ::grpc::ServerWriter<::likelib::Block>* writer)
+{
+    LOG_DEBUG << "received RPC get_blocks_range method call from " << context->peer();
+    try {
+        auto blocks = _service->getBlocks(request->from_number(), request->count());
+
+        ::likelib::Block response;
+        for (const auto& block : blocks) {
+            response.Clear();
+            serializeBlock(block, &response);
+            if (!writer->Write(response)) {
+                LOG_DEBUG << "get_blocks_range stream was closed by " << context->peer();
+                return ::grpc::Status::CANCELLED;
+            }
+        }
+    }
+    catch (const base::Error& e) {
+        LOG_ERROR << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "unexpected error: " << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+    return ::grpc::Status::OK;
+}
+
+
+::grpc::Status Adapter::get_transactions(::grpc::ServerContext* context,
+                                         const ::likelib::Hashes* request,
+                                         ::grpc::ServerWriter<::likelib::Transaction>* writer)
+{
+    LOG_DEBUG << "received RPC get_transactions method call from " << context->peer();
+    try {
+        std::vector<base::Sha256> transactions_hashes;
+        transactions_hashes.reserve(request->hashes_size());
+        for (const auto& hash : request->hashes()) {
+            transactions_hashes.push_back(deserializeHash(&hash));
+        }
+
+        auto txs = _service->getTransactions(transactions_hashes);
+
+        ::likelib::Transaction response;
+        for (const auto& tx : txs) {
+            response.Clear();
+            serializeTransaction(tx, &response);
+            if (!writer->Write(response)) {
+                LOG_DEBUG << "get_transactions stream was closed by " << context->peer();
+                return ::grpc::Status::CANCELLED;
+            }
+        }
+    }
+    catch (const base::Error& e) {
+        LOG_ERROR << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "unexpected error: " << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+    return ::grpc::Status::OK;
+}
+
+
+::grpc::Status Adapter::push_transactions(::grpc::ServerContext* context,
+                                          const ::likelib::Transactions* request,
+                                          ::grpc::ServerWriter<::likelib::TransactionStatus>* writer)
+{
+    LOG_DEBUG << "received RPC push_transactions method call from " << context->peer();
+    try {
+        std::vector<lk::Transaction> txs;
+        txs.reserve(request->transactions_size());
+        for (const auto& tx : request->transactions()) {
+            txs.push_back(deserializeTransaction(&tx));
+        }
+
+        auto statuses = _service->pushTransactions(txs);
+
+        ::likelib::TransactionStatus response;
+        for (const auto& status : statuses) {
+            response.Clear();
+            serializeTransactionStatus(status, &response);
+            if (!writer->Write(response)) {
+                LOG_DEBUG << "push_transactions stream was closed by " << context->peer();
+                return ::grpc::Status::CANCELLED;
+            }
+        }
+    }
+    catch (const base::Error& e) {
+        LOG_ERROR << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "unexpected error: " << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+    return ::grpc::Status::OK;
+}
+
+
+::grpc::Status Adapter::subscribe_blocks(::grpc::ServerContext* context,
+                                         [[maybe_unused]] const ::likelib::None* request,
+                                         ::grpc::ServerWriter<::likelib::Block>* writer)
+{
+    LOG_DEBUG << "received RPC subscribe_blocks method call from " << context->peer();
+    try {
+        auto subscription = _service->subscribeToBlocks();
+
+        return streamSubscription(context, *subscription, writer, serializeBlock);
+    }
+    catch (const base::Error& e) {
+        LOG_ERROR << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "unexpected error: " << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+}
+
+
+::grpc::Status Adapter::subscribe_pending_transactions(::grpc::ServerContext* context,
+                                                       [[maybe_unused]] const ::likelib::None* request,
+                                                       ::grpc::ServerWriter<::likelib::Transaction>* writer)
+{
+    LOG_DEBUG << "received RPC subscribe_pending_transactions method call from " << context->peer();
+    try {
+        auto subscription = _service->subscribeToPendingTransactions();
+
+        return streamSubscription(context, *subscription, writer, serializeTransaction);
+    }
+    catch (const base::Error& e) {
+        LOG_ERROR << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "unexpected error: " << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+}
+
+
+::grpc::Status Adapter::subscribe_transaction_statuses(::grpc::ServerContext* context,
+                                                       const ::likelib::Hashes* request,
+                                                       ::grpc::ServerWriter<::likelib::TransactionStatusUpdate>* writer)
+{
+    LOG_DEBUG << "received RPC subscribe_transaction_statuses method call from " << context->peer();
+    try {
+        std::vector<base::Sha256> transactions_hashes;
+        transactions_hashes.reserve(request->hashes_size());
+        for (const auto& hash : request->hashes()) {
+            transactions_hashes.push_back(deserializeHash(&hash));
+        }
+
+        auto subscription = _service->subscribeToTransactionStatuses(transactions_hashes);
+
+        return streamSubscription(context, *subscription, writer, serializeTransactionStatusUpdate);
+    }
+    catch (const base::Error& e) {
+        LOG_ERROR << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "unexpected error: " << e.what();
+        return ::grpc::Status::CANCELLED;
+    }
+}
+
 } // namespace rpc::grpc
@@ -3,6 +3,7 @@
 #include <public_rpc.grpc.pb.h>
 
 #include "rpc/base_rpc.hpp"
+#include "rpc/response_cache.hpp"
 
 #include <grpcpp/grpcpp.h>
 
@@ -12,8 +13,8 @@ namespace rpc::grpc
 {
 
 /// Class implement receive gRPC messages and call similar method from LogicService instance and send answers or error
-/// messages
-class Adapter final : public likelib::NodePublicInterface::Service
+/// messages. Methods are public, so that AsyncNodeServer could run them for calls taken from a completion queue
+class Adapter : public likelib::NodePublicInterface::Service
 {
   public:
     /// default constructor
@@ -23,10 +24,8 @@ class Adapter final : public likelib::NodePublicInterface::Service
     ~Adapter() override = default;
 
     /// method that call init in LogicService instance was created by that
-    void init(std::shared_ptr<BaseRpc> service);
-
-  private:
-    std::shared_ptr<BaseRpc> _service;
+    /// \param response_cache_size bytes of blocks and transactions kept serialized, 0 disables caching
+    void init(std::shared_ptr<BaseRpcService> service, std::size_t response_cache_size);
 
     ::grpc::Status get_account(::grpc::ServerContext* context,
                                const ::likelib::Address* request,
@@ -56,6 +55,53 @@ class Adapter final : public likelib::NodePublicInterface::Service
     ::grpc::Status get_transaction_result(::grpc::ServerContext* context,
                                           const ::likelib::Hash* request,
                                           ::likelib::TransactionStatus* response) override;
+
+    ::grpc::Status call_contract_view(::grpc::ServerContext* context,
+                                      const ::likelib::Transaction* request,
+                                      ::likelib::ViewCallResult* response) override;
+
+    ::grpc::Status estimate_gas(::grpc::ServerContext* context,
+                                const ::likelib::Transaction* request,
+                                ::likelib::Number* response) override;
+
+    ::grpc::Status get_logs(::grpc::ServerContext* context,
+                            const ::likelib::LogsFilter* request,
+                            ::likelib::Logs* response) override;
+
+    ::grpc::Status get_vm_trace(::grpc::ServerContext* context,
+                                const ::likelib::None* request,
+                                ::likelib::VmTrace* response) override;
+
+    ::grpc::Status get_blocks_range(::grpc::ServerContext* context,
+                                    const ::likelib::BlocksRange* request,
+                                    ::grpc::ServerWriter<::likelib::Block>* writer) override;
+
+    ::grpc::Status get_transactions(::grpc::ServerContext* context,
+                                    const ::likelib::Hashes* request,
+                                    ::grpc::ServerWriter<::likelib::Transaction>* writer) override;
+
+    ::grpc::Status push_transactions(::grpc::ServerContext* context,
+                                     const ::likelib::Transactions* request,
+                                     ::grpc::ServerWriter<::likelib::TransactionStatus>* writer) override;
+
+    ::grpc::Status subscribe_blocks(::grpc::ServerContext* context,
+                                    const ::likelib::None* request,
+                                    ::grpc::ServerWriter<::likelib::Block>* writer) override;
+
+    ::grpc::Status subscribe_pending_transactions(::grpc::ServerContext* context,
+                                                  const ::likelib::None* request,
+                                                  ::grpc::ServerWriter<::likelib::Transaction>* writer) override;
+
+    ::grpc::Status subscribe_transaction_statuses(
+      ::grpc::ServerContext* context,
+      const ::likelib::Hashes* request,
+      ::grpc::ServerWriter<::likelib::TransactionStatusUpdate>* writer) override;
+
+  private:
+    std::shared_ptr<BaseRpcService> _service;
+    // blocks are keyed by hash or by number, if they are deep enough not to be replaced by a fork
+    std::unique_ptr<ResponseCache<::likelib::Block>> _blocks_cache;
+    std::unique_ptr<ResponseCache<::likelib::Transaction>> _transactions_cache;
 };
 
 
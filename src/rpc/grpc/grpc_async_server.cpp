@@ -0,0 +1,258 @@
+#include "grpc_async_server.hpp"
+
+#include "rpc/error.hpp"
+
+#include "base/error.hpp"
+#include "base/log.hpp"
+
+#include <chrono>
+
+namespace rpc::grpc
+{
+
+namespace
+{
+
+constexpr std::chrono::seconds SHUTDOWN_TIMEOUT{ 5 }; // then calls in flight are cancelled
+
+} // namespace
+
+
+template<typename Request, typename Response>
+class AsyncNodeServer::UnaryCall : public AsyncNodeServer::Call
+{
+  public:
+    UnaryCall(AsyncNodeServer& server, RequestFn<Request, Response> request, HandleFn<Request, Response> handle)
+      : _server{ server }
+      , _request_fn{ request }
+      , _handle{ std::move(handle) }
+      , _responder{ &_context }
+    {
+        auto* completion_queue = _server._completion_queue.get();
+        (_server._service.*_request_fn)(&_context, &_request, &_responder, completion_queue, completion_queue, this);
+    }
+
+    void proceed(bool ok) override
+    {
+        if (_is_finishing || !ok) {
+            delete this;
+            return;
+        }
+
+        // the next call of the method is awaited while this one is handled
+        new UnaryCall(_server, _request_fn, _handle);
+
+        _is_finishing = true;
+        auto is_queued = _server.enqueue([this] {
+            auto status = _handle(&_context, &_request, &_response);
+            _responder.Finish(_response, status, this);
+        });
+        if (!is_queued) {
+            _responder.FinishWithError(::grpc::Status(::grpc::StatusCode::RESOURCE_EXHAUSTED, "node is overloaded"),
+                                       this);
+        }
+    }
+
+  private:
+    AsyncNodeServer& _server;
+    const RequestFn<Request, Response> _request_fn;
+    const HandleFn<Request, Response> _handle;
+
+    ::grpc::ServerContext _context;
+    Request _request;
+    Response _response;
+    ::grpc::ServerAsyncResponseWriter<Response> _responder;
+    bool _is_finishing{ false };
+};
+
+
+AsyncNodeServer::AsyncNodeServer(const std::string& server_address,
+                                 std::shared_ptr<BaseRpcService> service,
+                                 std::size_t workers_count,
+                                 std::size_t max_queued_calls,
+                                 std::size_t response_cache_size)
+  : _server_address{ server_address }
+  , _workers_count{ workers_count }
+  , _max_queued_calls{ max_queued_calls }
+{
+    if (_workers_count == 0) {
+        RAISE_ERROR(base::InvalidArgument, "gRPC server needs at least one worker");
+    }
+    _service.init(std::move(service), response_cache_size);
+}
+
+
+AsyncNodeServer::~AsyncNodeServer()
+{
+    stop();
+}
+
+
+void AsyncNodeServer::run()
+{
+    ::grpc::ServerBuilder builder;
+    auto channel_credentials = ::grpc::InsecureServerCredentials();
+    int selected_port = -1;
+    builder.AddListeningPort(_server_address, channel_credentials, &selected_port);
+    builder.RegisterService(&_service);
+    _completion_queue = builder.AddCompletionQueue();
+    _server = builder.BuildAndStart();
+    if (selected_port == -1 || selected_port == 0) {
+        RAISE_ERROR(rpc::RpcError, "RPC cannot bind to a selected port");
+    }
+
+    for (std::size_t i = 0; i < _workers_count; ++i) {
+        _workers.emplace_back(&AsyncNodeServer::worker, this);
+    }
+    _completion_queue_thread = std::thread(&AsyncNodeServer::pollCompletionQueue, this);
+
+    // handlers are the synchronous ones of Adapter, the qualified calls bypass the overrides disabling them
+    serve<likelib::Address, likelib::AccountInfo>(
+      &AsyncUnaryService::Requestget_account,
+      [this](auto* context, const auto* request, auto* response) {
+          return _service.Adapter::get_account(context, request, response);
+      });
+    serve<likelib::None, likelib::NodeInfo>(
+      &AsyncUnaryService::Requestget_node_info,
+      [this](auto* context, const auto* request, auto* response) {
+          return _service.Adapter::get_node_info(context, request, response);
+      });
+    serve<likelib::Hash, likelib::Block>(
+      &AsyncUnaryService::Requestget_block_by_hash,
+      [this](auto* context, const auto* request, auto* response) {
+          return _service.Adapter::get_block_by_hash(context, request, response);
+      });
+    serve<likelib::Number, likelib::Block>(
+      &AsyncUnaryService::Requestget_block_by_number,
+      [this](auto* context, const auto* request, auto* response) {
+          return _service.Adapter::get_block_by_number(context, request, response);
+      });
+    serve<likelib::Hash, likelib::Transaction>(
+      &AsyncUnaryService::Requestget_transaction,
+      [this](auto* context, const auto* request, auto* response) {
+          return _service.Adapter::get_transaction(context, request, response);
+      });
+    serve<likelib::Transaction, likelib::TransactionStatus>(
+      &AsyncUnaryService::Requestpush_transaction,
+      [this](auto* context, const auto* request, auto* response) {
+          return _service.Adapter::push_transaction(context, request, response);
+      });
+    serve<likelib::Hash, likelib::TransactionStatus>(
+      &AsyncUnaryService::Requestget_transaction_result,
+      [this](auto* context, const auto* request, auto* response) {
+          return _service.Adapter::get_transaction_result(context, request, response);
+      });
+    serve<likelib::Transaction, likelib::ViewCallResult>(
+      &AsyncUnaryService::Requestcall_contract_view,
+      [this](auto* context, const auto* request, auto* response) {
+          return _service.Adapter::call_contract_view(context, request, response);
+      });
+    serve<likelib::Transaction, likelib::Number>(
+      &AsyncUnaryService::Requestestimate_gas,
+      [this](auto* context, const auto* request, auto* response) {
+          return _service.Adapter::estimate_gas(context, request, response);
+      });
+    serve<likelib::LogsFilter, likelib::Logs>(
+      &AsyncUnaryService::Requestget_logs,
+      [this](auto* context, const auto* request, auto* response) {
+          return _service.Adapter::get_logs(context, request, response);
+      });
+    serve<likelib::None, likelib::VmTrace>(
+      &AsyncUnaryService::Requestget_vm_trace,
+      [this](auto* context, const auto* request, auto* response) {
+          return _service.Adapter::get_vm_trace(context, request, response);
+      });
+}
+
+
+void AsyncNodeServer::stop()
+{
+    if (!_server) {
+        return;
+    }
+    _server->Shutdown(std::chrono::system_clock::now() + SHUTDOWN_TIMEOUT);
+
+    // workers answer the calls that are already queued before they exit
+    {
+        std::lock_guard lk(_queue_mutex);
+        _is_stopping = true;
+    }
+    _queue_cv.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+    _workers.clear();
+
+    _completion_queue->Shutdown();
+    if (_completion_queue_thread.joinable()) {
+        _completion_queue_thread.join();
+    }
+    _server.reset();
+
+    auto statistics = getStatistics();
+    LOG_INFO << "async gRPC server handled " << statistics.handled << " calls and rejected " << statistics.rejected;
+}
+
+
+AsyncNodeServer::Statistics AsyncNodeServer::getStatistics() const
+{
+    std::lock_guard lk(_queue_mutex);
+    return Statistics{ _queue.size(), _handled, _rejected };
+}
+
+
+template<typename Request, typename Response>
+void AsyncNodeServer::serve(RequestFn<Request, Response> request, HandleFn<Request, Response> handle)
+{
+    // deletes itself when the call is answered
+    new UnaryCall<Request, Response>(*this, request, std::move(handle));
+}
+
+
+bool AsyncNodeServer::enqueue(std::function<void()> job)
+{
+    {
+        std::lock_guard lk(_queue_mutex);
+        if (_queue.size() >= _max_queued_calls) {
+            ++_rejected;
+            return false;
+        }
+        _queue.push_back(std::move(job));
+    }
+    _queue_cv.notify_one();
+    return true;
+}
+
+
+void AsyncNodeServer::worker()
+{
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock lk(_queue_mutex);
+            _queue_cv.wait(lk, [this] { return _is_stopping || !_queue.empty(); });
+            if (_queue.empty()) {
+                return;
+            }
+            job = std::move(_queue.front());
+            _queue.pop_front();
+        }
+
+        job();
+
+        std::lock_guard lk(_queue_mutex);
+        ++_handled;
+    }
+}
+
+
+void AsyncNodeServer::pollCompletionQueue()
+{
+    void* tag = nullptr;
+    bool ok = false;
+    while (_completion_queue->Next(&tag, &ok)) {
+        static_cast<Call*>(tag)->proceed(ok);
+    }
+}
+
+} // namespace rpc::grpc
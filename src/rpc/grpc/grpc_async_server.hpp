@@ -0,0 +1,117 @@
+#pragma once
+
+#include "rpc/grpc/grpc_adapter.hpp"
+
+#include "rpc/rpc.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rpc::grpc
+{
+
+// unary methods are taken from a completion queue, streaming ones are served by the synchronous Adapter
+using AsyncUnaryService = likelib::NodePublicInterface::WithAsyncMethod_get_account<
+  likelib::NodePublicInterface::WithAsyncMethod_get_node_info<
+    likelib::NodePublicInterface::WithAsyncMethod_get_block_by_hash<
+      likelib::NodePublicInterface::WithAsyncMethod_get_block_by_number<
+        likelib::NodePublicInterface::WithAsyncMethod_get_transaction<
+          likelib::NodePublicInterface::WithAsyncMethod_push_transaction<
+            likelib::NodePublicInterface::WithAsyncMethod_get_transaction_result<
+              likelib::NodePublicInterface::WithAsyncMethod_call_contract_view<
+                likelib::NodePublicInterface::WithAsyncMethod_estimate_gas<
+                  likelib::NodePublicInterface::WithAsyncMethod_get_logs<
+                    likelib::NodePublicInterface::WithAsyncMethod_get_vm_trace<Adapter>>>>>>>>>>>;
+
+
+/// Server that doesn't hold a gRPC thread for each call in flight. Unary calls are read and answered through
+/// a completion queue, while their handlers run on a fixed number of workers. A call that finds
+/// max_queued_calls already waiting for workers is rejected with RESOURCE_EXHAUSTED at once.
+class AsyncNodeServer : public BaseRpcServer
+{
+  public:
+    struct Statistics
+    {
+        std::size_t queued{ 0 };   // calls waiting for a worker right now
+        std::size_t handled{ 0 };  // calls that were run by workers
+        std::size_t rejected{ 0 }; // calls rejected, because the queue was full
+    };
+
+    /// \param server_address listening ip:port
+    /// \param workers_count number of threads running handlers of calls
+    /// \param max_queued_calls limit of calls waiting for a worker
+    /// \param response_cache_size bytes of serialized blocks and transactions kept to answer repeated calls
+    AsyncNodeServer(const std::string& server_address,
+                    std::shared_ptr<BaseRpcService> service,
+                    std::size_t workers_count,
+                    std::size_t max_queued_calls,
+                    std::size_t response_cache_size);
+
+    AsyncNodeServer(const AsyncNodeServer&) = delete;
+    AsyncNodeServer& operator=(const AsyncNodeServer&) = delete;
+
+    ~AsyncNodeServer() override;
+
+    /// start listening port, workers and completion queue thread
+    void run() override;
+
+    /// stop listening, answer calls that are already queued and stop threads
+    void stop() override;
+
+    Statistics getStatistics() const;
+
+  private:
+    // a state of a call, it is a tag of the completion queue
+    class Call
+    {
+      public:
+        virtual ~Call() = default;
+        virtual void proceed(bool ok) = 0;
+    };
+
+    template<typename Request, typename Response>
+    class UnaryCall;
+
+    template<typename Request, typename Response>
+    using RequestFn = void (AsyncUnaryService::*)(::grpc::ServerContext*,
+                                                  Request*,
+                                                  ::grpc::ServerAsyncResponseWriter<Response>*,
+                                                  ::grpc::CompletionQueue*,
+                                                  ::grpc::ServerCompletionQueue*,
+                                                  void*);
+
+    template<typename Request, typename Response>
+    using HandleFn = std::function<::grpc::Status(::grpc::ServerContext*, const Request*, Response*)>;
+
+    AsyncUnaryService _service;
+    const std::string _server_address;
+    const std::size_t _workers_count;
+    const std::size_t _max_queued_calls;
+
+    std::unique_ptr<::grpc::ServerCompletionQueue> _completion_queue;
+    std::unique_ptr<::grpc::Server> _server;
+    std::thread _completion_queue_thread;
+    std::vector<std::thread> _workers;
+
+    mutable std::mutex _queue_mutex;
+    std::condition_variable _queue_cv;
+    std::deque<std::function<void()>> _queue;
+    bool _is_stopping{ false };
+    std::size_t _handled{ 0 };
+    std::size_t _rejected{ 0 };
+
+    template<typename Request, typename Response>
+    void serve(RequestFn<Request, Response> request, HandleFn<Request, Response> handle);
+
+    // returns false if the queue is full
+    bool enqueue(std::function<void()> job);
+    void worker();
+    void pollCompletionQueue();
+};
+
+} // namespace rpc::grpc
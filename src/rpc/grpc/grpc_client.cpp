@@ -225,4 +225,238 @@ lk::TransactionStatus NodeClient::getTransactionStatus(const base::Sha256& trans
     }
 }
 
+
+lk::ViewCallResult NodeClient::callContractView(const lk::Transaction& call)
+{
+    // convert data for request
+    likelib::Transaction request;
+    try {
+        serializeTransaction(call, &request);
+    }
+    catch (const base::Error& er) {
+        RAISE_ERROR(RpcError, std::string("serialization error: ") + er.what());
+    }
+
+    // call remote host
+    likelib::ViewCallResult reply;
+    ::grpc::ClientContext context;
+    auto status = _stub->call_contract_view(&context, request, &reply);
+
+    // return value if ok
+    if (status.ok()) {
+        try {
+            return deserializeViewCallResult(&reply);
+        }
+        catch (const base::Error& er) {
+            RAISE_ERROR(RpcError, std::string("deserialization error: ") + er.what());
+        }
+    }
+    else {
+        RAISE_ERROR(RpcError, status.error_message());
+    }
+}
+
+
+std::uint64_t NodeClient::estimateGas(const lk::Transaction& tx)
+{
+    // convert data for request
+    likelib::Transaction request;
+    try {
+        serializeTransaction(tx, &request);
+    }
+    catch (const base::Error& er) {
+        RAISE_ERROR(RpcError, std::string("serialization error: ") + er.what());
+    }
+
+    // call remote host
+    likelib::Number reply;
+    ::grpc::ClientContext context;
+    auto status = _stub->estimate_gas(&context, request, &reply);
+
+    // return value if ok
+    if (status.ok()) {
+        return reply.number();
+    }
+    else {
+        RAISE_ERROR(RpcError, status.error_message());
+    }
+}
+
+
+std::vector<lk::LogRecord> NodeClient::getLogs(const lk::LogsFilter& filter)
+{
+    // convert data for request
+    likelib::LogsFilter request;
+    try {
+        serializeLogsFilter(filter, &request);
+    }
+    catch (const base::Error& er) {
+        RAISE_ERROR(RpcError, std::string("serialization error: ") + er.what());
+    }
+
+    // call remote host
+    likelib::Logs reply;
+    ::grpc::ClientContext context;
+    auto status = _stub->get_logs(&context, request, &reply);
+
+    // return value if ok
+    if (status.ok()) {
+        try {
+            std::vector<lk::LogRecord> logs;
+            for (const auto& record : reply.logs()) {
+                logs.push_back(deserializeLogRecord(&record));
+            }
+            return logs;
+        }
+        catch (const base::Error& er) {
+            RAISE_ERROR(RpcError, std::string("deserialization error: ") + er.what());
+        }
+    }
+    else {
+        RAISE_ERROR(RpcError, status.error_message());
+    }
+}
+
+
+std::vector<lk::ContractTrace> NodeClient::getVmTraces()
+{
+    // convert data for request
+    likelib::None request;
+
+    // call remote host
+    likelib::VmTrace reply;
+    ::grpc::ClientContext context;
+    auto status = _stub->get_vm_trace(&context, request, &reply);
+
+    // return value if ok
+    if (status.ok()) {
+        try {
+            std::vector<lk::ContractTrace> traces;
+            for (const auto& trace : reply.contracts()) {
+                traces.push_back(deserializeContractTrace(&trace));
+            }
+            return traces;
+        }
+        catch (const base::Error& er) {
+            RAISE_ERROR(RpcError, std::string("deserialization error: ") + er.what());
+        }
+    }
+    else {
+        RAISE_ERROR(RpcError, status.error_message());
+    }
+}
+
+
+std::vector<lk::ImmutableBlock> NodeClient::getBlocks(uint64_t from_number, std::size_t count)
+{
+    // convert data for request
+    likelib::BlocksRange request;
+    request.set_from_number(from_number);
+    request.set_count(count);
+
+    // call remote host, blocks are read as they arrive
+    ::grpc::ClientContext context;
+    auto reader = _stub->get_blocks_range(&context, request);
+    std::vector<lk::ImmutableBlock> blocks;
+    likelib::Block reply;
+    try {
+        while (reader->Read(&reply)) {
+            blocks.push_back(deserializeBlock(&reply));
+        }
+    }
+    catch (const base::Error& er) {
+        context.TryCancel();
+        reader->Finish();
+        RAISE_ERROR(RpcError, std::string("deserialization error: ") + er.what());
+    }
+
+    // return value if ok
+    if (auto status = reader->Finish(); status.ok()) {
+        return blocks;
+    }
+    else {
+        RAISE_ERROR(RpcError, status.error_message());
+    }
+}
+
+
+std::vector<lk::Transaction> NodeClient::getTransactions(const std::vector<base::Sha256>& transactions_hashes)
+{
+    // convert data for request
+    likelib::Hashes request;
+    try {
+        for (const auto& hash : transactions_hashes) {
+            serializeHash(hash, request.mutable_hashes()->Add());
+        }
+    }
+    catch (const base::Error& er) {
+        RAISE_ERROR(RpcError, std::string("serialization error: ") + er.what());
+    }
+
+    // call remote host, transactions are read as they arrive
+    ::grpc::ClientContext context;
+    auto reader = _stub->get_transactions(&context, request);
+    std::vector<lk::Transaction> txs;
+    txs.reserve(transactions_hashes.size());
+    likelib::Transaction reply;
+    try {
+        while (reader->Read(&reply)) {
+            txs.push_back(deserializeTransaction(&reply));
+        }
+    }
+    catch (const base::Error& er) {
+        context.TryCancel();
+        reader->Finish();
+        RAISE_ERROR(RpcError, std::string("deserialization error: ") + er.what());
+    }
+
+    // return value if ok
+    if (auto status = reader->Finish(); status.ok()) {
+        return txs;
+    }
+    else {
+        RAISE_ERROR(RpcError, status.error_message());
+    }
+}
+
+
+std::vector<lk::TransactionStatus> NodeClient::pushTransactions(const std::vector<lk::Transaction>& transactions)
+{
+    // convert data for request
+    likelib::Transactions request;
+    try {
+        for (const auto& tx : transactions) {
+            serializeTransaction(tx, request.mutable_transactions()->Add());
+        }
+    }
+    catch (const base::Error& er) {
+        RAISE_ERROR(RpcError, std::string("serialization error: ") + er.what());
+    }
+
+    // call remote host, statuses are read as they arrive
+    ::grpc::ClientContext context;
+    auto reader = _stub->push_transactions(&context, request);
+    std::vector<lk::TransactionStatus> statuses;
+    statuses.reserve(transactions.size());
+    likelib::TransactionStatus reply;
+    try {
+        while (reader->Read(&reply)) {
+            statuses.push_back(deserializeTransactionStatus(&reply));
+        }
+    }
+    catch (const base::Error& er) {
+        context.TryCancel();
+        reader->Finish();
+        RAISE_ERROR(RpcError, std::string("deserialization error: ") + er.what());
+    }
+
+    // return value if ok
+    if (auto status = reader->Finish(); status.ok()) {
+        return statuses;
+    }
+    else {
+        RAISE_ERROR(RpcError, status.error_message());
+    }
+}
+
 } // namespace rpc::grpc
@@ -31,6 +31,20 @@ class NodeClient final : public BaseRpc
 
     lk::TransactionStatus getTransactionStatus(const base::Sha256& transaction_hash) override;
 
+    lk::ViewCallResult callContractView(const lk::Transaction& call) override;
+
+    std::uint64_t estimateGas(const lk::Transaction& tx) override;
+
+    std::vector<lk::LogRecord> getLogs(const lk::LogsFilter& filter) override;
+
+    std::vector<lk::ContractTrace> getVmTraces() override;
+
+    std::vector<lk::ImmutableBlock> getBlocks(uint64_t from_number, std::size_t count) override;
+
+    std::vector<lk::Transaction> getTransactions(const std::vector<base::Sha256>& transactions_hashes) override;
+
+    std::vector<lk::TransactionStatus> pushTransactions(const std::vector<lk::Transaction>& transactions) override;
+
   private:
     std::unique_ptr<likelib::NodePublicInterface::Stub> _stub;
 };
@@ -7,11 +7,13 @@
 namespace rpc::grpc
 {
 
-NodeServer::NodeServer(const std::string& server_address, std::shared_ptr<BaseRpc> service)
+NodeServer::NodeServer(const std::string& server_address,
+                       std::shared_ptr<BaseRpcService> service,
+                       std::size_t response_cache_size)
   : _service()
   , _server_address(server_address)
 {
-    _service.init(std::move(service));
+    _service.init(std::move(service), response_cache_size);
 }
 
 
@@ -13,7 +13,10 @@ class NodeServer : public BaseRpcServer
   public:
     /// Constructor that initialize instance of LogicService
     /// \param server_address listening ip:port
-    NodeServer(const std::string& server_address, std::shared_ptr<BaseRpc> service);
+    /// \param response_cache_size bytes of serialized blocks and transactions kept to answer repeated calls
+    NodeServer(const std::string& server_address,
+               std::shared_ptr<BaseRpcService> service,
+               std::size_t response_cache_size);
 
     /// plain destructor that call GrpcNodeServer::stop()
     ~NodeServer() override;
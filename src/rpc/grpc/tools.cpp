@@ -119,7 +119,7 @@ void serializeAddress(const lk::Address& from, likelib::Address* to)
 
 lk::Address deserializeAddress(const likelib::Address* const address)
 {
-    return lk::Address{ base::base58Decode(address->address_at_base_58()) };
+    return lk::Address{ base::base58Decode<lk::Address::LENGTH_IN_BYTES>(address->address_at_base_58()) };
 }
 
 
@@ -251,12 +251,127 @@ lk::ImmutableBlock deserializeBlock(const likelib::Block* const block_to_deseria
 }
 
 
+void serializeEventLog(const lk::EventLog& from, likelib::EventLog* to)
+{
+    serializeAddress(from.address, to->mutable_address());
+    for (const auto& topic : from.topics) {
+        to->mutable_topics()->Add()->set_bytes_base_64(base::base64Encode(topic));
+    }
+    to->mutable_data()->set_bytes_base_64(base::base64Encode(from.data));
+}
+
+
+lk::EventLog deserializeEventLog(const likelib::EventLog* const log)
+{
+    lk::EventLog ret{ deserializeAddress(&log->address()), {}, deserializeData(&log->data()) };
+    for (const auto& topic : log->topics()) {
+        ret.topics.emplace_back(deserializeData(&topic));
+    }
+    return ret;
+}
+
+
+void serializeLogRecord(const lk::LogRecord& from, likelib::LogRecord* to)
+{
+    to->set_block_depth(from.block_depth);
+    serializeHash(from.transaction_hash, to->mutable_transaction_hash());
+    serializeEventLog(from.log, to->mutable_log());
+}
+
+
+lk::LogRecord deserializeLogRecord(const likelib::LogRecord* const record)
+{
+    return lk::LogRecord{ record->block_depth(),
+                          deserializeHash(&record->transaction_hash()),
+                          deserializeEventLog(&record->log()) };
+}
+
+
+void serializeLogsFilter(const lk::LogsFilter& from, likelib::LogsFilter* to)
+{
+    to->set_from_depth(from.from_depth);
+    to->set_to_depth(from.to_depth);
+    if (from.address) {
+        serializeAddress(*from.address, to->mutable_address());
+    }
+    for (const auto& topic : from.topics) {
+        auto* data = to->mutable_topics()->Add();
+        if (topic) {
+            data->set_bytes_base_64(base::base64Encode(*topic));
+        }
+    }
+}
+
+
+lk::LogsFilter deserializeLogsFilter(const likelib::LogsFilter* const filter)
+{
+    lk::LogsFilter ret;
+    ret.from_depth = filter->from_depth();
+    ret.to_depth = filter->to_depth();
+    if (filter->has_address()) {
+        ret.address = deserializeAddress(&filter->address());
+    }
+    for (const auto& topic : filter->topics()) {
+        if (topic.bytes_base_64().empty()) {
+            ret.topics.emplace_back(std::nullopt);
+        }
+        else {
+            ret.topics.emplace_back(lk::LogTopic(deserializeData(&topic)));
+        }
+    }
+    return ret;
+}
+
+
+void serializeContractTrace(const lk::ContractTrace& from, likelib::ContractTrace* to)
+{
+    serializeAddress(from.address, to->mutable_address());
+    to->set_calls(from.calls);
+    to->set_failed_calls(from.failed_calls);
+    to->set_gas_used(from.gas_used);
+    to->set_total_time_ns(static_cast<std::uint64_t>(from.total_time.count()));
+    to->set_own_time_ns(static_cast<std::uint64_t>(from.own_time.count()));
+    to->set_max_call_time_ns(static_cast<std::uint64_t>(from.max_call_time.count()));
+    to->set_max_depth(from.max_depth);
+    to->set_storage_reads(from.host_calls.storage_reads);
+    to->set_storage_writes(from.host_calls.storage_writes);
+    to->set_balance_reads(from.host_calls.balance_reads);
+    to->set_code_reads(from.host_calls.code_reads);
+    to->set_nested_calls(from.host_calls.calls);
+    to->set_logs(from.host_calls.logs);
+}
+
+
+lk::ContractTrace deserializeContractTrace(const likelib::ContractTrace* const trace)
+{
+    lk::ContractTrace ret;
+    ret.address = deserializeAddress(&trace->address());
+    ret.calls = trace->calls();
+    ret.failed_calls = trace->failed_calls();
+    ret.gas_used = trace->gas_used();
+    ret.total_time = std::chrono::nanoseconds(trace->total_time_ns());
+    ret.own_time = std::chrono::nanoseconds(trace->own_time_ns());
+    ret.max_call_time = std::chrono::nanoseconds(trace->max_call_time_ns());
+    ret.max_depth = trace->max_depth();
+    ret.host_calls.storage_reads = trace->storage_reads();
+    ret.host_calls.storage_writes = trace->storage_writes();
+    ret.host_calls.balance_reads = trace->balance_reads();
+    ret.host_calls.code_reads = trace->code_reads();
+    ret.host_calls.calls = trace->nested_calls();
+    ret.host_calls.logs = trace->logs();
+    return ret;
+}
+
+
 void serializeTransactionStatus(const lk::TransactionStatus& from, likelib::TransactionStatus* to)
 {
     to->set_fee_left(from.getFeeLeft());
     to->set_message(from.getMessage());
     to->set_status(serializeTransactionStatusCode(from.getStatus()));
     to->set_type(serializeTransactionActionType(from.getType()));
+    for (const auto& log : from.getLogs()) {
+        serializeEventLog(log, to->mutable_logs()->Add());
+    }
 }
 
 
@@ -264,7 +379,34 @@ lk::TransactionStatus deserializeTransactionStatus(const likelib::TransactionSta
 {
     lk::TransactionStatus::StatusCode status_code = deserializeTransactionStatusCode(status->status());
     lk::TransactionStatus::ActionType action_type = deserializeTransactionActionType(status->type());
-    return lk::TransactionStatus{ status_code, action_type, status->fee_left(), status->message() };
+    std::vector<lk::EventLog> logs;
+    for (const auto& log : status->logs()) {
+        logs.push_back(deserializeEventLog(&log));
+    }
+    return lk::TransactionStatus{ status_code, action_type, status->fee_left(), status->message(), std::move(logs) };
+}
+
+
+void serializeTransactionStatusUpdate(const TransactionStatusUpdate& from, likelib::TransactionStatusUpdate* to)
+{
+    serializeHash(from.transaction_hash, to->mutable_transaction_hash());
+    serializeTransactionStatus(from.status, to->mutable_status());
+}
+
+
+void serializeViewCallResult(const lk::ViewCallResult& from, likelib::ViewCallResult* to)
+{
+    to->set_status(serializeTransactionStatusCode(from.status));
+    to->mutable_output()->set_bytes_base_64(base::base64Encode(from.output));
+    to->set_gas_used(from.gas_used);
+}
+
+
+lk::ViewCallResult deserializeViewCallResult(const likelib::ViewCallResult* const result)
+{
+    return lk::ViewCallResult{ deserializeTransactionStatusCode(result->status()),
+                               deserializeData(&result->output()),
+                               result->gas_used() };
 }
 
 }
\ No newline at end of file
@@ -47,8 +47,30 @@ void serializeBlock(const lk::ImmutableBlock& from, likelib::Block* to);
 
 lk::ImmutableBlock deserializeBlock(const likelib::Block* const block);
 
+void serializeEventLog(const lk::EventLog& from, likelib::EventLog* to);
+
+lk::EventLog deserializeEventLog(const likelib::EventLog* const log);
+
+void serializeLogRecord(const lk::LogRecord& from, likelib::LogRecord* to);
+
+lk::LogRecord deserializeLogRecord(const likelib::LogRecord* const record);
+
+void serializeLogsFilter(const lk::LogsFilter& from, likelib::LogsFilter* to);
+
+lk::LogsFilter deserializeLogsFilter(const likelib::LogsFilter* const filter);
+
+void serializeContractTrace(const lk::ContractTrace& from, likelib::ContractTrace* to);
+
+lk::ContractTrace deserializeContractTrace(const likelib::ContractTrace* const trace);
+
 void serializeTransactionStatus(const lk::TransactionStatus& from, likelib::TransactionStatus* to);
 
 lk::TransactionStatus deserializeTransactionStatus(const likelib::TransactionStatus* const status);
 
+void serializeTransactionStatusUpdate(const TransactionStatusUpdate& from, likelib::TransactionStatusUpdate* to);
+
+void serializeViewCallResult(const lk::ViewCallResult& from, likelib::ViewCallResult* to);
+
+lk::ViewCallResult deserializeViewCallResult(const likelib::ViewCallResult* const result);
+
 }
\ No newline at end of file
@@ -2,10 +2,15 @@
 
 #include "rpc/http/tools.hpp"
 
+#include "base/error.hpp"
+
 #include <cpprest/asyncrt_utils.h>
 #include <cpprest/json.h>
 #include <cpprest/uri.h>
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
 #include <string>
 
 namespace rpc::http
@@ -15,18 +20,18 @@ class ActionBase
 {
   public:
     //====================================
-    explicit ActionBase(std::shared_ptr<rpc::BaseRpc>& service);
+    explicit ActionBase(std::shared_ptr<rpc::BaseRpcService>& service);
     virtual ~ActionBase() = default;
     //====================================
     virtual const std::string& getName() const = 0;
     virtual void run(web::json::value& result) = 0;
     //====================================
   protected:
-    std::shared_ptr<rpc::BaseRpc>& _service;
+    std::shared_ptr<rpc::BaseRpcService>& _service;
 };
 
 
-ActionBase::ActionBase(std::shared_ptr<rpc::BaseRpc>& service)
+ActionBase::ActionBase(std::shared_ptr<rpc::BaseRpcService>& service)
   : _service{ service }
 {}
 
@@ -35,7 +40,7 @@ class ActionNodeInfo : public ActionBase
 {
   public:
     //====================================
-    explicit ActionNodeInfo(std::shared_ptr<rpc::BaseRpc>& service);
+    explicit ActionNodeInfo(std::shared_ptr<rpc::BaseRpcService>& service);
     virtual ~ActionNodeInfo() = default;
     //====================================
     const std::string& getName() const override;
@@ -43,7 +48,7 @@ class ActionNodeInfo : public ActionBase
 };
 
 
-ActionNodeInfo::ActionNodeInfo(std::shared_ptr<rpc::BaseRpc>& service)
+ActionNodeInfo::ActionNodeInfo(std::shared_ptr<rpc::BaseRpcService>& service)
   : ActionBase(service)
 {}
 
@@ -62,11 +67,46 @@ void ActionNodeInfo::run(web::json::value& result)
 }
 
 
+class ActionGetVmTrace : public ActionBase
+{
+  public:
+    //====================================
+    explicit ActionGetVmTrace(std::shared_ptr<rpc::BaseRpcService>& service);
+    virtual ~ActionGetVmTrace() = default;
+    //====================================
+    const std::string& getName() const override;
+    void run(web::json::value& result) override;
+};
+
+
+ActionGetVmTrace::ActionGetVmTrace(std::shared_ptr<rpc::BaseRpcService>& service)
+  : ActionBase(service)
+{}
+
+
+const std::string& ActionGetVmTrace::getName() const
+{
+    static const std::string name = "get_vm_trace";
+    return name;
+}
+
+
+void ActionGetVmTrace::run(web::json::value& result)
+{
+    auto traces = _service->getVmTraces();
+    std::vector<web::json::value> traces_values;
+    for (const auto& trace : traces) {
+        traces_values.emplace_back(serializeContractTrace(trace));
+    }
+    result = web::json::value::array(traces_values);
+}
+
+
 class ActionJsonProcessBase : public ActionBase
 {
   public:
     //====================================
-    explicit ActionJsonProcessBase(web::json::value& input, std::shared_ptr<rpc::BaseRpc>& service);
+    explicit ActionJsonProcessBase(web::json::value& input, std::shared_ptr<rpc::BaseRpcService>& service);
     virtual ~ActionJsonProcessBase() = default;
     virtual bool loadArguments() = 0;
     //====================================
@@ -75,7 +115,7 @@ class ActionJsonProcessBase : public ActionBase
 };
 
 
-ActionJsonProcessBase::ActionJsonProcessBase(web::json::value& input, std::shared_ptr<rpc::BaseRpc>& service)
+ActionJsonProcessBase::ActionJsonProcessBase(web::json::value& input, std::shared_ptr<rpc::BaseRpcService>& service)
   : ActionBase(service)
   , _input{ input }
 {}
@@ -85,7 +125,7 @@ class ActionGetAccount : public ActionJsonProcessBase
 {
   public:
     //====================================
-    explicit ActionGetAccount(web::json::value& input, std::shared_ptr<rpc::BaseRpc>& service);
+    explicit ActionGetAccount(web::json::value& input, std::shared_ptr<rpc::BaseRpcService>& service);
     virtual ~ActionGetAccount() = default;
     //====================================
     const std::string& getName() const override;
@@ -97,7 +137,7 @@ class ActionGetAccount : public ActionJsonProcessBase
 };
 
 
-ActionGetAccount::ActionGetAccount(web::json::value& input, std::shared_ptr<rpc::BaseRpc>& service)
+ActionGetAccount::ActionGetAccount(web::json::value& input, std::shared_ptr<rpc::BaseRpcService>& service)
   : ActionJsonProcessBase(input, service)
 {}
 
@@ -130,7 +170,7 @@ class ActionGetBlock : public ActionJsonProcessBase
 {
   public:
     //====================================
-    explicit ActionGetBlock(web::json::value& input, std::shared_ptr<rpc::BaseRpc>& service);
+    explicit ActionGetBlock(web::json::value& input, std::shared_ptr<rpc::BaseRpcService>& service);
     virtual ~ActionGetBlock() = default;
     //====================================
     const std::string& getName() const override;
@@ -143,7 +183,7 @@ class ActionGetBlock : public ActionJsonProcessBase
 };
 
 
-ActionGetBlock::ActionGetBlock(web::json::value& input, std::shared_ptr<rpc::BaseRpc>& service)
+ActionGetBlock::ActionGetBlock(web::json::value& input, std::shared_ptr<rpc::BaseRpcService>& service)
   : ActionJsonProcessBase(input, service)
 {}
 
@@ -189,7 +229,7 @@ class ActionGetTransaction : public ActionJsonProcessBase
 {
   public:
     //====================================
-    explicit ActionGetTransaction(web::json::value& input, std::shared_ptr<rpc::BaseRpc>& service);
+    explicit ActionGetTransaction(web::json::value& input, std::shared_ptr<rpc::BaseRpcService>& service);
     virtual ~ActionGetTransaction() = default;
     //====================================
     const std::string& getName() const override;
@@ -201,7 +241,7 @@ class ActionGetTransaction : public ActionJsonProcessBase
 };
 
 
-ActionGetTransaction::ActionGetTransaction(web::json::value& input, std::shared_ptr<rpc::BaseRpc>& service)
+ActionGetTransaction::ActionGetTransaction(web::json::value& input, std::shared_ptr<rpc::BaseRpcService>& service)
   : ActionJsonProcessBase(input, service)
 {}
 
@@ -234,7 +274,7 @@ class ActionGetTransactionStatus : public ActionJsonProcessBase
 {
   public:
     //====================================
-    explicit ActionGetTransactionStatus(web::json::value& input, std::shared_ptr<rpc::BaseRpc>& service);
+    explicit ActionGetTransactionStatus(web::json::value& input, std::shared_ptr<rpc::BaseRpcService>& service);
     virtual ~ActionGetTransactionStatus() = default;
     //====================================
     const std::string& getName() const override;
@@ -246,7 +286,8 @@ class ActionGetTransactionStatus : public ActionJsonProcessBase
 };
 
 
-ActionGetTransactionStatus::ActionGetTransactionStatus(web::json::value& input, std::shared_ptr<rpc::BaseRpc>& service)
+ActionGetTransactionStatus::ActionGetTransactionStatus(web::json::value& input,
+                                                       std::shared_ptr<rpc::BaseRpcService>& service)
   : ActionJsonProcessBase(input, service)
 {}
 
@@ -279,7 +320,7 @@ class ActionPushTransaction : public ActionJsonProcessBase
 {
   public:
     //====================================
-    explicit ActionPushTransaction(web::json::value& input, std::shared_ptr<rpc::BaseRpc>& service);
+    explicit ActionPushTransaction(web::json::value& input, std::shared_ptr<rpc::BaseRpcService>& service);
     virtual ~ActionPushTransaction() = default;
     //====================================
     const std::string& getName() const override;
@@ -291,7 +332,7 @@ class ActionPushTransaction : public ActionJsonProcessBase
 };
 
 
-ActionPushTransaction::ActionPushTransaction(web::json::value& input, std::shared_ptr<rpc::BaseRpc>& service)
+ActionPushTransaction::ActionPushTransaction(web::json::value& input, std::shared_ptr<rpc::BaseRpcService>& service)
   : ActionJsonProcessBase(input, service)
 {}
 
@@ -317,8 +358,138 @@ void ActionPushTransaction::run(web::json::value& result)
 }
 
 
+class ActionCallContractView : public ActionJsonProcessBase
+{
+  public:
+    //====================================
+    explicit ActionCallContractView(web::json::value& input, std::shared_ptr<rpc::BaseRpcService>& service);
+    virtual ~ActionCallContractView() = default;
+    //====================================
+    const std::string& getName() const override;
+    bool loadArguments() override;
+    void run(web::json::value& result) override;
+
+  private:
+    std::optional<lk::Transaction> _call;
+};
+
+
+ActionCallContractView::ActionCallContractView(web::json::value& input, std::shared_ptr<rpc::BaseRpcService>& service)
+  : ActionJsonProcessBase(input, service)
+{}
+
+
+const std::string& ActionCallContractView::getName() const
+{
+    static const std::string name = "call_contract_view";
+    return name;
+}
+
+
+bool ActionCallContractView::loadArguments()
+{
+    _call = deserializeTransaction(_input);
+    return _call.has_value();
+}
+
+
+void ActionCallContractView::run(web::json::value& result)
+{
+    auto view_result = _service->callContractView(_call.value());
+    result = serializeViewCallResult(view_result);
+}
+
+
+class ActionEstimateGas : public ActionJsonProcessBase
+{
+  public:
+    //====================================
+    explicit ActionEstimateGas(web::json::value& input, std::shared_ptr<rpc::BaseRpcService>& service);
+    virtual ~ActionEstimateGas() = default;
+    //====================================
+    const std::string& getName() const override;
+    bool loadArguments() override;
+    void run(web::json::value& result) override;
+
+  private:
+    std::optional<lk::Transaction> _tx;
+};
+
+
+ActionEstimateGas::ActionEstimateGas(web::json::value& input, std::shared_ptr<rpc::BaseRpcService>& service)
+  : ActionJsonProcessBase(input, service)
+{}
+
+
+const std::string& ActionEstimateGas::getName() const
+{
+    static const std::string name = "estimate_gas";
+    return name;
+}
+
+
+bool ActionEstimateGas::loadArguments()
+{
+    _tx = deserializeTransaction(_input);
+    return _tx.has_value();
+}
+
+
+void ActionEstimateGas::run(web::json::value& result)
+{
+    auto gas = _service->estimateGas(_tx.value());
+    result = serializeFee(gas);
+}
+
+
+class ActionGetLogs : public ActionJsonProcessBase
+{
+  public:
+    //====================================
+    explicit ActionGetLogs(web::json::value& input, std::shared_ptr<rpc::BaseRpcService>& service);
+    virtual ~ActionGetLogs() = default;
+    //====================================
+    const std::string& getName() const override;
+    bool loadArguments() override;
+    void run(web::json::value& result) override;
+
+  private:
+    std::optional<lk::LogsFilter> _filter;
+};
+
+
+ActionGetLogs::ActionGetLogs(web::json::value& input, std::shared_ptr<rpc::BaseRpcService>& service)
+  : ActionJsonProcessBase(input, service)
+{}
+
+
+const std::string& ActionGetLogs::getName() const
+{
+    static const std::string name = "get_logs";
+    return name;
+}
+
+
+bool ActionGetLogs::loadArguments()
+{
+    _filter = deserializeLogsFilter(_input);
+    return _filter.has_value();
+}
+
+
+void ActionGetLogs::run(web::json::value& result)
+{
+    auto logs = _service->getLogs(_filter.value());
+    std::vector<web::json::value> logs_values;
+    for (const auto& record : logs) {
+        logs_values.emplace_back(serializeLogRecord(record));
+    }
+    result = web::json::value::array(logs_values);
+}
+
+
 template<typename T>
-web::json::value run_empty(std::shared_ptr<rpc::BaseRpc>& service)
+web::json::value run_empty(std::shared_ptr<rpc::BaseRpcService>& service)
 {
     T action(service);
     web::json::value result;
@@ -338,13 +509,9 @@ web::json::value run_empty(std::shared_ptr<rpc::BaseRpc>& service)
 
 
 template<typename T>
-web::json::value run_json_process(const web::http::http_request& message, std::shared_ptr<rpc::BaseRpc>& service)
+web::json::value run_json_process(const web::json::value& input, std::shared_ptr<rpc::BaseRpcService>& service)
 {
-    web::json::value request_json;
-    message.extract_json()
-      .then([&request_json](web::json::value request_body) { request_json = std::move(request_body); })
-      .wait();
-
+    web::json::value request_json{ input };
     T action(request_json, service);
     web::json::value result;
     result["method"] = web::json::value::string(action.getName());
@@ -374,17 +541,103 @@ web::json::value run_json_process(const web::http::http_request& message, std::s
 }
 
 
-void Adapter::init(std::shared_ptr<BaseRpc> service)
+namespace
+{
+
+web::json::value makeError(const std::string& method, const std::string& message)
+{
+    web::json::value result;
+    result["method"] = web::json::value::string(method);
+    result["status"] = web::json::value::string("error");
+    result["result"] = web::json::value::string(message);
+    return result;
+}
+
+
+template<typename F>
+web::json::value run_subscription_process(const std::string& method, F process)
+{
+    web::json::value result;
+    result["method"] = web::json::value::string(method);
+    try {
+        result["result"] = process();
+        result["status"] = web::json::value::string("ok");
+    }
+    catch (const std::exception& e) {
+        result["status"] = web::json::value::string("error");
+        result["result"] = web::json::value::string(e.what());
+    }
+    return result;
+}
+
+
+std::string getSubscriptionId(const web::json::value& input)
+{
+    if (!input.has_string_field("id")) {
+        RAISE_ERROR(base::InvalidArgument, "subscription id is not set");
+    }
+    return input.at("id").as_string();
+}
+
+
+web::json::value run_subscribe(SubscriptionTable& subscriptions,
+                               const web::json::value& input,
+                               std::shared_ptr<rpc::BaseRpcService>& service)
+{
+    return run_subscription_process("subscribe", [&] {
+        web::json::value result;
+        result["id"] = web::json::value::string(subscriptions.subscribe(*service, input));
+        return result;
+    });
+}
+
+
+// waits for events up to "timeout" milliseconds of input, capped by RPC_HTTP_MAX_POLL_TIME
+web::json::value run_poll_subscription(SubscriptionTable& subscriptions, const web::json::value& input)
+{
+    return run_subscription_process("poll_subscription", [&] {
+        std::chrono::milliseconds timeout{ base::config::RPC_HTTP_MAX_POLL_TIME };
+        if (input.has_number_field("timeout")) {
+            timeout = std::min(timeout, std::chrono::milliseconds{ input.at("timeout").as_number().to_uint64() });
+        }
+        return subscriptions.poll(getSubscriptionId(input), timeout);
+    });
+}
+
+
+web::json::value run_unsubscribe(SubscriptionTable& subscriptions, const web::json::value& input)
+{
+    return run_subscription_process("unsubscribe", [&] {
+        subscriptions.unsubscribe(getSubscriptionId(input));
+        return web::json::value::null();
+    });
+}
+
+} // namespace
+
+
+void Adapter::init(std::shared_ptr<BaseRpcService> service, std::size_t max_batch_size, std::size_t response_cache_size)
 {
     _service = std::move(service);
+    _max_batch_size = max_batch_size;
+    _responses_cache = std::make_unique<ResponseCache<std::string>>("http", response_cache_size);
 
     _empty_processors.insert({ "get_node_info", run_empty<ActionNodeInfo> });
+    _empty_processors.insert({ "get_vm_trace", run_empty<ActionGetVmTrace> });
 
     _json_processors.insert({ "get_account", run_json_process<ActionGetAccount> });
     _json_processors.insert({ "get_block", run_json_process<ActionGetBlock> });
     _json_processors.insert({ "get_transaction", run_json_process<ActionGetTransaction> });
     _json_processors.insert({ "get_transaction_status", run_json_process<ActionGetTransactionStatus> });
     _json_processors.insert({ "push_transaction", run_json_process<ActionPushTransaction> });
+    _json_processors.insert({ "call_contract_view", run_json_process<ActionCallContractView> });
+    _json_processors.insert({ "estimate_gas", run_json_process<ActionEstimateGas> });
+    _json_processors.insert({ "get_logs", run_json_process<ActionGetLogs> });
+
+    using namespace std::placeholders;
+    _json_processors.insert({ "subscribe", std::bind(run_subscribe, std::ref(_subscriptions), _1, _2) });
+    _json_processors.insert({ "poll_subscription", std::bind(run_poll_subscription, std::ref(_subscriptions), _1) });
+    _json_processors.insert({ "unsubscribe", std::bind(run_unsubscribe, std::ref(_subscriptions), _1) });
 }
 
 
@@ -395,33 +648,178 @@ void Adapter::handler(const web::http::http_request& message)
 
     if (paths.empty()) {
         LOG_ERROR << "no any route at request";
-        web::json::value result;
-        result["method"] = web::json::value::string("None");
-        result["status"] = web::json::value::string("error");
-        result["result"] = web::json::value::string("no any route at request");
-        message.reply(web::http::status_codes::BadGateway, result);
+        message.reply(web::http::status_codes::BadGateway, makeError("None", "no any route at request"));
+        return;
     }
 
     auto root_path = paths[0];
 
-    if (auto json_it = _json_processors.find(root_path); json_it != _json_processors.end()) {
-        auto reply_json = json_it->second(message, _service);
-        message.reply(web::http::status_codes::OK, reply_json);
-        return;
+    if (root_path == "batch") {
+        replyBatch(message);
     }
-    else if (auto empty_it = _empty_processors.find(root_path); empty_it != _empty_processors.end()) {
-        auto reply_json = empty_it->second(_service);
-        message.reply(web::http::status_codes::OK, reply_json);
-        return;
+    else if (_json_processors.find(root_path) != _json_processors.end()) {
+        // the reply is sent by a continuation, so the listener thread doesn't wait for the body
+        message.extract_json().then([this, message, root_path](pplx::task<web::json::value> body) {
+            web::json::value input;
+            try {
+                input = body.get();
+            }
+            catch (const std::exception& e) {
+                LOG_ERROR << "cannot read request body: " << e.what();
+            }
+            message.reply(web::http::status_codes::OK, processCall(root_path, input), "application/json");
+        });
+    }
+    else if (_empty_processors.find(root_path) != _empty_processors.end()) {
+        auto reply = processCall(root_path, web::json::value::null());
+        message.reply(web::http::status_codes::OK, reply, "application/json");
     }
     else {
-        web::json::value result;
-        result["method"] = web::json::value::string("None");
-        result["status"] = web::json::value::string("error");
-        result["result"] = web::json::value::string("no any processor was found");
-        message.reply(web::http::status_codes::BadGateway, result);
+        message.reply(web::http::status_codes::BadGateway, makeError("None", "no any processor was found"));
         LOG_ERROR << "no any processor wan found";
     }
 }
 
+
+std::string Adapter::processCall(const std::string& method, const web::json::value& params)
+{
+    auto cache_key = getCacheKey(method, params);
+    if (cache_key) {
+        if (auto cached = _responses_cache->find(*cache_key); cached) {
+            return *cached;
+        }
+    }
+
+    web::json::value reply;
+    if (auto json_it = _json_processors.find(method); json_it != _json_processors.end()) {
+        reply = json_it->second(params, _service);
+    }
+    else if (auto empty_it = _empty_processors.find(method); empty_it != _empty_processors.end()) {
+        reply = empty_it->second(_service);
+    }
+    else {
+        reply = makeError(method, "no any processor was found");
+    }
+
+    auto encoded = reply.serialize();
+    if (cache_key && isCacheable(params, reply)) {
+        _responses_cache->put(*cache_key, encoded, encoded.size());
+    }
+    return encoded;
+}
+
+
+// keys are built of the fields the actions read, so equal calls share a key whatever else is in params
+std::optional<std::string> Adapter::getCacheKey(const std::string& method, const web::json::value& params) const
+{
+    if (!params.is_object()) {
+        return std::nullopt;
+    }
+    if (method == "get_transaction" && params.has_string_field("hash")) {
+        return "get_transaction:" + params.at("hash").as_string();
+    }
+    if (method == "get_block") {
+        if (params.has_string_field("hash")) {
+            return "get_block:hash:" + params.at("hash").as_string();
+        }
+        if (!params.has_field("hash") && params.has_number_field("number") && params.at("number").is_integer()) {
+            return "get_block:number:" + std::to_string(params.at("number").as_number().to_uint64());
+        }
+    }
+    return std::nullopt;
+}
+
+
+// a block taken by number may be replaced by a fork, until enough blocks are above it
+bool Adapter::isCacheable(const web::json::value& params, const web::json::value& reply) const
+{
+    if (!reply.has_string_field("status") || reply.at("status").as_string() != "ok") {
+        return false;
+    }
+    if (params.has_field("hash")) {
+        return true;
+    }
+    auto number = params.at("number").as_number().to_uint64();
+    return number + base::config::RPC_CACHE_FINALIZATION_DEPTH <= _service->getNodeInfo().top_block_number;
+}
+
+
+pplx::task<std::string> Adapter::processBatch(const web::json::value& calls)
+{
+    if (!calls.is_array()) {
+        RAISE_ERROR(base::InvalidArgument, "batch must be an array of calls");
+    }
+    const auto& calls_array = calls.as_array();
+    if (calls_array.size() > _max_batch_size) {
+        RAISE_ERROR(base::InvalidArgument,
+                    "batch has " + std::to_string(calls_array.size()) + " calls, while at most " +
+                      std::to_string(_max_batch_size) + " are allowed");
+    }
+
+    std::vector<pplx::task<std::string>> results;
+    results.reserve(calls_array.size());
+    for (const auto& call : calls_array) {
+        results.push_back(pplx::create_task([this, call] { return processBatchCall(call); }));
+    }
+    // replies are already encoded, so they are joined as text instead of being parsed into an array
+    return pplx::when_all(results.begin(), results.end()).then([](std::vector<std::string> values) {
+        std::size_t total_size = 2 + values.size();
+        for (const auto& value : values) {
+            total_size += value.size();
+        }
+        std::string encoded;
+        encoded.reserve(total_size);
+        encoded += '[';
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            if (i != 0) {
+                encoded += ',';
+            }
+            encoded += values[i];
+        }
+        encoded += ']';
+        return encoded;
+    });
+}
+
+
+std::string Adapter::processBatchCall(const web::json::value& call)
+{
+    try {
+        if (!call.has_string_field("method")) {
+            return makeError("None", "call has no method").serialize();
+        }
+        const auto& method = call.at("method").as_string();
+        if (method == "batch") {
+            return makeError(method, "batches cannot be nested").serialize();
+        }
+        // a poll holds its thread for the whole timeout, so a few batches of them would take the whole pool
+        if (method == "subscribe" || method == "poll_subscription" || method == "unsubscribe") {
+            return makeError(method, "subscriptions are not allowed in a batch").serialize();
+        }
+        return processCall(method, call.has_field("params") ? call.at("params") : web::json::value::object());
+    }
+    catch (const std::exception& e) {
+        return makeError("None", e.what()).serialize();
+    }
+}
+
+
+void Adapter::replyBatch(const web::http::http_request& message)
+{
+    message.extract_json()
+      .then([this](web::json::value calls) { return processBatch(calls); })
+      .then([message, max_batch_size = _max_batch_size](pplx::task<std::string> results) {
+          try {
+              message.reply(web::http::status_codes::OK, results.get(), "application/json");
+          }
+          catch (const std::exception& e) {
+              LOG_ERROR << "batch failed: " << e.what();
+              // the limit is set by the node config, so a client learns it here and splits its calls accordingly
+              auto error = makeError("batch", e.what());
+              error["max_batch_size"] = web::json::value::number(static_cast<std::uint64_t>(max_batch_size));
+              message.reply(web::http::status_codes::OK, error);
+          }
+      });
+}
+
 }
\ No newline at end of file
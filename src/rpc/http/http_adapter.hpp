@@ -1,9 +1,15 @@
 #pragma once
 
 #include "rpc/base_rpc.hpp"
+#include "rpc/http/http_subscriptions.hpp"
+#include "rpc/response_cache.hpp"
+
+#include "base/config.hpp"
 
 #include <cpprest/http_listener.h>
 
+#include <optional>
+
 namespace rpc::http
 {
 
@@ -14,19 +20,42 @@ class Adapter final
 
     ~Adapter() = default;
 
-    void init(std::shared_ptr<BaseRpc> service);
+    void init(std::shared_ptr<BaseRpcService> service,
+              std::size_t max_batch_size = base::config::RPC_HTTP_MAX_BATCH_SIZE,
+              std::size_t response_cache_size = base::config::RPC_RESPONSE_CACHE_SIZE);
 
     void handler(const web::http::http_request& message);
 
+    // runs a method the same way as a request to /<method> with params at body does, returns the encoded reply.
+    // Replies with blocks and transactions, which never change, are taken from the cache once encoded
+    std::string processCall(const std::string& method, const web::json::value& params);
+
+    /**
+     *  @brief Runs calls of a batch concurrently, results are in the order of calls.
+     *
+     *  Each call is an object with "method" and optional "params" fields, a failed call doesn't fail others.
+     *  @return encoded array of replies.
+     *  @throws base::InvalidArgument if calls is not an array or it has more calls than the batch size limit.
+     */
+    pplx::task<std::string> processBatch(const web::json::value& calls);
+
   private:
-    std::shared_ptr<BaseRpc> _service;
+    std::shared_ptr<BaseRpcService> _service;
+    std::size_t _max_batch_size{ base::config::RPC_HTTP_MAX_BATCH_SIZE };
+    SubscriptionTable _subscriptions;
+    std::unique_ptr<ResponseCache<std::string>> _responses_cache;
 
     using JsonProcessorFn =
-      std::function<web::json::value(const web::http::http_request& message, std::shared_ptr<rpc::BaseRpc>&)>;
+      std::function<web::json::value(const web::json::value&, std::shared_ptr<rpc::BaseRpcService>&)>;
     std::map<std::string, JsonProcessorFn> _json_processors;
 
-    using EmptyProcessorFn = std::function<web::json::value(std::shared_ptr<rpc::BaseRpc>&)>;
+    using EmptyProcessorFn = std::function<web::json::value(std::shared_ptr<rpc::BaseRpcService>&)>;
     std::map<std::string, EmptyProcessorFn> _empty_processors;
+
+    std::optional<std::string> getCacheKey(const std::string& method, const web::json::value& params) const;
+    bool isCacheable(const web::json::value& params, const web::json::value& reply) const;
+    std::string processBatchCall(const web::json::value& call);
+    void replyBatch(const web::http::http_request& message);
 };
 
 }
\ No newline at end of file
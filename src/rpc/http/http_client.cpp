@@ -3,6 +3,9 @@
 #include "rpc/error.hpp"
 #include "rpc/http/tools.hpp"
 
+#include "base/config.hpp"
+
+#include <algorithm>
 #include <optional>
 
 namespace
@@ -20,6 +23,15 @@ web::http::http_request createPostRequest(const std::string& url, const web::jso
     return request_post;
 }
 
+
+web::json::value createCall(const std::string& method, web::json::value params)
+{
+    web::json::value call;
+    call["method"] = web::json::value::string(method);
+    call["params"] = std::move(params);
+    return call;
+}
+
 }
 
 
@@ -28,6 +40,7 @@ namespace rpc::http
 
 NodeClient::NodeClient(const std::string& connect_address)
   : _client{ "http://" + U(connect_address) }
+  , _max_batch_size{ base::config::RPC_HTTP_MAX_BATCH_SIZE }
 {}
 
 
@@ -286,4 +299,304 @@ lk::TransactionStatus NodeClient::getTransactionStatus(const base::Sha256& trans
     }
 }
 
+
+lk::ViewCallResult NodeClient::callContractView(const lk::Transaction& call)
+{
+    web::json::value request_body = serializeTransaction(call);
+
+    std::optional<lk::ViewCallResult> opt_result;
+
+    _client.request(createPostRequest("/call_contract_view", request_body))
+      .then([&](const web::http::http_response& response) {
+          response.extract_json()
+            .then([&](web::json::value request_body) {
+                if (request_body.at("status").as_string() == "ok") {
+                    opt_result = deserializeViewCallResult(request_body.at("result"));
+                }
+                else {
+                    if (request_body.has_field("result")) {
+                        LOG_ERROR << "bad request result:" << request_body.at("result").serialize();
+                    }
+                    else {
+                        LOG_ERROR << "bad request result";
+                    }
+                    RAISE_ERROR(RpcError, "bad result status");
+                }
+            })
+            .wait();
+      })
+      .wait();
+    if (opt_result) {
+        return opt_result.value();
+    }
+    else {
+        RAISE_ERROR(base::InvalidArgument, "deserialization error");
+    }
+}
+
+
+std::uint64_t NodeClient::estimateGas(const lk::Transaction& tx)
+{
+    web::json::value request_body = serializeTransaction(tx);
+
+    std::optional<std::uint64_t> opt_gas;
+
+    _client.request(createPostRequest("/estimate_gas", request_body))
+      .then([&](const web::http::http_response& response) {
+          response.extract_json()
+            .then([&](web::json::value request_body) {
+                if (request_body.at("status").as_string() == "ok") {
+                    opt_gas = deserializeFee(request_body.at("result").as_string());
+                }
+                else {
+                    if (request_body.has_field("result")) {
+                        LOG_ERROR << "bad request result:" << request_body.at("result").serialize();
+                    }
+                    else {
+                        LOG_ERROR << "bad request result";
+                    }
+                    RAISE_ERROR(RpcError, "bad result status");
+                }
+            })
+            .wait();
+      })
+      .wait();
+    if (opt_gas) {
+        return opt_gas.value();
+    }
+    else {
+        RAISE_ERROR(base::InvalidArgument, "deserialization error");
+    }
+}
+
+
+std::vector<lk::LogRecord> NodeClient::getLogs(const lk::LogsFilter& filter)
+{
+    web::json::value request_body = serializeLogsFilter(filter);
+
+    std::optional<std::vector<lk::LogRecord>> opt_logs;
+
+    _client.request(createPostRequest("/get_logs", request_body))
+      .then([&](const web::http::http_response& response) {
+          response.extract_json()
+            .then([&](web::json::value request_body) {
+                if (request_body.at("status").as_string() == "ok") {
+                    std::vector<lk::LogRecord> logs;
+                    for (const auto& record_value : request_body.at("result").as_array()) {
+                        auto record = deserializeLogRecord(record_value);
+                        if (!record) {
+                            return;
+                        }
+                        logs.push_back(std::move(record.value()));
+                    }
+                    opt_logs = std::move(logs);
+                }
+                else {
+                    if (request_body.has_field("result")) {
+                        LOG_ERROR << "bad request result:" << request_body.at("result").serialize();
+                    }
+                    else {
+                        LOG_ERROR << "bad request result";
+                    }
+                    RAISE_ERROR(RpcError, "bad result status");
+                }
+            })
+            .wait();
+      })
+      .wait();
+    if (opt_logs) {
+        return opt_logs.value();
+    }
+    else {
+        RAISE_ERROR(base::InvalidArgument, "deserialization error");
+    }
+}
+
+
+std::vector<lk::ContractTrace> NodeClient::getVmTraces()
+{
+    web::json::value request_body;
+
+    std::optional<std::vector<lk::ContractTrace>> opt_traces;
+
+    _client.request(createPostRequest("/get_vm_trace", request_body))
+      .then([&](const web::http::http_response& response) {
+          response.extract_json()
+            .then([&](web::json::value request_body) {
+                if (request_body.at("status").as_string() == "ok") {
+                    std::vector<lk::ContractTrace> traces;
+                    for (const auto& trace_value : request_body.at("result").as_array()) {
+                        auto trace = deserializeContractTrace(trace_value);
+                        if (!trace) {
+                            return;
+                        }
+                        traces.push_back(std::move(trace.value()));
+                    }
+                    opt_traces = std::move(traces);
+                }
+                else {
+                    if (request_body.has_field("result")) {
+                        LOG_ERROR << "bad request result:" << request_body.at("result").serialize();
+                    }
+                    else {
+                        LOG_ERROR << "bad request result";
+                    }
+                    RAISE_ERROR(RpcError, "bad result status");
+                }
+            })
+            .wait();
+      })
+      .wait();
+    if (opt_traces) {
+        return opt_traces.value();
+    }
+    else {
+        RAISE_ERROR(base::InvalidArgument, "deserialization error");
+    }
+}
+
+
+std::vector<lk::ImmutableBlock> NodeClient::getBlocks(uint64_t from_number, std::size_t count)
+{
+    if (count > base::config::RPC_MAX_ITEMS_IN_REQUEST) {
+        RAISE_ERROR(base::InvalidArgument,
+                    "at most " + std::to_string(base::config::RPC_MAX_ITEMS_IN_REQUEST) + " blocks can be requested");
+    }
+
+    // the top block is unknown here, so it is asked for to not request blocks that don't exist
+    auto top_block_number = getNodeInfo().top_block_number;
+    std::vector<web::json::value> calls;
+    for (auto number = from_number; number <= top_block_number && number - from_number < count; ++number) {
+        web::json::value params;
+        params["number"] = web::json::value::number(number);
+        calls.push_back(createCall("get_block", std::move(params)));
+    }
+
+    std::vector<lk::ImmutableBlock> blocks;
+    blocks.reserve(calls.size());
+    for (const auto& result : requestBatch(calls)) {
+        auto block = deserializeBlock(result);
+        if (!block) {
+            RAISE_ERROR(base::InvalidArgument, "deserialization error");
+        }
+        blocks.push_back(std::move(block.value()));
+    }
+    return blocks;
+}
+
+
+std::vector<lk::Transaction> NodeClient::getTransactions(const std::vector<base::Sha256>& transactions_hashes)
+{
+    if (transactions_hashes.size() > base::config::RPC_MAX_ITEMS_IN_REQUEST) {
+        RAISE_ERROR(base::InvalidArgument,
+                    "at most " + std::to_string(base::config::RPC_MAX_ITEMS_IN_REQUEST) +
+                      " transactions can be requested");
+    }
+
+    std::vector<web::json::value> calls;
+    calls.reserve(transactions_hashes.size());
+    for (const auto& hash : transactions_hashes) {
+        web::json::value params;
+        params["hash"] = serializeHash(hash);
+        calls.push_back(createCall("get_transaction", std::move(params)));
+    }
+
+    std::vector<lk::Transaction> txs;
+    txs.reserve(calls.size());
+    for (const auto& result : requestBatch(calls)) {
+        auto tx = deserializeTransaction(result);
+        if (!tx) {
+            RAISE_ERROR(base::InvalidArgument, "deserialization error");
+        }
+        txs.push_back(std::move(tx.value()));
+    }
+    return txs;
+}
+
+
+std::vector<lk::TransactionStatus> NodeClient::pushTransactions(const std::vector<lk::Transaction>& transactions)
+{
+    if (transactions.size() > base::config::RPC_MAX_ITEMS_IN_REQUEST) {
+        RAISE_ERROR(base::InvalidArgument,
+                    "at most " + std::to_string(base::config::RPC_MAX_ITEMS_IN_REQUEST) +
+                      " transactions can be pushed");
+    }
+
+    std::vector<web::json::value> calls;
+    calls.reserve(transactions.size());
+    for (const auto& tx : transactions) {
+        calls.push_back(createCall("push_transaction", serializeTransaction(tx)));
+    }
+
+    std::vector<lk::TransactionStatus> statuses;
+    statuses.reserve(calls.size());
+    for (const auto& result : requestBatch(calls)) {
+        auto status = deserializeTransactionStatus(result);
+        if (!status) {
+            RAISE_ERROR(base::InvalidArgument, "deserialization error");
+        }
+        statuses.push_back(std::move(status.value()));
+    }
+    return statuses;
+}
+
+
+std::vector<web::json::value> NodeClient::requestBatch(const std::vector<web::json::value>& calls)
+{
+    std::vector<web::json::value> results;
+    results.reserve(calls.size());
+
+    for (std::size_t begin = 0; begin < calls.size();) {
+        auto end = std::min(calls.size(), begin + _max_batch_size);
+        auto request_body =
+          web::json::value::array(std::vector<web::json::value>(calls.begin() + begin, calls.begin() + end));
+
+        bool is_too_large = false;
+        _client.request(createPostRequest("/batch", request_body))
+          .then([&](const web::http::http_response& response) {
+              response.extract_json()
+                .then([&](web::json::value response_body) {
+                    if (!response_body.is_array()) {
+                        // a node configured with a smaller limit rejects the part, which is resent split further
+                        if (response_body.has_field("max_batch_size")) {
+                            auto node_max_batch_size = response_body.at("max_batch_size").as_number().to_uint64();
+                            if (node_max_batch_size > 0 && node_max_batch_size < end - begin) {
+                                _max_batch_size = node_max_batch_size;
+                                is_too_large = true;
+                                return;
+                            }
+                        }
+                        if (response_body.has_field("result")) {
+                            LOG_ERROR << "bad batch result:" << response_body.at("result").serialize();
+                        }
+                        RAISE_ERROR(RpcError, "bad batch result");
+                    }
+                    for (const auto& call_result : response_body.as_array()) {
+                        if (call_result.at("status").as_string() != "ok") {
+                            if (call_result.has_field("result")) {
+                                LOG_ERROR << "bad request result:" << call_result.at("result").serialize();
+                            }
+                            else {
+                                LOG_ERROR << "bad request result";
+                            }
+                            RAISE_ERROR(RpcError, "bad result status");
+                        }
+                        results.push_back(call_result.at("result"));
+                    }
+                })
+                .wait();
+          })
+          .wait();
+
+        if (!is_too_large) {
+            begin = end;
+        }
+    }
+
+    if (results.size() != calls.size()) {
+        RAISE_ERROR(RpcError, "batch has a wrong number of results");
+    }
+    return results;
+}
+
 } // namespace rpc
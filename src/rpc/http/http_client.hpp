@@ -31,8 +31,27 @@ class NodeClient final : public BaseRpc
 
     lk::TransactionStatus getTransactionStatus(const base::Sha256& transaction_hash) override;
 
+    lk::ViewCallResult callContractView(const lk::Transaction& call) override;
+
+    std::uint64_t estimateGas(const lk::Transaction& tx) override;
+
+    std::vector<lk::LogRecord> getLogs(const lk::LogsFilter& filter) override;
+
+    std::vector<lk::ContractTrace> getVmTraces() override;
+
+    std::vector<lk::ImmutableBlock> getBlocks(uint64_t from_number, std::size_t count) override;
+
+    std::vector<lk::Transaction> getTransactions(const std::vector<base::Sha256>& transactions_hashes) override;
+
+    std::vector<lk::TransactionStatus> pushTransactions(const std::vector<lk::Transaction>& transactions) override;
+
   private:
     web::http::client::http_client _client;
+    // calls sent in one batch, lowered to the limit of the node when it rejects a larger batch
+    std::size_t _max_batch_size;
+
+    // sends calls to /batch, split in parts the node accepts, and returns results of the calls
+    std::vector<web::json::value> requestBatch(const std::vector<web::json::value>& calls);
 };
 
 } // namespace rpc
@@ -3,10 +3,13 @@
 namespace rpc::http
 {
 
-NodeServer::NodeServer(const std::string& server_address, std::shared_ptr<BaseRpc> service)
+NodeServer::NodeServer(const std::string& server_address,
+                       std::shared_ptr<BaseRpcService> service,
+                       std::size_t max_batch_size,
+                       std::size_t response_cache_size)
   : _listener(server_address)
 {
-    _service.init(std::move(service));
+    _service.init(std::move(service), max_batch_size, response_cache_size);
     _listener.support(web::http::methods::POST, std::bind(&Adapter::handler, &_service, std::placeholders::_1));
 }
 
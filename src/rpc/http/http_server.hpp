@@ -13,7 +13,12 @@ class NodeServer final : public BaseRpcServer
   public:
     /// Constructor that initialize instance of LogicService
     /// \param server_address listening ip:port
-    NodeServer(const std::string& server_address, std::shared_ptr<BaseRpc> service);
+    /// \param max_batch_size limit of calls in a request to /batch
+    /// \param response_cache_size bytes of encoded replies with blocks and transactions kept for repeated calls
+    NodeServer(const std::string& server_address,
+               std::shared_ptr<BaseRpcService> service,
+               std::size_t max_batch_size,
+               std::size_t response_cache_size);
 
     /// plain destructor that call GrpcNodeServer::stop()
     ~NodeServer() override;
@@ -0,0 +1,182 @@
+#include "http_subscriptions.hpp"
+
+#include "rpc/http/tools.hpp"
+
+#include "base/bytes.hpp"
+#include "base/config.hpp"
+#include "base/error.hpp"
+#include "base/log.hpp"
+
+#include <openssl/rand.h>
+
+namespace rpc::http
+{
+
+namespace
+{
+
+template<typename Event, typename SerializeFn>
+std::function<web::json::value(std::chrono::milliseconds)> makePoll(std::shared_ptr<Subscription<Event>> subscription,
+                                                                    SerializeFn serialize)
+{
+    return [subscription, serialize](std::chrono::milliseconds timeout) {
+        std::vector<web::json::value> values;
+        for (const auto& event : subscription->popAll(timeout)) {
+            values.push_back(serialize(event));
+        }
+        return web::json::value::array(std::move(values));
+    };
+}
+
+
+template<typename Event>
+std::function<bool()> makeIsOverflowed(std::shared_ptr<Subscription<Event>> subscription)
+{
+    return [subscription] { return subscription->isOverflowed(); };
+}
+
+
+std::vector<base::Sha256> deserializeHashes(const web::json::value& input)
+{
+    std::vector<base::Sha256> hashes;
+    if (!input.has_field("hashes")) {
+        return hashes;
+    }
+    for (const auto& hash_value : input.at("hashes").as_array()) {
+        auto hash = deserializeHash(hash_value.as_string());
+        if (!hash) {
+            RAISE_ERROR(base::InvalidArgument, "invalid transaction hash");
+        }
+        hashes.push_back(std::move(hash.value()));
+    }
+    return hashes;
+}
+
+
+// ids are taken from a cryptographically safe generator, so they can't be guessed by other clients
+std::string generateSubscriptionId()
+{
+    base::FixedBytes<16> id;
+    if (RAND_bytes(id.getData(), static_cast<int>(id.size())) != 1) {
+        RAISE_ERROR(base::CryptoError, "failed to generate subscription id");
+    }
+    return base::toHex(id);
+}
+
+} // namespace
+
+
+std::string SubscriptionTable::subscribe(BaseRpcService& service, const web::json::value& input)
+{
+    if (!input.has_string_field("events")) {
+        RAISE_ERROR(base::InvalidArgument, "kind of events is not set");
+    }
+    const auto& events = input.at("events").as_string();
+
+    auto entry = std::make_shared<Entry>();
+    if (events == "blocks") {
+        auto subscription = service.subscribeToBlocks();
+        entry->poll = makePoll(subscription, [](const lk::ImmutableBlock& block) { return serializeBlock(block); });
+        entry->is_overflowed = makeIsOverflowed(subscription);
+    }
+    else if (events == "pending_transactions") {
+        auto subscription = service.subscribeToPendingTransactions();
+        entry->poll = makePoll(subscription, [](const lk::Transaction& tx) { return serializeTransaction(tx); });
+        entry->is_overflowed = makeIsOverflowed(subscription);
+    }
+    else if (events == "transaction_statuses") {
+        auto subscription = service.subscribeToTransactionStatuses(deserializeHashes(input));
+        entry->poll = makePoll(subscription, [](const TransactionStatusUpdate& update) {
+            return serializeTransactionStatusUpdate(update);
+        });
+        entry->is_overflowed = makeIsOverflowed(subscription);
+    }
+    else {
+        RAISE_ERROR(base::InvalidArgument, "unknown kind of events: " + events);
+    }
+    entry->last_poll_time = std::chrono::steady_clock::now();
+
+    std::lock_guard lk(_entries_mutex);
+    dropExpired();
+    if (_entries.size() >= base::config::RPC_HTTP_MAX_SUBSCRIPTIONS) {
+        RAISE_ERROR(base::InvalidArgument, "too many subscriptions");
+    }
+    auto id = generateSubscriptionId();
+    if (!_entries.insert({ id, std::move(entry) }).second) {
+        RAISE_ERROR(base::LogicError, "subscription id collision");
+    }
+    return id;
+}
+
+
+web::json::value SubscriptionTable::poll(const std::string& id, std::chrono::milliseconds timeout)
+{
+    std::shared_ptr<Entry> entry;
+    {
+        std::lock_guard lk(_entries_mutex);
+        dropExpired();
+        if (auto it = _entries.find(id); it != _entries.end()) {
+            entry = it->second;
+        }
+        else {
+            RAISE_ERROR(base::InvalidArgument, "no subscription with id " + id);
+        }
+        if (entry->is_polled) {
+            RAISE_ERROR(base::InvalidArgument, "subscription is already being polled");
+        }
+        if (_polls_in_progress >= base::config::RPC_HTTP_MAX_POLLS_IN_PROGRESS) {
+            RAISE_ERROR(base::InvalidArgument, "too many polls in progress");
+        }
+        entry->last_poll_time = std::chrono::steady_clock::now();
+        entry->is_polled = true;
+        ++_polls_in_progress;
+    }
+
+    // the mutex is not held while waiting, so polls of other subscriptions are not blocked
+    web::json::value events;
+    try {
+        events = entry->poll(timeout);
+    }
+    catch (...) {
+        std::lock_guard lk(_entries_mutex);
+        entry->is_polled = false;
+        --_polls_in_progress;
+        throw;
+    }
+
+    std::lock_guard lk(_entries_mutex);
+    entry->is_polled = false;
+    --_polls_in_progress;
+    entry->last_poll_time = std::chrono::steady_clock::now();
+    if (entry->is_overflowed()) {
+        _entries.erase(id);
+        LOG_DEBUG << "http subscription " << id << " was dropped";
+        RAISE_ERROR(base::InvalidArgument, "subscription was dropped, since events were not polled in time");
+    }
+    return events;
+}
+
+
+void SubscriptionTable::unsubscribe(const std::string& id)
+{
+    std::lock_guard lk(_entries_mutex);
+    _entries.erase(id);
+}
+
+
+void SubscriptionTable::dropExpired()
+{
+    const auto now = std::chrono::steady_clock::now();
+    const std::chrono::milliseconds ttl{ base::config::RPC_HTTP_SUBSCRIPTION_TTL };
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        if (!it->second->is_polled && now - it->second->last_poll_time > ttl) {
+            LOG_DEBUG << "http subscription " << it->first << " expired";
+            it = _entries.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+} // namespace rpc::http
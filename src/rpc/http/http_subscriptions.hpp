@@ -0,0 +1,69 @@
+#pragma once
+
+#include "rpc/base_rpc.hpp"
+
+#include <cpprest/json.h>
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace rpc::http
+{
+
+/**
+ *  @brief Subscriptions of http clients, which take events by long polling.
+ *
+ *  A subscription is dropped if it overflows, if it isn't polled for RPC_HTTP_SUBSCRIPTION_TTL
+ *  or if it is unsubscribed. At most RPC_HTTP_MAX_SUBSCRIPTIONS exist at once.
+ *  A waiting poll takes a thread of the http listener, so a subscription is polled by one call at a time
+ *  and at most RPC_HTTP_MAX_POLLS_IN_PROGRESS polls wait at once.
+ *  Ids are 128 random bits, so a client can't guess ids of subscriptions of other clients.
+ *
+ *  @threadsafe
+ */
+class SubscriptionTable
+{
+  public:
+    /**
+     *  @brief Creates a subscription to events of kind given by "events" field of input.
+     *
+     *  "events" is one of "blocks", "pending_transactions" or "transaction_statuses", the latter
+     *  takes optional "hashes" of transactions to watch.
+     *  @return id of the subscription, hex encoded.
+     *  @throws base::InvalidArgument if the input is wrong or there are too many subscriptions.
+     */
+    std::string subscribe(BaseRpcService& service, const web::json::value& input);
+
+    /**
+     *  @brief Waits up to timeout for the first event and takes all queued ones.
+     *
+     *  @return json array of events, serialized as results of the methods returning the same objects.
+     *  @throws base::InvalidArgument if there is no such subscription, it was dropped as overflowed,
+     *          it is already being polled or too many polls are in progress.
+     */
+    web::json::value poll(const std::string& id, std::chrono::milliseconds timeout);
+
+    void unsubscribe(const std::string& id);
+
+  private:
+    struct Entry
+    {
+        std::function<web::json::value(std::chrono::milliseconds)> poll;
+        std::function<bool()> is_overflowed;
+        std::chrono::steady_clock::time_point last_poll_time;
+        bool is_polled{ false };
+    };
+
+    std::mutex _entries_mutex;
+    std::map<std::string, std::shared_ptr<Entry>> _entries;
+    std::size_t _polls_in_progress{ 0 };
+
+    // must be called with _entries_mutex locked
+    void dropExpired();
+};
+
+} // namespace rpc::http
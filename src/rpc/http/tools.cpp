@@ -156,17 +156,8 @@ web::json::value serializeAddress(const lk::Address& address)
 
 std::optional<lk::Address> deserializeAddress(const std::string& address_str)
 {
-    base::Bytes decoded_bytes;
     try {
-        decoded_bytes = base::base58Decode(address_str);
-    }
-    catch (const base::Error& e) {
-        LOG_ERROR << "Failed to deserialize address data";
-        return std::nullopt;
-    }
-
-    try {
-        return lk::Address{ decoded_bytes };
+        return lk::Address{ base::base58Decode<lk::Address::LENGTH_IN_BYTES>(address_str) };
     }
     catch (const base::Error& e) {
         LOG_ERROR << "Failed to deserialize address";
@@ -606,6 +597,234 @@ std::optional<lk::ImmutableBlock> deserializeBlock(const web::json::value& input
 }
 
 
+web::json::value serializeLogTopic(const lk::LogTopic& topic)
+{
+    return web::json::value::string(base::base64Encode(topic));
+}
+
+
+std::optional<lk::LogTopic> deserializeLogTopic(const std::string& data)
+{
+    auto topic_data = deserializeBytes(data);
+    if (!topic_data) {
+        LOG_ERROR << "bad topic format";
+        return std::nullopt;
+    }
+    try {
+        return lk::LogTopic(topic_data.value());
+    }
+    catch (const base::Error& e) {
+        LOG_ERROR << "Failed to deserialize topic";
+        return std::nullopt;
+    }
+}
+
+
+web::json::value serializeEventLog(const lk::EventLog& log)
+{
+    web::json::value result;
+    result["address"] = serializeAddress(log.address);
+    std::vector<web::json::value> topics_values;
+    for (const auto& topic : log.topics) {
+        topics_values.emplace_back(serializeLogTopic(topic));
+    }
+    result["topics"] = web::json::value::array(topics_values);
+    result["data"] = serializeBytes(log.data);
+    return result;
+}
+
+
+std::optional<lk::EventLog> deserializeEventLog(const web::json::value& input)
+{
+    try {
+        if (!input.has_string_field("address") || !input.has_array_field("topics") ||
+            !input.has_string_field("data")) {
+            LOG_ERROR << "log fields are not exist";
+            return std::nullopt;
+        }
+        auto address = deserializeAddress(input.at("address").as_string());
+        auto data = deserializeBytes(input.at("data").as_string());
+        if (!address || !data) {
+            LOG_ERROR << "error at log deserialization";
+            return std::nullopt;
+        }
+
+        lk::EventLog log{ address.value(), {}, data.value() };
+        for (const auto& topic_value : input.at("topics").as_array()) {
+            auto topic = deserializeLogTopic(topic_value.as_string());
+            if (!topic) {
+                return std::nullopt;
+            }
+            log.topics.push_back(topic.value());
+        }
+        return log;
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "Failed to deserialize EventLog";
+        return std::nullopt;
+    }
+}
+
+
+web::json::value serializeLogRecord(const lk::LogRecord& record)
+{
+    web::json::value result;
+    result["block_depth"] = web::json::value::number(record.block_depth);
+    result["transaction_hash"] = serializeHash(record.transaction_hash);
+    result["log"] = serializeEventLog(record.log);
+    return result;
+}
+
+
+std::optional<lk::LogRecord> deserializeLogRecord(const web::json::value& input)
+{
+    try {
+        if (!input.has_number_field("block_depth") || !input.has_string_field("transaction_hash") ||
+            !input.has_object_field("log")) {
+            LOG_ERROR << "log record fields are not exist";
+            return std::nullopt;
+        }
+        auto transaction_hash = deserializeHash(input.at("transaction_hash").as_string());
+        auto log = deserializeEventLog(input.at("log"));
+        if (!transaction_hash || !log) {
+            LOG_ERROR << "error at log record deserialization";
+            return std::nullopt;
+        }
+        return lk::LogRecord{ input.at("block_depth").as_number().to_uint64(), transaction_hash.value(), log.value() };
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "Failed to deserialize LogRecord";
+        return std::nullopt;
+    }
+}
+
+
+web::json::value serializeLogsFilter(const lk::LogsFilter& filter)
+{
+    web::json::value result;
+    result["from_depth"] = web::json::value::number(filter.from_depth);
+    result["to_depth"] = web::json::value::number(filter.to_depth);
+    if (filter.address) {
+        result["address"] = serializeAddress(filter.address.value());
+    }
+    std::vector<web::json::value> topics_values;
+    for (const auto& topic : filter.topics) {
+        topics_values.emplace_back(topic ? serializeLogTopic(*topic) : web::json::value::null());
+    }
+    result["topics"] = web::json::value::array(topics_values);
+    return result;
+}
+
+
+std::optional<lk::LogsFilter> deserializeLogsFilter(const web::json::value& input)
+{
+    try {
+        lk::LogsFilter filter;
+        if (input.has_number_field("from_depth") && input.has_number_field("to_depth")) {
+            filter.from_depth = input.at("from_depth").as_number().to_uint64();
+            filter.to_depth = input.at("to_depth").as_number().to_uint64();
+        }
+        else {
+            LOG_ERROR << "from_depth or to_depth field is not exists";
+            return std::nullopt;
+        }
+        if (input.has_string_field("address")) {
+            filter.address = deserializeAddress(input.at("address").as_string());
+            if (!filter.address) {
+                return std::nullopt;
+            }
+        }
+        if (input.has_array_field("topics")) {
+            for (const auto& topic_value : input.at("topics").as_array()) {
+                if (topic_value.is_null()) { // any topic at this position
+                    filter.topics.emplace_back(std::nullopt);
+                    continue;
+                }
+                auto topic = deserializeLogTopic(topic_value.as_string());
+                if (!topic) {
+                    return std::nullopt;
+                }
+                filter.topics.emplace_back(topic.value());
+            }
+        }
+        return filter;
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "Failed to deserialize LogsFilter";
+        return std::nullopt;
+    }
+}
+
+
+web::json::value serializeContractTrace(const lk::ContractTrace& trace)
+{
+    web::json::value result;
+    result["address"] = serializeAddress(trace.address);
+    result["calls"] = web::json::value::number(trace.calls);
+    result["failed_calls"] = web::json::value::number(trace.failed_calls);
+    result["gas_used"] = web::json::value::number(trace.gas_used);
+    result["total_time_ns"] = web::json::value::number(static_cast<std::uint64_t>(trace.total_time.count()));
+    result["own_time_ns"] = web::json::value::number(static_cast<std::uint64_t>(trace.own_time.count()));
+    result["max_call_time_ns"] = web::json::value::number(static_cast<std::uint64_t>(trace.max_call_time.count()));
+    result["max_depth"] = web::json::value::number(trace.max_depth);
+    result["storage_reads"] = web::json::value::number(trace.host_calls.storage_reads);
+    result["storage_writes"] = web::json::value::number(trace.host_calls.storage_writes);
+    result["balance_reads"] = web::json::value::number(trace.host_calls.balance_reads);
+    result["code_reads"] = web::json::value::number(trace.host_calls.code_reads);
+    result["nested_calls"] = web::json::value::number(trace.host_calls.calls);
+    result["logs"] = web::json::value::number(trace.host_calls.logs);
+    return result;
+}
+
+
+std::optional<lk::ContractTrace> deserializeContractTrace(const web::json::value& input)
+{
+    static const std::vector<std::string> NUMBER_FIELDS{
+        "calls",         "failed_calls",  "gas_used",       "total_time_ns", "own_time_ns",  "max_call_time_ns",
+        "max_depth",     "storage_reads", "storage_writes", "balance_reads", "code_reads",   "nested_calls",
+        "logs"
+    };
+    try {
+        if (!input.has_string_field("address")) {
+            LOG_ERROR << "address field is not exists";
+            return std::nullopt;
+        }
+        for (const auto& field : NUMBER_FIELDS) {
+            if (!input.has_number_field(field)) {
+                LOG_ERROR << field << " field is not exists";
+                return std::nullopt;
+            }
+        }
+        auto address = deserializeAddress(input.at("address").as_string());
+        if (!address) {
+            return std::nullopt;
+        }
+        auto number = [&input](const std::string& field) { return input.at(field).as_number().to_uint64(); };
+
+        lk::ContractTrace trace;
+        trace.address = address.value();
+        trace.calls = number("calls");
+        trace.failed_calls = number("failed_calls");
+        trace.gas_used = number("gas_used");
+        trace.total_time = std::chrono::nanoseconds(number("total_time_ns"));
+        trace.own_time = std::chrono::nanoseconds(number("own_time_ns"));
+        trace.max_call_time = std::chrono::nanoseconds(number("max_call_time_ns"));
+        trace.max_depth = static_cast<std::uint32_t>(number("max_depth"));
+        trace.host_calls.storage_reads = number("storage_reads");
+        trace.host_calls.storage_writes = number("storage_writes");
+        trace.host_calls.balance_reads = number("balance_reads");
+        trace.host_calls.code_reads = number("code_reads");
+        trace.host_calls.calls = number("nested_calls");
+        trace.host_calls.logs = number("logs");
+        return trace;
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "Failed to deserialize ContractTrace";
+        return std::nullopt;
+    }
+}
+
+
 web::json::value serializeTransactionStatus(const lk::TransactionStatus& status)
 {
     web::json::value result;
@@ -613,6 +832,11 @@ web::json::value serializeTransactionStatus(const lk::TransactionStatus& status)
     result["action_type"] = serializeTransactionStatusActionType(status.getType());
     result["fee_left"] = serializeFee(status.getFeeLeft());
     result["message"] = web::json::value::string(status.getMessage());
+    std::vector<web::json::value> logs_values;
+    for (const auto& log : status.getLogs()) {
+        logs_values.emplace_back(serializeEventLog(log));
+    }
+    result["logs"] = web::json::value::array(logs_values);
     return result;
 }
 
@@ -669,7 +893,20 @@ std::optional<lk::TransactionStatus> deserializeTransactionStatus(const web::jso
             LOG_ERROR << "error at message deserialization";
             return std::nullopt;
         }
-        return lk::TransactionStatus{ status_code.value(), action_type.value(), fee.value(), message.value() };
+        std::vector<lk::EventLog> logs;
+        if (input.has_array_field("logs")) { // absent in answers of older nodes
+            for (const auto& log_value : input.at("logs").as_array()) {
+                auto log = deserializeEventLog(log_value);
+                if (!log) {
+                    LOG_ERROR << "error at logs deserialization";
+                    return std::nullopt;
+                }
+                logs.push_back(std::move(log.value()));
+            }
+        }
+        return lk::TransactionStatus{
+            status_code.value(), action_type.value(), fee.value(), message.value(), std::move(logs)
+        };
     }
     catch (const std::exception& e) {
         LOG_ERROR << "Failed to deserialize TransactionStatus";
@@ -677,4 +914,72 @@ std::optional<lk::TransactionStatus> deserializeTransactionStatus(const web::jso
     }
 }
 
+
+web::json::value serializeTransactionStatusUpdate(const TransactionStatusUpdate& update)
+{
+    web::json::value result;
+    result["hash"] = serializeHash(update.transaction_hash);
+    result["status"] = serializeTransactionStatus(update.status);
+    return result;
+}
+
+
+web::json::value serializeViewCallResult(const lk::ViewCallResult& result)
+{
+    web::json::value json;
+    json["status_code"] = serializeTransactionStatusStatusCode(result.status);
+    json["output"] = serializeBytes(result.output);
+    json["gas_used"] = serializeFee(result.gas_used);
+    return json;
+}
+
+
+std::optional<lk::ViewCallResult> deserializeViewCallResult(const web::json::value& input)
+{
+    try {
+        std::optional<lk::TransactionStatus::StatusCode> status_code;
+        if (input.has_number_field("status_code")) {
+            status_code = deserializeTransactionStatusStatusCode(input.at("status_code").as_number().to_uint32());
+        }
+        else {
+            LOG_ERROR << "status_code field is not exists";
+            return std::nullopt;
+        }
+        std::optional<base::Bytes> output;
+        if (input.has_string_field("output")) {
+            output = deserializeBytes(input.at("output").as_string());
+        }
+        else {
+            LOG_ERROR << "output field is not exists";
+            return std::nullopt;
+        }
+        std::optional<std::uint64_t> gas_used;
+        if (input.has_string_field("gas_used")) {
+            gas_used = deserializeFee(input.at("gas_used").as_string());
+        }
+        else {
+            LOG_ERROR << "gas_used field is not exists";
+            return std::nullopt;
+        }
+
+        if (!status_code) {
+            LOG_ERROR << "error at status_code deserialization";
+            return std::nullopt;
+        }
+        if (!output) {
+            LOG_ERROR << "error at output deserialization";
+            return std::nullopt;
+        }
+        if (!gas_used) {
+            LOG_ERROR << "error at gas_used deserialization";
+            return std::nullopt;
+        }
+        return lk::ViewCallResult{ status_code.value(), std::move(output.value()), gas_used.value() };
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR << "Failed to deserialize ViewCallResult";
+        return std::nullopt;
+    }
+}
+
 }
\ No newline at end of file
@@ -59,8 +59,34 @@ web::json::value serializeBlock(const lk::ImmutableBlock& block);
 
 std::optional<lk::ImmutableBlock> deserializeBlock(const web::json::value& input);
 
+web::json::value serializeLogTopic(const lk::LogTopic& topic);
+
+std::optional<lk::LogTopic> deserializeLogTopic(const std::string& data);
+
+web::json::value serializeEventLog(const lk::EventLog& log);
+
+std::optional<lk::EventLog> deserializeEventLog(const web::json::value& input);
+
+web::json::value serializeLogRecord(const lk::LogRecord& record);
+
+std::optional<lk::LogRecord> deserializeLogRecord(const web::json::value& input);
+
+web::json::value serializeLogsFilter(const lk::LogsFilter& filter);
+
+std::optional<lk::LogsFilter> deserializeLogsFilter(const web::json::value& input);
+
+web::json::value serializeContractTrace(const lk::ContractTrace& trace);
+
+std::optional<lk::ContractTrace> deserializeContractTrace(const web::json::value& input);
+
 web::json::value serializeTransactionStatus(const lk::TransactionStatus& status);
 
 std::optional<lk::TransactionStatus> deserializeTransactionStatus(const web::json::value& input);
 
+web::json::value serializeTransactionStatusUpdate(const TransactionStatusUpdate& update);
+
+web::json::value serializeViewCallResult(const lk::ViewCallResult& result);
+
+std::optional<lk::ViewCallResult> deserializeViewCallResult(const web::json::value& input);
+
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace rpc
+{
+
+/**
+ *  @brief LRU cache of encoded responses to calls, which result never changes.
+ *
+ *  Its size is bounded by a sum of sizes of values given at put, the least recently used values are evicted
+ *  to fit into it. A cache of max_size 0 keeps nothing.
+ *
+ *  @threadsafe
+ */
+template<typename Value>
+class ResponseCache
+{
+  public:
+    struct Statistics
+    {
+        std::size_t hits{ 0 };
+        std::size_t misses{ 0 };
+        std::size_t evictions{ 0 };
+        std::size_t entries{ 0 };
+        std::size_t size{ 0 };
+    };
+
+    // name is used in logs only
+    ResponseCache(std::string name, std::size_t max_size);
+
+    // a value is shared, so it is copied out of the cache without holding its lock
+    std::shared_ptr<const Value> find(const std::string& key);
+
+    void put(const std::string& key, Value value, std::size_t size);
+
+    Statistics getStatistics() const;
+
+  private:
+    struct Entry
+    {
+        std::string key;
+        std::shared_ptr<const Value> value;
+        std::size_t size;
+    };
+
+    const std::string _name;
+    const std::size_t _max_size;
+
+    mutable std::mutex _mutex;
+    std::list<Entry> _entries; // the most recently used first
+    std::unordered_map<std::string, typename std::list<Entry>::iterator> _index;
+    Statistics _statistics;
+
+    void reportIfNeeded();
+};
+
+} // namespace rpc
+
+#include "response_cache.tpp"
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "response_cache.hpp"
+
+#include "base/config.hpp"
+#include "base/log.hpp"
+
+namespace rpc
+{
+
+template<typename Value>
+ResponseCache<Value>::ResponseCache(std::string name, std::size_t max_size)
+  : _name{ std::move(name) }
+  , _max_size{ max_size }
+{}
+
+
+template<typename Value>
+std::shared_ptr<const Value> ResponseCache<Value>::find(const std::string& key)
+{
+    if (_max_size == 0) {
+        return nullptr;
+    }
+    std::lock_guard lk(_mutex);
+    reportIfNeeded();
+    if (auto it = _index.find(key); it != _index.end()) {
+        ++_statistics.hits;
+        _entries.splice(_entries.begin(), _entries, it->second);
+        return it->second->value;
+    }
+    ++_statistics.misses;
+    return nullptr;
+}
+
+
+template<typename Value>
+void ResponseCache<Value>::put(const std::string& key, Value value, std::size_t size)
+{
+    if (size > _max_size) {
+        return;
+    }
+    auto shared_value = std::make_shared<const Value>(std::move(value));
+
+    std::lock_guard lk(_mutex);
+    if (_index.find(key) != _index.end()) {
+        return; // put by a concurrent call, which missed too
+    }
+    while (_statistics.size + size > _max_size) {
+        const auto& oldest = _entries.back();
+        _statistics.size -= oldest.size;
+        _index.erase(oldest.key);
+        _entries.pop_back();
+        ++_statistics.evictions;
+    }
+    _entries.push_front(Entry{ key, std::move(shared_value), size });
+    _index.insert({ key, _entries.begin() });
+    _statistics.size += size;
+}
+
+
+template<typename Value>
+typename ResponseCache<Value>::Statistics ResponseCache<Value>::getStatistics() const
+{
+    std::lock_guard lk(_mutex);
+    auto statistics = _statistics;
+    statistics.entries = _entries.size();
+    return statistics;
+}
+
+
+template<typename Value>
+void ResponseCache<Value>::reportIfNeeded()
+{
+    auto lookups = _statistics.hits + _statistics.misses;
+    if (lookups == 0 || lookups % base::config::RPC_RESPONSE_CACHE_REPORT_PERIOD != 0) {
+        return;
+    }
+    LOG_INFO << "response cache " << _name << ": hit ratio " << 100.0 * _statistics.hits / lookups << "% of "
+             << lookups << " lookups, " << _entries.size() << " entries, " << _statistics.size << " bytes, "
+             << _statistics.evictions << " evictions";
+}
+
+} // namespace rpc
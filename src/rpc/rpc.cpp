@@ -1,10 +1,13 @@
 #include "rpc.hpp"
 
+#include "rpc/grpc/grpc_async_server.hpp"
 #include "rpc/grpc/grpc_client.hpp"
 #include "rpc/grpc/grpc_server.hpp"
 #include "rpc/http/http_client.hpp"
 #include "rpc/http/http_server.hpp"
 
+#include "base/config.hpp"
+
 namespace rpc
 {
 
@@ -14,7 +17,7 @@ namespace detail
 class RpcServer : public BaseRpcServer
 {
   public:
-    RpcServer(const base::PropertyTree& config, std::shared_ptr<BaseRpc> interface);
+    RpcServer(const base::PropertyTree& config, std::shared_ptr<BaseRpcService> interface);
 
     ~RpcServer() override;
 
@@ -41,16 +44,37 @@ RpcServer::~RpcServer()
     stop();
 }
 
-RpcServer::RpcServer(const base::PropertyTree& config, std::shared_ptr<BaseRpc> interface)
+RpcServer::RpcServer(const base::PropertyTree& config, std::shared_ptr<BaseRpcService> interface)
 {
+    auto response_cache_size = config.hasKey("rpc.response_cache_size")
+                                 ? config.get<std::size_t>("rpc.response_cache_size")
+                                 : base::config::RPC_RESPONSE_CACHE_SIZE;
     if (config.hasKey("rpc.grpc_address")) {
         _grpc_listening_address = config.get<std::string>("rpc.grpc_address");
-        _grpc_server = std::make_unique<rpc::grpc::NodeServer>(_grpc_listening_address, interface);
+        if (config.hasKey("rpc.grpc_async_workers")) {
+            auto max_queued_calls = config.hasKey("rpc.grpc_async_queue_limit")
+                                      ? config.get<std::size_t>("rpc.grpc_async_queue_limit")
+                                      : base::config::RPC_GRPC_ASYNC_QUEUE_LIMIT;
+            _grpc_server =
+              std::make_unique<rpc::grpc::AsyncNodeServer>(_grpc_listening_address,
+                                                           interface,
+                                                           config.get<std::size_t>("rpc.grpc_async_workers"),
+                                                           max_queued_calls,
+                                                           response_cache_size);
+        }
+        else {
+            _grpc_server =
+              std::make_unique<rpc::grpc::NodeServer>(_grpc_listening_address, interface, response_cache_size);
+        }
         _mode = _mode | GRPC;
     }
     if (config.hasKey("rpc.http_address")) {
         _http_listening_address = "http://" + config.get<std::string>("rpc.http_address");
-        _http_server = std::make_unique<rpc::http::NodeServer>(_http_listening_address, interface);
+        auto max_batch_size = config.hasKey("rpc.http_max_batch_size")
+                                ? config.get<std::size_t>("rpc.http_max_batch_size")
+                                : base::config::RPC_HTTP_MAX_BATCH_SIZE;
+        _http_server = std::make_unique<rpc::http::NodeServer>(
+          _http_listening_address, interface, max_batch_size, response_cache_size);
         _mode = _mode | HTTP;
     }
     if (!_mode) {
@@ -98,7 +122,8 @@ std::unique_ptr<BaseRpc> createRpcClient(ClientMode mode, const std::string& con
 }
 
 
-std::unique_ptr<BaseRpcServer> create_rpc_server(const base::PropertyTree& config, std::shared_ptr<BaseRpc> interface)
+std::unique_ptr<BaseRpcServer> create_rpc_server(const base::PropertyTree& config,
+                                                 std::shared_ptr<BaseRpcService> interface)
 {
     return std::make_unique<detail::RpcServer>(config, interface);
 }
@@ -28,6 +28,7 @@ class BaseRpcServer
 };
 
 
-std::unique_ptr<BaseRpcServer> create_rpc_server(const base::PropertyTree& config, std::shared_ptr<BaseRpc> interface);
+std::unique_ptr<BaseRpcServer> create_rpc_server(const base::PropertyTree& config,
+                                                 std::shared_ptr<BaseRpcService> interface);
 
 } // namespace rpc
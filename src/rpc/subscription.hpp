@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace rpc
+{
+
+/**
+ *  @brief Bounded queue of events for a single subscriber.
+ *
+ *  If the subscriber falls behind by more than queue_limit events, the subscription is closed
+ *  and its queue is cleared, so a slow consumer neither blocks the publisher nor holds memory.
+ *  A subscriber learns about it by isOverflowed and has to subscribe again.
+ *
+ *  @threadsafe
+ */
+template<typename T>
+class Subscription
+{
+  public:
+    // events for which filter returns false are not queued
+    using Filter = std::function<bool(const T&)>;
+
+    explicit Subscription(std::size_t queue_limit, Filter filter = {});
+
+    // returns false if the subscription is closed
+    bool push(const T& event);
+
+    // waits up to timeout for an event, nullopt if there was none or the subscription is closed
+    std::optional<T> pop(std::chrono::milliseconds timeout);
+
+    // waits up to timeout for the first event and takes all queued ones
+    std::vector<T> popAll(std::chrono::milliseconds timeout);
+
+    void close();
+    bool isClosed() const;
+    bool isOverflowed() const;
+
+  private:
+    const std::size_t _queue_limit;
+    const Filter _filter;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _event_cv;
+    std::deque<T> _queue;
+    bool _is_closed{ false };
+    bool _is_overflowed{ false };
+};
+
+
+/**
+ *  @brief Delivers published events to all alive subscriptions.
+ *
+ *  Subscriptions are held weakly: a subscription is dropped after its owner releases it or it is closed.
+ *
+ *  @threadsafe
+ */
+template<typename T>
+class SubscriptionHub
+{
+  public:
+    explicit SubscriptionHub(std::size_t queue_limit);
+
+    std::shared_ptr<Subscription<T>> subscribe(typename Subscription<T>::Filter filter = {});
+
+    void publish(const T& event);
+
+    std::size_t countSubscriptions() const;
+
+  private:
+    const std::size_t _queue_limit;
+
+    mutable std::mutex _subscriptions_mutex;
+    std::vector<std::weak_ptr<Subscription<T>>> _subscriptions;
+};
+
+} // namespace rpc
+
+#include "subscription.tpp"
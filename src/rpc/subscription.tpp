@@ -0,0 +1,140 @@
+#pragma once
+
+#include "subscription.hpp"
+
+#include "base/log.hpp"
+
+#include <algorithm>
+
+namespace rpc
+{
+
+template<typename T>
+Subscription<T>::Subscription(std::size_t queue_limit, Filter filter)
+  : _queue_limit{ queue_limit }
+  , _filter{ std::move(filter) }
+{}
+
+
+template<typename T>
+bool Subscription<T>::push(const T& event)
+{
+    if (_filter && !_filter(event)) {
+        return !isClosed();
+    }
+    {
+        std::lock_guard lk(_mutex);
+        if (_is_closed) {
+            return false;
+        }
+        if (_queue.size() >= _queue_limit) {
+            _is_overflowed = true;
+            _is_closed = true;
+            _queue.clear();
+        }
+        else {
+            _queue.push_back(event);
+        }
+    }
+    _event_cv.notify_all();
+    return !isClosed();
+}
+
+
+template<typename T>
+std::optional<T> Subscription<T>::pop(std::chrono::milliseconds timeout)
+{
+    std::unique_lock lk(_mutex);
+    _event_cv.wait_for(lk, timeout, [this] { return _is_closed || !_queue.empty(); });
+    if (_queue.empty()) {
+        return std::nullopt;
+    }
+    auto event = std::move(_queue.front());
+    _queue.pop_front();
+    return event;
+}
+
+
+template<typename T>
+std::vector<T> Subscription<T>::popAll(std::chrono::milliseconds timeout)
+{
+    std::unique_lock lk(_mutex);
+    _event_cv.wait_for(lk, timeout, [this] { return _is_closed || !_queue.empty(); });
+    std::vector<T> events{ std::make_move_iterator(_queue.begin()), std::make_move_iterator(_queue.end()) };
+    _queue.clear();
+    return events;
+}
+
+
+template<typename T>
+void Subscription<T>::close()
+{
+    {
+        std::lock_guard lk(_mutex);
+        _is_closed = true;
+    }
+    _event_cv.notify_all();
+}
+
+
+template<typename T>
+bool Subscription<T>::isClosed() const
+{
+    std::lock_guard lk(_mutex);
+    return _is_closed;
+}
+
+
+template<typename T>
+bool Subscription<T>::isOverflowed() const
+{
+    std::lock_guard lk(_mutex);
+    return _is_overflowed;
+}
+
+
+template<typename T>
+SubscriptionHub<T>::SubscriptionHub(std::size_t queue_limit)
+  : _queue_limit{ queue_limit }
+{}
+
+
+template<typename T>
+std::shared_ptr<Subscription<T>> SubscriptionHub<T>::subscribe(typename Subscription<T>::Filter filter)
+{
+    auto subscription = std::make_shared<Subscription<T>>(_queue_limit, std::move(filter));
+    std::lock_guard lk(_subscriptions_mutex);
+    _subscriptions.push_back(subscription);
+    return subscription;
+}
+
+
+template<typename T>
+void SubscriptionHub<T>::publish(const T& event)
+{
+    std::lock_guard lk(_subscriptions_mutex);
+    auto dropped = std::remove_if(_subscriptions.begin(), _subscriptions.end(), [&event](const auto& weak) {
+        auto subscription = weak.lock();
+        if (!subscription) {
+            return true;
+        }
+        if (!subscription->push(event)) {
+            if (subscription->isOverflowed()) {
+                LOG_WARNING << "subscriber didn't keep up with events and was dropped";
+            }
+            return true;
+        }
+        return false;
+    });
+    _subscriptions.erase(dropped, _subscriptions.end());
+}
+
+
+template<typename T>
+std::size_t SubscriptionHub<T>::countSubscriptions() const
+{
+    std::lock_guard lk(_subscriptions_mutex);
+    return _subscriptions.size();
+}
+
+} // namespace rpc
@@ -0,0 +1,1025 @@
+#include "abi.hpp"
+
+#include "base/assert.hpp"
+#include "base/error.hpp"
+#include "base/hash.hpp"
+
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+namespace
+{
+
+constexpr std::size_t WORD_SIZE = 32;
+constexpr std::size_t ADDRESS_SIZE = 20;
+
+using BigInt = boost::multiprecision::cpp_int;
+using vm::AbiType;
+
+
+// argument of a call as it is written by a user, types are applied only during encoding
+struct Value
+{
+    enum class Kind
+    {
+        NUMBER,
+        BOOL,
+        STRING,
+        LIST
+    };
+
+    explicit Value(Kind kind_, std::string text_ = {}, bool flag_ = false)
+      : kind{ kind_ }
+      , text{ std::move(text_) }
+      , flag{ flag_ }
+    {}
+
+    Kind kind;
+    std::string text;
+    bool flag;
+    std::vector<Value> items;
+};
+
+
+class ArgumentsParser
+{
+  public:
+    explicit ArgumentsParser(std::string_view arguments)
+      : _s{ arguments }
+    {}
+
+
+    std::vector<Value> parse()
+    {
+        std::vector<Value> ret;
+        skipSpaces();
+        if (_pos == _s.size()) {
+            return ret;
+        }
+        while (true) {
+            ret.push_back(parseValue());
+            skipSpaces();
+            if (_pos == _s.size()) {
+                return ret;
+            }
+            expect(',');
+        }
+    }
+
+  private:
+    std::string_view _s;
+    std::size_t _pos{ 0 };
+
+
+    void skipSpaces()
+    {
+        while (_pos < _s.size() && std::isspace(static_cast<unsigned char>(_s[_pos]))) {
+            ++_pos;
+        }
+    }
+
+
+    void expect(char c)
+    {
+        skipSpaces();
+        if (_pos == _s.size() || _s[_pos] != c) {
+            RAISE_ERROR(base::InvalidArgument,
+                        std::string{ "expected '" } + c + "' at position " + std::to_string(_pos) + " of arguments");
+        }
+        ++_pos;
+    }
+
+
+    Value parseValue()
+    {
+        skipSpaces();
+        if (_pos == _s.size()) {
+            RAISE_ERROR(base::InvalidArgument, "unexpected end of arguments");
+        }
+        if (_s[_pos] == '[') {
+            return parseList();
+        }
+        if (_s[_pos] == '"' || _s[_pos] == '\'') {
+            return Value{ Value::Kind::STRING, parseQuoted() };
+        }
+        return parseToken();
+    }
+
+
+    Value parseList()
+    {
+        Value ret{ Value::Kind::LIST };
+        expect('[');
+        skipSpaces();
+        if (_pos < _s.size() && _s[_pos] == ']') {
+            ++_pos;
+            return ret;
+        }
+        while (true) {
+            ret.items.push_back(parseValue());
+            skipSpaces();
+            if (_pos < _s.size() && _s[_pos] == ']') {
+                ++_pos;
+                return ret;
+            }
+            expect(',');
+        }
+    }
+
+
+    std::string parseQuoted()
+    {
+        const char quote = _s[_pos++];
+        std::string ret;
+        while (_pos < _s.size() && _s[_pos] != quote) {
+            char c = _s[_pos++];
+            if (c == '\\' && _pos < _s.size()) {
+                switch (c = _s[_pos++]) {
+                    case 'n':
+                        c = '\n';
+                        break;
+                    case 't':
+                        c = '\t';
+                        break;
+                    case 'r':
+                        c = '\r';
+                        break;
+                    default:
+                        break;
+                }
+            }
+            ret.push_back(c);
+        }
+        if (_pos == _s.size()) {
+            RAISE_ERROR(base::InvalidArgument, "string argument is not closed");
+        }
+        ++_pos;
+        return ret;
+    }
+
+
+    Value parseToken()
+    {
+        static constexpr std::string_view ADDRESS_PREFIX = "Address(";
+        if (_s.substr(_pos, ADDRESS_PREFIX.size()) == ADDRESS_PREFIX) {
+            _pos += ADDRESS_PREFIX.size();
+            auto end = _s.find(')', _pos);
+            if (end == std::string_view::npos) {
+                RAISE_ERROR(base::InvalidArgument, "Address( is not closed");
+            }
+            auto address = base::base58Decode<ADDRESS_SIZE>(_s.substr(_pos, end - _pos));
+            _pos = end + 1;
+            return Value{ Value::Kind::STRING, base::toHex(address) };
+        }
+
+        auto begin = _pos;
+        while (_pos < _s.size() && _s[_pos] != ',' && _s[_pos] != ']' &&
+               !std::isspace(static_cast<unsigned char>(_s[_pos]))) {
+            ++_pos;
+        }
+        std::string token{ _s.substr(begin, _pos - begin) };
+
+        if (token == "true" || token == "True") {
+            return Value{ Value::Kind::BOOL, token, true };
+        }
+        if (token == "false" || token == "False") {
+            return Value{ Value::Kind::BOOL, token, false };
+        }
+        auto digits = std::string_view{ token }.substr(!token.empty() && token[0] == '-' ? 1 : 0);
+        if (!digits.empty() && std::all_of(digits.begin(), digits.end(), [](char c) { return std::isdigit(c); })) {
+            return Value{ Value::Kind::NUMBER, token };
+        }
+        if (digits.size() > 2 && digits.substr(0, 2) == "0x" &&
+            std::all_of(digits.begin() + 2, digits.end(), [](char c) { return std::isxdigit(c); })) {
+            return Value{ Value::Kind::NUMBER, token };
+        }
+        // not quoted strings are accepted as well, e.g. hex of bytes
+        return Value{ Value::Kind::STRING, token };
+    }
+};
+
+
+std::pair<std::string, std::string> splitCall(const std::string& call)
+{
+    auto first_bracket_pos = call.find('(');
+    if (first_bracket_pos == std::string::npos || call.back() != ')') {
+        RAISE_ERROR(base::InvalidArgument, "Wrong message for encode");
+    }
+    auto name = call.substr(0, first_bracket_pos);
+    auto arguments = call.substr(first_bracket_pos + 1, call.size() - first_bracket_pos - 2);
+    return { name, arguments };
+}
+
+
+//====================================
+
+const BigInt& wordModulus()
+{
+    static const BigInt modulus = BigInt{ 1 } << (WORD_SIZE * 8);
+    return modulus;
+}
+
+
+void appendWord(base::Bytes& out, const BigInt& value)
+{
+    std::vector<base::Byte> raw;
+    boost::multiprecision::export_bits(value, std::back_inserter(raw), 8);
+    out.append(base::Bytes(WORD_SIZE - raw.size()));
+    out.append(raw.data(), raw.size());
+}
+
+
+void appendSize(base::Bytes& out, std::size_t value)
+{
+    appendWord(out, BigInt{ value });
+}
+
+
+void appendPadded(base::Bytes& out, const base::Bytes& data)
+{
+    out.append(data);
+    if (auto rest = data.size() % WORD_SIZE; rest != 0) {
+        out.append(base::Bytes(WORD_SIZE - rest));
+    }
+}
+
+
+base::Bytes parseHex(const Value& value)
+{
+    if (value.kind != Value::Kind::STRING && value.kind != Value::Kind::NUMBER) {
+        RAISE_ERROR(base::InvalidArgument, "bytes are expected to be given as a hex string");
+    }
+    std::string_view hex{ value.text };
+    if (hex.substr(0, 2) == "0x") {
+        hex.remove_prefix(2);
+    }
+    return base::fromHex<base::Bytes>(hex);
+}
+
+
+BigInt parseNumber(const Value& value, const AbiType& type)
+{
+    if (value.kind != Value::Kind::NUMBER) {
+        RAISE_ERROR(base::InvalidArgument, "number is expected for " + type.getCanonicalName());
+    }
+    bool is_negative = value.text[0] == '-';
+    BigInt ret{ is_negative ? value.text.substr(1) : value.text };
+    if (is_negative) {
+        ret = -ret;
+    }
+
+    const auto bits = type.getSize();
+    const bool fits = type.getKind() == AbiType::Kind::UINT
+                        ? ret >= 0 && ret < (BigInt{ 1 } << bits)
+                        : ret >= -(BigInt{ 1 } << (bits - 1)) && ret < (BigInt{ 1 } << (bits - 1));
+    if (!fits) {
+        RAISE_ERROR(base::InvalidArgument, value.text + " doesn't fit into " + type.getCanonicalName());
+    }
+    return ret < 0 ? ret + wordModulus() : ret;
+}
+
+
+const std::vector<Value>& getItems(const Value& value, const AbiType& type)
+{
+    if (value.kind != Value::Kind::LIST) {
+        RAISE_ERROR(base::InvalidArgument, "list is expected for " + type.getCanonicalName());
+    }
+    return value.items;
+}
+
+
+void encodeValue(const AbiType& type, const Value& value, base::Bytes& out);
+
+
+template<typename TypeAt>
+void encodeSequence(const TypeAt& type_at, const std::vector<Value>& values, base::Bytes& out)
+{
+    std::size_t head_size = 0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        head_size += type_at(i).getHeadSize();
+    }
+
+    base::Bytes tail;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const auto& type = type_at(i);
+        if (type.isDynamic()) {
+            appendSize(out, head_size + tail.size());
+            encodeValue(type, values[i], tail);
+        }
+        else {
+            encodeValue(type, values[i], out);
+        }
+    }
+    out.append(tail);
+}
+
+
+void encodeTuple(const std::vector<AbiType>& types, const std::vector<Value>& values, base::Bytes& out)
+{
+    if (types.size() != values.size()) {
+        RAISE_ERROR(base::InvalidArgument,
+                    "expected " + std::to_string(types.size()) + " values, got " + std::to_string(values.size()));
+    }
+    encodeSequence([&types](std::size_t i) -> const AbiType& { return types[i]; }, values, out);
+}
+
+
+void encodeValue(const AbiType& type, const Value& value, base::Bytes& out)
+{
+    switch (type.getKind()) {
+        case AbiType::Kind::UINT:
+        case AbiType::Kind::INT:
+            appendWord(out, parseNumber(value, type));
+            break;
+        case AbiType::Kind::BOOL:
+            if (value.kind != Value::Kind::BOOL) {
+                RAISE_ERROR(base::InvalidArgument, "bool is expected");
+            }
+            appendSize(out, value.flag ? 1 : 0);
+            break;
+        case AbiType::Kind::ADDRESS: {
+            auto address = parseHex(value);
+            // addresses padded to a word are accepted too
+            if (address.size() == WORD_SIZE &&
+                std::all_of(address.getData(), address.getData() + WORD_SIZE - ADDRESS_SIZE, [](auto b) {
+                    return b == 0;
+                })) {
+                address = address.takePart(WORD_SIZE - ADDRESS_SIZE, WORD_SIZE);
+            }
+            if (address.size() != ADDRESS_SIZE) {
+                RAISE_ERROR(base::InvalidArgument, "address must be 20 bytes long");
+            }
+            out.append(base::Bytes(WORD_SIZE - ADDRESS_SIZE));
+            out.append(address);
+            break;
+        }
+        case AbiType::Kind::FIXED_BYTES: {
+            auto bytes = parseHex(value);
+            if (bytes.size() > type.getSize()) {
+                RAISE_ERROR(base::InvalidArgument, "too many bytes for " + type.getCanonicalName());
+            }
+            appendPadded(out, bytes.isEmpty() ? base::Bytes(WORD_SIZE) : bytes);
+            break;
+        }
+        case AbiType::Kind::BYTES: {
+            auto bytes = parseHex(value);
+            appendSize(out, bytes.size());
+            appendPadded(out, bytes);
+            break;
+        }
+        case AbiType::Kind::STRING: {
+            if (value.kind != Value::Kind::STRING) {
+                RAISE_ERROR(base::InvalidArgument, "string is expected");
+            }
+            appendSize(out, value.text.size());
+            appendPadded(out, base::Bytes(value.text));
+            break;
+        }
+        case AbiType::Kind::ARRAY: {
+            const auto& items = getItems(value, type);
+            appendSize(out, items.size());
+            const auto& element = type.getComponents().front();
+            encodeSequence([&element](std::size_t) -> const AbiType& { return element; }, items, out);
+            break;
+        }
+        case AbiType::Kind::FIXED_ARRAY: {
+            const auto& items = getItems(value, type);
+            if (items.size() != type.getSize()) {
+                RAISE_ERROR(base::InvalidArgument, "wrong number of items for " + type.getCanonicalName());
+            }
+            const auto& element = type.getComponents().front();
+            encodeSequence([&element](std::size_t) -> const AbiType& { return element; }, items, out);
+            break;
+        }
+        case AbiType::Kind::TUPLE:
+            encodeTuple(type.getComponents(), getItems(value, type), out);
+            break;
+    }
+}
+
+
+base::Bytes encodeValues(const std::vector<AbiType>& types, const std::vector<Value>& values)
+{
+    base::Bytes ret;
+    encodeTuple(types, values, ret);
+    return ret;
+}
+
+
+//====================================
+
+void appendJsonString(std::string& out, std::string_view s)
+{
+    static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+    out.push_back('"');
+    for (char c : s) {
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out += "\\u00";
+                    out.push_back(HEX_DIGITS[(c >> 4) & 0xF]);
+                    out.push_back(HEX_DIGITS[c & 0xF]);
+                }
+                else {
+                    out.push_back(c);
+                }
+        }
+    }
+    out.push_back('"');
+}
+
+
+class Decoder
+{
+  public:
+    explicit Decoder(const base::Bytes& data)
+      : _data{ data }
+    {}
+
+
+    template<typename TypeAt>
+    void decodeSequence(std::size_t count, const TypeAt& type_at, std::size_t base, std::string& out) const
+    {
+        out.push_back('[');
+        auto head_pos = base;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (i != 0) {
+                out += ", ";
+            }
+            decodeMember(type_at(i), base, head_pos, out);
+        }
+        out.push_back(']');
+    }
+
+
+    // decodes a member of tuple, which starts at base, and moves head_pos to the next member
+    void decodeMember(const AbiType& type, std::size_t base, std::size_t& head_pos, std::string& out) const
+    {
+        if (type.isDynamic()) {
+            decodeValue(type, base + readSize(head_pos), out);
+        }
+        else {
+            decodeValue(type, head_pos, out);
+        }
+        head_pos += type.getHeadSize();
+    }
+
+
+    void decodeValue(const AbiType& type, std::size_t pos, std::string& out) const
+    {
+        switch (type.getKind()) {
+            case AbiType::Kind::UINT:
+                out += readWord(pos).str();
+                break;
+            case AbiType::Kind::INT: {
+                auto value = readWord(pos);
+                if (value >= wordModulus() / 2) {
+                    value -= wordModulus();
+                }
+                out += value.str();
+                break;
+            }
+            case AbiType::Kind::BOOL:
+                out += readWord(pos) != 0 ? "true" : "false";
+                break;
+            case AbiType::Kind::ADDRESS:
+                checkAvailable(pos, WORD_SIZE);
+                appendJsonString(
+                  out,
+                  base::base58Encode(base::FixedBytes<ADDRESS_SIZE>(_data.getData() + pos + WORD_SIZE - ADDRESS_SIZE,
+                                                                    ADDRESS_SIZE)));
+                break;
+            case AbiType::Kind::FIXED_BYTES:
+                checkAvailable(pos, WORD_SIZE);
+                appendJsonString(out, base::toHex(_data.takePart(pos, pos + type.getSize())));
+                break;
+            case AbiType::Kind::BYTES: {
+                auto length = readSize(pos);
+                checkAvailable(pos + WORD_SIZE, length);
+                appendJsonString(out, base::toHex(_data.takePart(pos + WORD_SIZE, pos + WORD_SIZE + length)));
+                break;
+            }
+            case AbiType::Kind::STRING: {
+                auto length = readSize(pos);
+                checkAvailable(pos + WORD_SIZE, length);
+                appendJsonString(
+                  out, std::string_view{ reinterpret_cast<const char*>(_data.getData()) + pos + WORD_SIZE, length });
+                break;
+            }
+            case AbiType::Kind::ARRAY: {
+                auto count = readSize(pos);
+                const auto& element = type.getComponents().front();
+                // every element takes at least one word, so a bigger count is garbage
+                checkAvailable(pos + WORD_SIZE, count * WORD_SIZE);
+                decodeSequence(
+                  count, [&element](std::size_t) -> const AbiType& { return element; }, pos + WORD_SIZE, out);
+                break;
+            }
+            case AbiType::Kind::FIXED_ARRAY: {
+                const auto& element = type.getComponents().front();
+                decodeSequence(
+                  type.getSize(), [&element](std::size_t) -> const AbiType& { return element; }, pos, out);
+                break;
+            }
+            case AbiType::Kind::TUPLE: {
+                const auto& members = type.getComponents();
+                decodeSequence(
+                  members.size(), [&members](std::size_t i) -> const AbiType& { return members[i]; }, pos, out);
+                break;
+            }
+        }
+    }
+
+  private:
+    const base::Bytes& _data;
+
+
+    void checkAvailable(std::size_t pos, std::size_t length) const
+    {
+        if (pos > _data.size() || length > _data.size() - pos) {
+            RAISE_ERROR(base::InvalidArgument, "abi encoded data is too short");
+        }
+    }
+
+
+    BigInt readWord(std::size_t pos) const
+    {
+        checkAvailable(pos, WORD_SIZE);
+        BigInt ret;
+        boost::multiprecision::import_bits(ret, _data.getData() + pos, _data.getData() + pos + WORD_SIZE, 8);
+        return ret;
+    }
+
+
+    std::size_t readSize(std::size_t pos) const
+    {
+        auto value = readWord(pos);
+        if (value > _data.size()) {
+            RAISE_ERROR(base::InvalidArgument, "abi encoded offset or length is out of data");
+        }
+        return value.convert_to<std::size_t>();
+    }
+};
+
+
+// overloads are resolved by the first one accepting the arguments
+const vm::AbiFunction* matchFunction(const std::vector<vm::AbiFunction>& functions,
+                                     const std::vector<std::size_t>& overloads,
+                                     const std::vector<Value>& values,
+                                     base::Bytes& encoded_arguments)
+{
+    for (auto index : overloads) {
+        const auto& function = functions[index];
+        if (function.getInputs().size() != values.size()) {
+            continue;
+        }
+        try {
+            encoded_arguments = encodeValues(function.getInputs(), values);
+            return &function;
+        }
+        catch (const base::InvalidArgument&) {
+            continue;
+        }
+    }
+    RAISE_ERROR(base::InvalidArgument, "No methods with these arguments have been found");
+}
+
+} // namespace
+
+
+namespace vm
+{
+
+AbiType::AbiType(Kind kind, std::size_t size, std::vector<AbiType> components)
+  : _kind{ kind }
+  , _size{ size }
+  , _components{ std::move(components) }
+  , _is_dynamic{ false }
+  , _head_size{ WORD_SIZE }
+{
+    switch (_kind) {
+        case Kind::UINT:
+            _canonical_name = "uint" + std::to_string(_size);
+            break;
+        case Kind::INT:
+            _canonical_name = "int" + std::to_string(_size);
+            break;
+        case Kind::BOOL:
+            _canonical_name = "bool";
+            break;
+        case Kind::ADDRESS:
+            _canonical_name = "address";
+            break;
+        case Kind::FIXED_BYTES:
+            _canonical_name = "bytes" + std::to_string(_size);
+            break;
+        case Kind::BYTES:
+            _canonical_name = "bytes";
+            _is_dynamic = true;
+            break;
+        case Kind::STRING:
+            _canonical_name = "string";
+            _is_dynamic = true;
+            break;
+        case Kind::ARRAY:
+            _canonical_name = _components.front()._canonical_name + "[]";
+            _is_dynamic = true;
+            break;
+        case Kind::FIXED_ARRAY:
+            _canonical_name = _components.front()._canonical_name + '[' + std::to_string(_size) + ']';
+            _is_dynamic = _components.front()._is_dynamic;
+            if (!_is_dynamic) {
+                _head_size = _size * _components.front()._head_size;
+            }
+            break;
+        case Kind::TUPLE: {
+            _canonical_name = "(";
+            std::size_t members_head_size = 0;
+            for (const auto& member : _components) {
+                if (_canonical_name.size() > 1) {
+                    _canonical_name += ',';
+                }
+                _canonical_name += member._canonical_name;
+                _is_dynamic = _is_dynamic || member._is_dynamic;
+                members_head_size += member._head_size;
+            }
+            _canonical_name += ')';
+            if (!_is_dynamic) {
+                _head_size = members_head_size;
+            }
+            break;
+        }
+    }
+}
+
+
+AbiType AbiType::fromJson(const boost::property_tree::ptree& parameter)
+{
+    try {
+        return parse(parameter.get<std::string>("type"), &parameter);
+    }
+    catch (const boost::property_tree::ptree_error& e) {
+        RAISE_ERROR(base::InvalidArgument, "Invalid Metadata format");
+    }
+}
+
+
+AbiType AbiType::fromString(const std::string& type_name)
+{
+    return parse(type_name, nullptr);
+}
+
+
+AbiType AbiType::parse(const std::string& type_name, const boost::property_tree::ptree* parameter)
+{
+    static constexpr std::string_view TUPLE_PREFIX = "tuple";
+
+    std::optional<AbiType> ret;
+    std::size_t suffix_pos;
+    if (parameter && type_name.compare(0, TUPLE_PREFIX.size(), TUPLE_PREFIX) == 0) {
+        std::vector<AbiType> members;
+        for (const auto& component : parameter->get_child("components")) {
+            members.push_back(fromJson(component.second));
+        }
+        ret = AbiType{ Kind::TUPLE, 0, std::move(members) };
+        suffix_pos = TUPLE_PREFIX.size();
+    }
+    else if (!type_name.empty() && type_name[0] == '(') {
+        std::vector<AbiType> members;
+        std::size_t depth = 0;
+        std::size_t member_begin = 1;
+        for (suffix_pos = 0; suffix_pos < type_name.size(); ++suffix_pos) {
+            const char c = type_name[suffix_pos];
+            if (c == '(') {
+                ++depth;
+            }
+            else if ((c == ',' && depth == 1) || (c == ')' && depth == 1 && suffix_pos > member_begin)) {
+                members.push_back(fromString(type_name.substr(member_begin, suffix_pos - member_begin)));
+                member_begin = suffix_pos + 1;
+            }
+            if (c == ')' && --depth == 0) {
+                break;
+            }
+        }
+        if (depth != 0) {
+            RAISE_ERROR(base::InvalidArgument, "tuple type is not closed: " + type_name);
+        }
+        ret = AbiType{ Kind::TUPLE, 0, std::move(members) };
+        ++suffix_pos;
+    }
+    else {
+        suffix_pos = std::min(type_name.find('['), type_name.size());
+        ret = parseElementary(type_name.substr(0, suffix_pos));
+    }
+
+    while (suffix_pos < type_name.size()) {
+        auto end = type_name.find(']', suffix_pos);
+        if (type_name[suffix_pos] != '[' || end == std::string::npos) {
+            RAISE_ERROR(base::InvalidArgument, "invalid array type: " + type_name);
+        }
+        auto length = type_name.substr(suffix_pos + 1, end - suffix_pos - 1);
+        if (length.empty()) {
+            ret = AbiType{ Kind::ARRAY, 0, { std::move(*ret) } };
+        }
+        else if (std::all_of(length.begin(), length.end(), [](char c) { return std::isdigit(c); }) &&
+                 std::stoul(length) > 0) {
+            ret = AbiType{ Kind::FIXED_ARRAY, std::stoul(length), { std::move(*ret) } };
+        }
+        else {
+            RAISE_ERROR(base::InvalidArgument, "invalid array length in type: " + type_name);
+        }
+        suffix_pos = end + 1;
+    }
+    return std::move(*ret);
+}
+
+
+AbiType AbiType::parseElementary(const std::string& name)
+{
+    auto parseSize = [&name](std::size_t prefix_size, std::size_t default_size) -> std::size_t {
+        auto digits = name.substr(prefix_size);
+        if (digits.empty()) {
+            return default_size;
+        }
+        if (!std::all_of(digits.begin(), digits.end(), [](char c) { return std::isdigit(c); }) || digits.size() > 3) {
+            RAISE_ERROR(base::InvalidArgument, "invalid type: " + name);
+        }
+        return std::stoul(digits);
+    };
+
+    if (name == "bool") {
+        return AbiType{ Kind::BOOL, 0, {} };
+    }
+    if (name == "address") {
+        return AbiType{ Kind::ADDRESS, ADDRESS_SIZE, {} };
+    }
+    if (name == "string") {
+        return AbiType{ Kind::STRING, 0, {} };
+    }
+    if (name == "bytes") {
+        return AbiType{ Kind::BYTES, 0, {} };
+    }
+    if (name.compare(0, 5, "bytes") == 0) {
+        auto size = parseSize(5, 0);
+        if (size == 0 || size > WORD_SIZE) {
+            RAISE_ERROR(base::InvalidArgument, "invalid type: " + name);
+        }
+        return AbiType{ Kind::FIXED_BYTES, size, {} };
+    }
+    for (auto [prefix, kind] : { std::pair{ "uint", Kind::UINT }, std::pair{ "int", Kind::INT } }) {
+        const std::string_view prefix_view{ prefix };
+        if (name.compare(0, prefix_view.size(), prefix_view) == 0) {
+            auto bits = parseSize(prefix_view.size(), WORD_SIZE * 8);
+            if (bits == 0 || bits > WORD_SIZE * 8 || bits % 8 != 0) {
+                RAISE_ERROR(base::InvalidArgument, "invalid type: " + name);
+            }
+            return AbiType{ kind, bits, {} };
+        }
+    }
+    RAISE_ERROR(base::InvalidArgument, "unsupported abi type: " + name);
+}
+
+
+AbiType::Kind AbiType::getKind() const noexcept
+{
+    return _kind;
+}
+
+
+std::size_t AbiType::getSize() const noexcept
+{
+    return _size;
+}
+
+
+const std::vector<AbiType>& AbiType::getComponents() const noexcept
+{
+    return _components;
+}
+
+
+const std::string& AbiType::getCanonicalName() const noexcept
+{
+    return _canonical_name;
+}
+
+
+bool AbiType::isDynamic() const noexcept
+{
+    return _is_dynamic;
+}
+
+
+std::size_t AbiType::getHeadSize() const noexcept
+{
+    return _head_size;
+}
+
+//====================================
+
+base::Bytes abiEncode(const std::vector<AbiType>& types, const std::string& arguments)
+{
+    return encodeValues(types, ArgumentsParser{ arguments }.parse());
+}
+
+
+std::string abiDecode(const std::vector<AbiType>& types,
+                      const std::vector<std::string>& names,
+                      const base::Bytes& data)
+{
+    ASSERT(types.size() == names.size());
+    Decoder decoder{ data };
+    std::string ret = "{";
+    std::size_t head_pos = 0;
+    for (std::size_t i = 0; i < types.size(); ++i) {
+        if (i != 0) {
+            ret += ", ";
+        }
+        appendJsonString(ret, names[i]);
+        ret += ": ";
+        decoder.decodeMember(types[i], 0, head_pos, ret);
+    }
+    ret += '}';
+    return ret;
+}
+
+//====================================
+
+AbiFunction::AbiFunction(const boost::property_tree::ptree& function_abi)
+{
+    try {
+        _name = function_abi.get<std::string>("name");
+        for (const auto& input : function_abi.get_child("inputs")) {
+            _inputs.push_back(AbiType::fromJson(input.second));
+        }
+        if (auto outputs = function_abi.get_child_optional("outputs")) {
+            for (const auto& output : *outputs) {
+                _outputs.push_back(AbiType::fromJson(output.second));
+                _output_names.push_back(output.second.get<std::string>("name", ""));
+            }
+        }
+    }
+    catch (const boost::property_tree::ptree_error& e) {
+        RAISE_ERROR(base::InvalidArgument, "Invalid Metadata format");
+    }
+
+    _signature = _name + '(';
+    for (const auto& input : _inputs) {
+        _signature += input.getCanonicalName() + ',';
+    }
+    if (_signature.back() == ',') {
+        _signature.pop_back();
+    }
+    _signature += ')';
+    _selector = base::FixedBytes<SELECTOR_SIZE>(
+      base::Keccak256::compute(base::Bytes(_signature)).getBytes().getData(), SELECTOR_SIZE);
+}
+
+
+const std::string& AbiFunction::getName() const noexcept
+{
+    return _name;
+}
+
+
+const std::string& AbiFunction::getSignature() const noexcept
+{
+    return _signature;
+}
+
+
+const base::FixedBytes<AbiFunction::SELECTOR_SIZE>& AbiFunction::getSelector() const noexcept
+{
+    return _selector;
+}
+
+
+const std::vector<AbiType>& AbiFunction::getInputs() const noexcept
+{
+    return _inputs;
+}
+
+
+const std::vector<AbiType>& AbiFunction::getOutputs() const noexcept
+{
+    return _outputs;
+}
+
+
+base::Bytes AbiFunction::encodeCall(const std::string& arguments) const
+{
+    return base::Bytes(_selector) + abiEncode(_inputs, arguments);
+}
+
+
+std::string AbiFunction::decodeOutput(const base::Bytes& data) const
+{
+    return abiDecode(_outputs, _output_names, data);
+}
+
+//====================================
+
+ContractAbi::ContractAbi(const boost::property_tree::ptree& metadata)
+{
+    try {
+        for (const auto& entry : metadata.get_child("output.abi")) {
+            auto type = entry.second.get<std::string>("type");
+            if (type == "function") {
+                _functions.emplace_back(entry.second);
+            }
+            else if (type == "constructor") {
+                for (const auto& input : entry.second.get_child("inputs")) {
+                    _constructor_inputs.push_back(AbiType::fromJson(input.second));
+                }
+            }
+        }
+    }
+    catch (const boost::property_tree::ptree_error& e) {
+        RAISE_ERROR(base::InvalidArgument, "Invalid Metadata format");
+    }
+
+    for (std::size_t i = 0; i < _functions.size(); ++i) {
+        _functions_by_selector.emplace(_functions[i].getSelector(), i);
+        _overloads_by_name[_functions[i].getName()].push_back(i);
+    }
+}
+
+
+const std::vector<AbiFunction>& ContractAbi::getFunctions() const noexcept
+{
+    return _functions;
+}
+
+
+const AbiFunction& ContractAbi::findFunction(const std::string& name, const std::string& arguments) const
+{
+    base::Bytes encoded_arguments;
+    return *matchFunction(_functions, getOverloads(name), ArgumentsParser{ arguments }.parse(), encoded_arguments);
+}
+
+
+const AbiFunction& ContractAbi::findFunction(const base::FixedBytes<AbiFunction::SELECTOR_SIZE>& selector) const
+{
+    auto it = _functions_by_selector.find(selector);
+    if (it == _functions_by_selector.end()) {
+        RAISE_ERROR(base::InvalidArgument, "No metadata with method id data was found");
+    }
+    return _functions[it->second];
+}
+
+
+base::Bytes ContractAbi::encodeCall(const std::string& call, const base::Bytes& bytecode) const
+{
+    auto [name, arguments] = splitCall(call);
+    auto values = ArgumentsParser{ arguments }.parse();
+
+    if (name == "constructor") {
+        return bytecode + encodeValues(_constructor_inputs, values);
+    }
+
+    base::Bytes encoded_arguments;
+    const auto* function = matchFunction(_functions, getOverloads(name), values, encoded_arguments);
+    return base::Bytes(function->getSelector()) + encoded_arguments;
+}
+
+
+std::string ContractAbi::decodeOutput(const base::Bytes& output) const
+{
+    if (output.size() < AbiFunction::SELECTOR_SIZE) {
+        RAISE_ERROR(base::InvalidArgument, "output is shorter than a method id");
+    }
+    const auto& function =
+      findFunction(base::FixedBytes<AbiFunction::SELECTOR_SIZE>(output.getData(), AbiFunction::SELECTOR_SIZE));
+    return function.decodeOutput(output.takePart(AbiFunction::SELECTOR_SIZE, output.size()));
+}
+
+
+const std::vector<std::size_t>& ContractAbi::getOverloads(const std::string& name) const
+{
+    static const std::vector<std::size_t> no_overloads;
+    auto it = _overloads_by_name.find(name);
+    return it == _overloads_by_name.end() ? no_overloads : it->second;
+}
+
+} // namespace vm
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "base/bytes.hpp"
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace vm
+{
+
+/// Solidity ABI type, as given by a parameter of the contract metadata.
+class AbiType
+{
+  public:
+    //===================
+    enum class Kind
+    {
+        UINT,
+        INT,
+        BOOL,
+        ADDRESS,
+        FIXED_BYTES,
+        BYTES,
+        STRING,
+        ARRAY,
+        FIXED_ARRAY,
+        TUPLE
+    };
+    //===================
+    // parses entry of "inputs" or "outputs" of the ABI (uses "type" and "components" fields)
+    static AbiType fromJson(const boost::property_tree::ptree& parameter);
+
+    // parses canonical type name, e.g. "uint256[2][]" or "(bytes,bool)"
+    static AbiType fromString(const std::string& type_name);
+    //===================
+    Kind getKind() const noexcept;
+
+    // bits for integers, bytes for bytesN and length for fixed arrays
+    std::size_t getSize() const noexcept;
+
+    // single element type for arrays and member types for tuples
+    const std::vector<AbiType>& getComponents() const noexcept;
+
+    const std::string& getCanonicalName() const noexcept;
+
+    bool isDynamic() const noexcept;
+
+    // number of bytes the type takes in the head of an enclosing tuple
+    std::size_t getHeadSize() const noexcept;
+    //===================
+  private:
+    //===================
+    AbiType(Kind kind, std::size_t size, std::vector<AbiType> components);
+    //===================
+    Kind _kind;
+    std::size_t _size;
+    std::vector<AbiType> _components;
+    std::string _canonical_name;
+    bool _is_dynamic;
+    std::size_t _head_size;
+    //===================
+    static AbiType parse(const std::string& type_name, const boost::property_tree::ptree* parameter);
+    static AbiType parseElementary(const std::string& name);
+    //===================
+};
+
+
+/**
+ *  @brief Encodes arguments, written as comma separated values, by given types.
+ *
+ *  Arguments are numbers, true/false, quoted strings, lists in square brackets for arrays and tuples
+ *  and Address(<base58>) for addresses. Bytes are given as hex strings.
+ *
+ *  @throws base::InvalidArgument if arguments don't match the types.
+ */
+base::Bytes abiEncode(const std::vector<AbiType>& types, const std::string& arguments);
+
+/**
+ *  @brief Decodes data by given types into a json object mapping names to values.
+ *
+ *  Integers are written as numbers, bytes as hex strings, addresses as base58 strings.
+ *
+ *  @throws base::InvalidArgument if data doesn't match the types.
+ */
+std::string abiDecode(const std::vector<AbiType>& types,
+                      const std::vector<std::string>& names,
+                      const base::Bytes& data);
+
+
+class AbiFunction
+{
+  public:
+    //===================
+    static constexpr std::size_t SELECTOR_SIZE = 4;
+    //===================
+    explicit AbiFunction(const boost::property_tree::ptree& function_abi);
+    //===================
+    const std::string& getName() const noexcept;
+    const std::string& getSignature() const noexcept;
+    const base::FixedBytes<SELECTOR_SIZE>& getSelector() const noexcept;
+    const std::vector<AbiType>& getInputs() const noexcept;
+    const std::vector<AbiType>& getOutputs() const noexcept;
+    //===================
+    // returns selector followed by encoded arguments
+    base::Bytes encodeCall(const std::string& arguments) const;
+
+    // decodes return data, which doesn't include selector
+    std::string decodeOutput(const base::Bytes& data) const;
+    //===================
+  private:
+    std::string _name;
+    std::vector<AbiType> _inputs;
+    std::vector<AbiType> _outputs;
+    std::vector<std::string> _output_names;
+    std::string _signature;
+    base::FixedBytes<SELECTOR_SIZE> _selector;
+};
+
+
+/// ABI of a compiled contract, built from its metadata.json.
+class ContractAbi
+{
+  public:
+    //===================
+    explicit ContractAbi(const boost::property_tree::ptree& metadata);
+    //===================
+    const std::vector<AbiFunction>& getFunctions() const noexcept;
+
+    // finds function with the name, which inputs accept given arguments
+    const AbiFunction& findFunction(const std::string& name, const std::string& arguments) const;
+
+    const AbiFunction& findFunction(const base::FixedBytes<AbiFunction::SELECTOR_SIZE>& selector) const;
+    //===================
+    // call is written as name(arguments); constructor(arguments) gives bytecode followed by encoded arguments
+    base::Bytes encodeCall(const std::string& call, const base::Bytes& bytecode) const;
+
+    // output starts with the selector of the called function, as the output of a contract call does
+    std::string decodeOutput(const base::Bytes& output) const;
+    //===================
+  private:
+    //===================
+    std::vector<AbiFunction> _functions;
+    std::vector<AbiType> _constructor_inputs;
+    //===================
+    std::unordered_map<base::FixedBytes<AbiFunction::SELECTOR_SIZE>, std::size_t> _functions_by_selector;
+    std::unordered_map<std::string, std::vector<std::size_t>> _overloads_by_name;
+    //===================
+    const std::vector<std::size_t>& getOverloads(const std::string& name) const;
+    //===================
+};
+
+} // namespace vm
@@ -0,0 +1,109 @@
+#include "abi_registry.hpp"
+
+#include "base/error.hpp"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+
+constexpr const char* CODE_FILE_NAME = "compiled_code.bin";
+constexpr const char* METADATA_FILE_NAME = "metadata.json";
+
+
+std::filesystem::file_time_type getWriteTime(const std::filesystem::path& file_path, const char* description)
+{
+    std::error_code ec;
+    auto ret = std::filesystem::last_write_time(file_path, ec);
+    if (ec) {
+        RAISE_ERROR(base::InvalidArgument, std::string{ description } + " file not exists");
+    }
+    return ret;
+}
+
+
+base::Bytes readBytecode(const std::filesystem::path& file_path)
+{
+    std::ifstream file(file_path, std::ios::binary);
+    std::string bytecode_hex(std::istreambuf_iterator<char>(file), {});
+    boost::algorithm::trim(bytecode_hex);
+    return base::fromHex<base::Bytes>(bytecode_hex);
+}
+
+
+boost::property_tree::ptree readMetadata(const std::filesystem::path& file_path)
+{
+    boost::property_tree::ptree metadata;
+    try {
+        boost::property_tree::read_json(file_path, metadata);
+    }
+    catch (const boost::property_tree::json_parser_error& e) {
+        RAISE_ERROR(base::RuntimeError, "Error during json file reading");
+    }
+    return metadata;
+}
+
+} // namespace
+
+
+namespace vm
+{
+
+std::shared_ptr<const AbiRegistry::Contract> AbiRegistry::load(const std::filesystem::path& code_folder)
+{
+    const auto code_path = code_folder / CODE_FILE_NAME;
+    const auto metadata_path = code_folder / METADATA_FILE_NAME;
+    const auto code_write_time = getWriteTime(code_path, "Contract");
+    const auto metadata_write_time = getWriteTime(metadata_path, "Contract metadata");
+    const auto key = std::filesystem::weakly_canonical(code_folder).string();
+
+    {
+        std::lock_guard lk(_mutex);
+        if (auto it = _by_folder.find(key); it != _by_folder.end() && it->second.code_write_time == code_write_time &&
+                                            it->second.metadata_write_time == metadata_write_time) {
+            return it->second.contract;
+        }
+    }
+
+    // parsing is done without the lock, a concurrent load of the same folder just replaces the entry
+    auto bytecode = readBytecode(code_path);
+    auto code_hash = base::Keccak256::compute(bytecode);
+    auto contract = std::make_shared<const Contract>(
+      Contract{ std::move(bytecode), std::move(code_hash), ContractAbi{ readMetadata(metadata_path) } });
+
+    std::lock_guard lk(_mutex);
+    _by_folder[key] = FolderEntry{ code_write_time, metadata_write_time, contract };
+    _by_code_hash.insert_or_assign(contract->code_hash, contract);
+    return contract;
+}
+
+
+std::shared_ptr<const AbiRegistry::Contract> AbiRegistry::find(const base::Keccak256& code_hash) const
+{
+    std::lock_guard lk(_mutex);
+    if (auto it = _by_code_hash.find(code_hash); it != _by_code_hash.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+
+std::size_t AbiRegistry::size() const
+{
+    std::lock_guard lk(_mutex);
+    return _by_folder.size();
+}
+
+
+void AbiRegistry::clear()
+{
+    std::lock_guard lk(_mutex);
+    _by_folder.clear();
+    _by_code_hash.clear();
+}
+
+} // namespace vm
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "vm/abi.hpp"
+
+#include "base/bytes.hpp"
+#include "base/hash.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace vm
+{
+
+/// Keeps parsed ABI of compiled contracts, so that encoding and decoding don't read and parse metadata each time.
+class AbiRegistry
+{
+  public:
+    //===================
+    struct Contract
+    {
+        base::Bytes bytecode;
+        base::Keccak256 code_hash;
+        ContractAbi abi;
+    };
+    //===================
+    AbiRegistry() = default;
+    AbiRegistry(const AbiRegistry&) = delete;
+    AbiRegistry(AbiRegistry&&) = delete;
+    AbiRegistry& operator=(const AbiRegistry&) = delete;
+    AbiRegistry& operator=(AbiRegistry&&) = delete;
+    ~AbiRegistry() = default;
+    //===================
+    /**
+     *  @brief Returns contract from the folder with compiled_code.bin and metadata.json.
+     *
+     *  Files are read only on the first call and after they were modified.
+     *
+     *  @throws base::InvalidArgument if the folder doesn't contain a compiled contract.
+     *  @threadsafe
+     */
+    std::shared_ptr<const Contract> load(const std::filesystem::path& code_folder);
+
+    // returns nullptr if a contract with such code wasn't loaded
+    std::shared_ptr<const Contract> find(const base::Keccak256& code_hash) const;
+
+    std::size_t size() const;
+    void clear();
+    //===================
+  private:
+    //===================
+    struct FolderEntry
+    {
+        std::filesystem::file_time_type code_write_time;
+        std::filesystem::file_time_type metadata_write_time;
+        std::shared_ptr<const Contract> contract;
+    };
+    //===================
+    mutable std::mutex _mutex;
+    std::unordered_map<std::string, FolderEntry> _by_folder;
+    std::unordered_map<base::Keccak256, std::shared_ptr<const Contract>> _by_code_hash;
+    //===================
+};
+
+} // namespace vm
@@ -0,0 +1,70 @@
+#include "code_cache.hpp"
+
+#include <algorithm>
+
+namespace vm
+{
+
+CodeCache::Code CodeCache::intern(const base::Bytes& code)
+{
+    if (code.isEmpty()) {
+        return empty();
+    }
+
+    auto code_hash = base::Keccak256::compute(code);
+
+    std::lock_guard lk(_mutex);
+    auto& entry = _codes[code_hash];
+    if (auto cached = entry.lock()) {
+        ++_statistics.hits;
+        return cached;
+    }
+
+    ++_statistics.misses;
+    auto ret = std::make_shared<const base::Bytes>(code);
+    entry = ret;
+    if (_codes.size() >= _next_cleanup_size) {
+        removeExpired();
+    }
+    return ret;
+}
+
+
+CodeCache::Statistics CodeCache::getStatistics() const
+{
+    std::lock_guard lk(_mutex);
+    auto ret = _statistics;
+    ret.entries = _codes.size();
+    return ret;
+}
+
+
+const CodeCache::Code& CodeCache::empty()
+{
+    static const Code empty_code = std::make_shared<const base::Bytes>();
+    return empty_code;
+}
+
+
+void CodeCache::removeExpired()
+{
+    for (auto it = _codes.begin(); it != _codes.end();) {
+        if (it->second.expired()) {
+            it = _codes.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+    // amortized: the next sweep happens only after the number of entries doubles
+    _next_cleanup_size = std::max(MIN_CLEANUP_SIZE, _codes.size() * 2);
+}
+
+
+CodeCache& getCodeCache()
+{
+    static CodeCache cache;
+    return cache;
+}
+
+} // namespace vm
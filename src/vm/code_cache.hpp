@@ -0,0 +1,62 @@
+#pragma once
+
+#include "base/bytes.hpp"
+#include "base/hash.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace vm
+{
+
+/// Keeps a single immutable copy of every contract code, found by its hash. Accounts, copies of state and running
+/// calls share these copies instead of copying the code, which is up to 24KB per contract.
+class CodeCache
+{
+  public:
+    //===================
+    using Code = std::shared_ptr<const base::Bytes>;
+
+    struct Statistics
+    {
+        std::size_t hits{ 0 };    // interned code was already cached
+        std::size_t misses{ 0 };  // interned code was copied into the cache
+        std::size_t entries{ 0 }; // codes in the cache right now, including ones nobody uses anymore
+    };
+    //===================
+    CodeCache() = default;
+    CodeCache(const CodeCache&) = delete;
+    CodeCache(CodeCache&&) = delete;
+    CodeCache& operator=(const CodeCache&) = delete;
+    CodeCache& operator=(CodeCache&&) = delete;
+    ~CodeCache() = default;
+    //===================
+    // returns the cached copy of code, code is copied only if it is not in the cache yet
+    Code intern(const base::Bytes& code);
+
+    Statistics getStatistics() const;
+    //===================
+    // code shared by accounts without one
+    static const Code& empty();
+    //===================
+  private:
+    //===================
+    static constexpr std::size_t MIN_CLEANUP_SIZE = 64;
+    //===================
+    mutable std::mutex _mutex;
+    // code lives while an account or a call holds it
+    std::unordered_map<base::Keccak256, std::weak_ptr<const base::Bytes>> _codes;
+    std::size_t _next_cleanup_size{ MIN_CLEANUP_SIZE };
+    Statistics _statistics;
+    //===================
+    void removeExpired();
+    //===================
+};
+
+
+// cache used by the state of accounts
+CodeCache& getCodeCache();
+
+} // namespace vm
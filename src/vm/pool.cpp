@@ -0,0 +1,128 @@
+#include "pool.hpp"
+
+#include "vm/vm.hpp"
+
+#include "base/assert.hpp"
+#include "base/config.hpp"
+#include "base/log.hpp"
+
+#include <algorithm>
+
+namespace vm
+{
+
+Pool::Pool(std::size_t workers_count)
+{
+    ASSERT(workers_count > 0);
+
+    _vms.reserve(workers_count);
+    for (std::size_t i = 0; i < workers_count; ++i) {
+        _vms.push_back(vm::load());
+    }
+
+    _workers.reserve(workers_count);
+    for (auto& vm : _vms) {
+        _workers.emplace_back(&Pool::worker, this, std::ref(vm));
+    }
+
+    LOG_INFO << "VM pool is running on " << workers_count << " threads";
+}
+
+
+Pool::~Pool()
+{
+    {
+        std::lock_guard lk(_queue_mutex);
+        _is_stopping = true;
+    }
+    _queue_cv.notify_all();
+
+    for (auto& worker : _workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    // waiters get an error instead of a broken promise
+    for (auto& queued_job : _queue) {
+        queued_job.job(nullptr);
+    }
+}
+
+
+std::size_t Pool::getWorkersCount() const noexcept
+{
+    return _workers.size();
+}
+
+
+Pool::Statistics Pool::getStatistics() const
+{
+    std::lock_guard lk(_queue_mutex);
+    auto statistics = _statistics;
+    statistics.queued = _queue.size();
+    return statistics;
+}
+
+
+void Pool::enqueue(Job job, Clock::time_point deadline)
+{
+    {
+        std::lock_guard lk(_queue_mutex);
+        _queue.push_back({ std::move(job), Clock::now(), deadline });
+    }
+    _queue_cv.notify_one();
+}
+
+
+void Pool::worker(evmc::VM& vm)
+{
+    while (true) {
+        QueuedJob queued_job;
+        bool is_expired;
+        {
+            std::unique_lock lk(_queue_mutex);
+            _queue_cv.wait(lk, [this] { return _is_stopping || !_queue.empty(); });
+            if (_is_stopping) {
+                return;
+            }
+            queued_job = std::move(_queue.front());
+            _queue.pop_front();
+
+            const auto now = Clock::now();
+            const auto wait = std::chrono::duration_cast<std::chrono::microseconds>(now - queued_job.enqueued_at);
+            _statistics.total_wait += wait;
+            _statistics.max_wait = std::max(_statistics.max_wait, wait);
+            is_expired = now > queued_job.deadline;
+            if (is_expired) {
+                ++_statistics.expired;
+            }
+            else {
+                ++_statistics.executed;
+            }
+            reportIfNeeded();
+        }
+
+        if (is_expired) {
+            LOG_DEBUG << "VM pool job expired in the queue";
+            queued_job.job(nullptr);
+        }
+        else {
+            queued_job.job(&vm);
+        }
+    }
+}
+
+
+void Pool::reportIfNeeded() const
+{
+    const auto taken = _statistics.executed + _statistics.expired;
+    if (taken % base::config::VM_POOL_REPORT_PERIOD != 0) {
+        return;
+    }
+    LOG_INFO << "VM pool: " << _statistics.executed << " jobs executed, " << _statistics.expired << " expired, "
+             << _queue.size() << " queued, average wait " << (_statistics.total_wait / taken).count()
+             << "us, max wait " << _statistics.max_wait.count() << "us";
+}
+
+} // namespace vm
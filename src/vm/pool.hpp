@@ -0,0 +1,84 @@
+#pragma once
+
+#include <evmc/evmc.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace vm
+{
+
+/// Runs read-only VM jobs (views, gas estimation, simulation) on several threads, each having its own VM instance.
+/// Jobs must only work on state they own, since they may outlive the caller that gave up waiting.
+/// The destructor waits for running jobs, queued ones are failed with VmError.
+class Pool
+{
+  public:
+    //===================
+    using Clock = std::chrono::steady_clock;
+    //===================
+    struct Statistics
+    {
+        std::size_t queued{ 0 };   // jobs waiting for a worker right now
+        std::size_t executed{ 0 }; // jobs that were run
+        std::size_t expired{ 0 };  // jobs dropped, because their time budget ran out in the queue
+        std::chrono::microseconds total_wait{ 0 };
+        std::chrono::microseconds max_wait{ 0 };
+    };
+    //===================
+    explicit Pool(std::size_t workers_count);
+    Pool(const Pool&) = delete;
+    Pool(Pool&&) = delete;
+    Pool& operator=(const Pool&) = delete;
+    Pool& operator=(Pool&&) = delete;
+    ~Pool();
+    //===================
+    /**
+     *  @brief Runs f(evmc::VM&) on one of the workers and waits for its result.
+     *
+     *  @throws VmError if the job did not finish in time_budget. The job is then dropped, if it didn't start yet.
+     *  @threadsafe
+     */
+    template<typename F>
+    std::invoke_result_t<F, evmc::VM&> run(F f, std::chrono::milliseconds time_budget);
+    //===================
+    std::size_t getWorkersCount() const noexcept;
+    Statistics getStatistics() const;
+    //===================
+  private:
+    //===================
+    // a job is called with nullptr if it is dropped before any worker took it: expired or left on stop
+    using Job = std::function<void(evmc::VM*)>;
+
+    struct QueuedJob
+    {
+        Job job;
+        Clock::time_point enqueued_at;
+        Clock::time_point deadline;
+    };
+    //===================
+    std::vector<evmc::VM> _vms;
+    std::vector<std::thread> _workers;
+    //===================
+    mutable std::mutex _queue_mutex;
+    std::condition_variable _queue_cv;
+    std::deque<QueuedJob> _queue;
+    bool _is_stopping{ false };
+    Statistics _statistics;
+    //===================
+    void enqueue(Job job, Clock::time_point deadline);
+    void worker(evmc::VM& vm);
+    void reportIfNeeded() const;
+    //===================
+};
+
+} // namespace vm
+
+#include "pool.tpp"
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "pool.hpp"
+
+#include "vm/error.hpp"
+
+#include <future>
+#include <memory>
+
+namespace vm
+{
+
+template<typename F>
+std::invoke_result_t<F, evmc::VM&> Pool::run(F f, std::chrono::milliseconds time_budget)
+{
+    using ResultType = std::invoke_result_t<F, evmc::VM&>;
+
+    auto promise = std::make_shared<std::promise<ResultType>>();
+    auto result = promise->get_future();
+    auto deadline = Clock::now() + time_budget;
+
+    enqueue(
+      [promise, f = std::move(f)](evmc::VM* vm) mutable {
+          try {
+              if (!vm) {
+                  RAISE_ERROR(VmError, "job was dropped by vm pool before it started");
+              }
+              if constexpr (std::is_void_v<ResultType>) {
+                  f(*vm);
+                  promise->set_value();
+              }
+              else {
+                  promise->set_value(f(*vm));
+              }
+          }
+          catch (...) {
+              promise->set_exception(std::current_exception());
+          }
+      },
+      deadline);
+
+    if (result.wait_until(deadline) != std::future_status::ready) {
+        RAISE_ERROR(VmError, "time budget of vm pool job is exceeded");
+    }
+    return result.get();
+}
+
+} // namespace vm
@@ -56,10 +56,4 @@ std::optional<base::Bytes> encodeCall(const std::filesystem::path& path_to_code_
 
 std::optional<std::string> decodeOutput(const std::filesystem::path& path_to_code_folder, const std::string& output);
 
-std::string callPython(std::vector<std::string>& args);
-
-std::string encodeMessage(const std::string& contract_path, const std::string& data);
-
-std::string decodeMessage(const std::string& contract_path, const std::string& data);
-
 } // namespace vm
\ No newline at end of file
@@ -2,39 +2,36 @@
 
 #include "vm/error.hpp"
 
+#include "base/hash.hpp"
 #include "base/log.hpp"
 
 #include <evmc/loader.h>
 
 #include <boost/process.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include <unistd.h>
 
 #include <filesystem>
+#include <fstream>
+#include <map>
 #include <set>
+#include <sstream>
 
 namespace bp = ::boost::process;
 
 namespace
 {
 
-std::tuple<std::string, std::string> parseInfoLine(const std::string& path)
-{
-    constexpr std::size_t DELIM_SIZE = 8;
-    auto shrinked = path.substr(DELIM_SIZE, path.size() - DELIM_SIZE * 2);
-    auto delimiter_pos = shrinked.find(':');
-    auto source_file = shrinked.substr(0, delimiter_pos);
-    auto contract_name = shrinked.substr(delimiter_pos + 1, shrinked.size());
-    return std::make_tuple(source_file, contract_name);
-}
-
-
 std::vector<std::string> callCommand(const boost::filesystem::path& path_to_solc, const std::vector<std::string>& args)
 {
     bp::ipstream out;
     bp::child c(path_to_solc, args, bp::std_out > out);
 
+    // read until the end of the pipe, the process may exit before its output is read
     std::vector<std::string> out_put_result_values;
     std::string out_result;
-    while (c.running() && std::getline(out, out_result)) {
+    while (std::getline(out, out_result)) {
         out_put_result_values.push_back(out_result);
     }
     c.wait();
@@ -51,50 +48,123 @@ std::vector<std::string> callCommand(const boost::filesystem::path& path_to_solc
 }
 
 
-std::vector<std::pair<std::string, base::Bytes>> callCompilationCommand(const boost::filesystem::path& path_to_solc,
-                                                                        const std::string& path_to_solidity_file)
+// bytecode and metadata of every contract of the file in a single json
+std::string callCombinedJsonCommand(const boost::filesystem::path& path_to_solc,
+                                    const std::string& path_to_solidity_file)
 {
-    std::vector<std::string> args{ "--bin", path_to_solidity_file };
+    std::vector<std::string> args{ "--combined-json", "bin,metadata", path_to_solidity_file };
     auto res = callCommand(path_to_solc, args);
 
-    std::vector<std::pair<std::string, base::Bytes>> contracts_byte_codes;
-    constexpr const size_t GROUP_SIZE = 4;
-    for (std::size_t i = 0; i < res.size() / GROUP_SIZE; i++) {
-        auto current_contract_index = i * GROUP_SIZE;
+    std::string output;
+    for (const auto& line : res) {
+        output += line;
+    }
+    return output;
+}
+
 
-        auto info_line = res[current_contract_index + 1];
-        auto bytecode = base::fromHex<base::Bytes>(res[current_contract_index + 3]);
+struct CompilationOutput
+{
+    vm::Contracts contracts;
+    // keccak256 of every source file the contracts were compiled from, as metadata lists them
+    std::map<std::string, std::string> source_hashes;
+};
 
-        auto info = parseInfoLine(info_line);
 
-        contracts_byte_codes.push_back({ std::get<1>(info), std::move(bytecode) });
-    }
+CompilationOutput parseCombinedJson(const std::string& combined_json)
+{
+    CompilationOutput ret;
+    try {
+        boost::property_tree::ptree output;
+        std::istringstream output_stream{ combined_json };
+        boost::property_tree::read_json(output_stream, output);
+
+        // keys are "<source file>:<contract name>" and may contain dots, so children are iterated directly
+        for (const auto& [key, contract_output] : output.get_child("contracts")) {
+            vm::CompiledContract contract{ key.substr(key.rfind(':') + 1) };
+            contract.code = base::fromHex<base::Bytes>(contract_output.get<std::string>("bin"));
+
+            auto metadata_json = contract_output.get<std::string>("metadata");
+            contract.metadata = base::parseJson(metadata_json);
+
+            boost::property_tree::ptree metadata;
+            std::istringstream metadata_stream{ metadata_json };
+            boost::property_tree::read_json(metadata_stream, metadata);
+            for (const auto& [source_path, source] : metadata.get_child("sources")) {
+                ret.source_hashes[source_path] = source.get<std::string>("keccak256");
+            }
 
-    return contracts_byte_codes;
+            ret.contracts.push_back(std::move(contract));
+        }
+    }
+    catch (const boost::property_tree::ptree_error& e) {
+        RAISE_ERROR(base::ParsingError, std::string{ "invalid compiler output: " } + e.what());
+    }
+    return ret;
 }
 
 
-std::vector<std::pair<std::string, base::PropertyTree>> callMetadataCommand(const boost::filesystem::path& path_to_solc,
-                                                                            const std::string& path_to_solidity_file)
+std::optional<base::Bytes> readFile(const std::filesystem::path& path)
 {
-    std::vector<std::string> args{ "--metadata", path_to_solidity_file };
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return std::nullopt;
+    }
+    return base::Bytes(std::vector<base::Byte>(std::istreambuf_iterator<char>(file), {}));
+}
 
-    auto res = callCommand(path_to_solc, args);
 
-    std::vector<std::pair<std::string, base::PropertyTree>> contracts_metadatas;
-    constexpr const size_t GROUP_SIZE = 4;
-    for (std::size_t i = 0; i < res.size() / GROUP_SIZE; i++) {
-        auto current_contract_index = i * GROUP_SIZE;
+// the source file itself and everything it imports must still be the same, as it was compiled
+bool sourcesAreUnchanged(const std::map<std::string, std::string>& source_hashes)
+{
+    for (const auto& [source_path, keccak] : source_hashes) {
+        auto content = readFile(source_path);
+        if (!content || "0x" + base::Keccak256::compute(*content).toHex() != keccak) {
+            return false;
+        }
+    }
+    return true;
+}
+
 
-        auto info_line = res[current_contract_index + 1];
-        auto metadata = base::parseJson(res[current_contract_index + 3]);
+// hash of the source and of the compiler binary, so that an updated solc doesn't get outputs of the old one.
+// Imports are resolved relative to the source file and recorded relative to the working directory,
+// so both are in the key: the same text in another folder may import other files
+base::Sha256 calcCompilationKey(const boost::filesystem::path& path_to_solc,
+                                const std::string& path_to_solidity_file,
+                                const base::Bytes& source)
+{
+    auto solc_path = boost::filesystem::canonical(path_to_solc);
+    auto solc_identity = solc_path.string() + '|' + std::to_string(boost::filesystem::file_size(solc_path)) + '|' +
+                         std::to_string(boost::filesystem::last_write_time(solc_path)) + '|';
+    auto source_identity = std::filesystem::canonical(path_to_solidity_file).string() + '|' +
+                           std::filesystem::current_path().string() + '|';
+    return base::Sha256::compute(base::Bytes(solc_identity + source_identity) + source);
+}
 
-        auto info = parseInfoLine(info_line);
 
-        contracts_metadatas.push_back({ std::get<1>(info), std::move(metadata) });
+void saveToCache(const std::filesystem::path& entry_path, const std::string& combined_json)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(entry_path.parent_path(), ec);
+
+    // written aside and renamed, so that a concurrent compilation never reads a partial entry
+    auto tmp_path = entry_path;
+    tmp_path += ".tmp" + std::to_string(::getpid());
+    {
+        std::ofstream file(tmp_path, std::ios::binary);
+        file << combined_json;
+        if (!file) {
+            LOG_WARNING << "failed to write compilation cache entry " << entry_path;
+            std::filesystem::remove(tmp_path, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tmp_path, entry_path, ec);
+    if (ec) {
+        LOG_WARNING << "failed to write compilation cache entry " << entry_path << ": " << ec.message();
+        std::filesystem::remove(tmp_path, ec);
     }
-
-    return contracts_metadatas;
 }
 
 
@@ -105,6 +175,16 @@ std::string compilerName()
 }
 
 
+boost::filesystem::path findCompiler()
+{
+    boost::filesystem::path path_to_solc{ bp::search_path(compilerName()) };
+    if (!boost::filesystem::exists(path_to_solc)) {
+        RAISE_ERROR(base::InaccessibleFile, "Solidity compiler was not found");
+    }
+    return path_to_solc;
+}
+
+
 std::filesystem::path getVmPath()
 {
     static const std::filesystem::path lib_name = std::filesystem::absolute("libevmone.so.0.4");
@@ -140,29 +220,38 @@ CompiledContract::CompiledContract(std::string _name)
 
 std::optional<Contracts> compile(const std::string& path_to_solidity_file)
 {
-    boost::filesystem::path path_to_solc{ bp::search_path(compilerName()) };
-    if (!boost::filesystem::exists(path_to_solc)) {
-        RAISE_ERROR(base::InaccessibleFile, "Solidity compiler was not found");
-    }
+    auto path_to_solc = findCompiler();
+    return parseCombinedJson(callCombinedJsonCommand(path_to_solc, path_to_solidity_file)).contracts;
+}
 
-    auto compilation_output = callCompilationCommand(path_to_solc, path_to_solidity_file);
-    auto metadata_output = callMetadataCommand(path_to_solc, path_to_solidity_file);
 
-    Contracts contracts{};
-    for (const auto& contract_name_full_code_pair : compilation_output) {
-        CompiledContract contract{ contract_name_full_code_pair.first };
-        contract.code = contract_name_full_code_pair.second;
+std::optional<Contracts> compile(const std::string& path_to_solidity_file, const std::filesystem::path& cache_folder)
+{
+    auto path_to_solc = findCompiler();
+    auto source = readFile(path_to_solidity_file);
+    if (!source) {
+        RAISE_ERROR(base::InaccessibleFile, "cannot read " + path_to_solidity_file);
+    }
 
-        for (const auto& contract_name_metadata_pair : metadata_output) {
-            if (contract_name_metadata_pair.first == contract.name) {
-                contract.metadata = contract_name_metadata_pair.second;
+    auto entry_path =
+      cache_folder / (calcCompilationKey(path_to_solc, path_to_solidity_file, *source).toHex() + ".json");
+    if (auto cached = readFile(entry_path)) {
+        try {
+            auto output = parseCombinedJson(cached->toString());
+            if (sourcesAreUnchanged(output.source_hashes)) {
+                LOG_DEBUG << "compilation of " << path_to_solidity_file << " is taken from " << entry_path;
+                return std::move(output.contracts);
             }
         }
-
-        contracts.push_back(std::move(contract));
+        catch (const base::ParsingError& e) {
+            LOG_WARNING << "broken compilation cache entry " << entry_path << " is ignored";
+        }
     }
 
-    return contracts;
+    auto combined_json = callCombinedJsonCommand(path_to_solc, path_to_solidity_file);
+    auto output = parseCombinedJson(combined_json);
+    saveToCache(entry_path, combined_json);
+    return std::move(output.contracts);
 }
 
 
@@ -10,6 +10,8 @@
 
 #include <boost/filesystem.hpp>
 
+#include <filesystem>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -37,6 +39,9 @@ using Contracts = std::vector<CompiledContract>;
 
 std::optional<Contracts> compile(const std::string& path_to_solidity_file);
 
+// same as compile, but outputs are kept in cache_folder and reused while the sources and the compiler are the same
+std::optional<Contracts> compile(const std::string& path_to_solidity_file, const std::filesystem::path& cache_folder);
+
 
 evmc::VM load();
 
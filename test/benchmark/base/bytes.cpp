@@ -0,0 +1,95 @@
+#include "benchmark.hpp"
+
+#include "base/bytes.hpp"
+
+
+namespace
+{
+
+template<std::size_t S>
+base::FixedBytes<S> makeFixedBytes()
+{
+    base::FixedBytes<S> ret;
+    for (std::size_t i = 0; i < S; ++i) {
+        ret[i] = static_cast<base::Byte>(i * 89 + 17);
+    }
+    return ret;
+}
+
+} // namespace
+
+
+BENCHMARK_CASE(bytes_base58_address)
+{
+    auto address = makeFixedBytes<20>();
+    auto general = address.toBytes();
+    auto encoded = base::base58Encode(address);
+
+    // Bytes of other sizes still go through the general byte-at-a-time implementation
+    base::Bytes general_21(21);
+    for (std::size_t i = 0; i < general_21.size(); ++i) {
+        general_21[i] = static_cast<base::Byte>(i * 89 + 17);
+    }
+
+    benchmark::measure("base58 encode 20 bytes fixed", [&] { benchmark::doNotOptimize(base::base58Encode(address)); });
+    benchmark::measure("base58 encode 20 bytes Bytes", [&] { benchmark::doNotOptimize(base::base58Encode(general)); });
+    benchmark::measure("base58 encode 21 bytes general",
+                       [&] { benchmark::doNotOptimize(base::base58Encode(general_21)); });
+    benchmark::measure("base58 decode 20 bytes fixed",
+                       [&] { benchmark::doNotOptimize(base::base58Decode<20>(encoded)); });
+    benchmark::measure("base58 decode 20 bytes general",
+                       [&] { benchmark::doNotOptimize(base::base58Decode(encoded)); });
+}
+
+
+BENCHMARK_CASE(bytes_base58_checked_address)
+{
+    auto address = makeFixedBytes<25>();
+    auto encoded = base::base58Encode(address);
+
+    benchmark::measure("base58 encode 25 bytes fixed", [&] { benchmark::doNotOptimize(base::base58Encode(address)); });
+    benchmark::measure("base58 decode 25 bytes fixed",
+                       [&] { benchmark::doNotOptimize(base::base58Decode<25>(encoded)); });
+    benchmark::measure("base58 decode 25 bytes general",
+                       [&] { benchmark::doNotOptimize(base::base58Decode(encoded)); });
+}
+
+
+BENCHMARK_CASE(bytes_hex_and_base64)
+{
+    base::Bytes data(4096);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<base::Byte>(i * 89 + 17);
+    }
+    auto hex = base::toHex(data);
+    auto base64 = base::base64Encode(data);
+
+    benchmark::measure("hex encode 4 KiB", [&] { benchmark::doNotOptimize(base::toHex(data)); }, data.size());
+    benchmark::measure(
+      "hex decode 4 KiB", [&] { benchmark::doNotOptimize(base::fromHex<base::Bytes>(hex)); }, data.size());
+    benchmark::measure("base64 encode 4 KiB", [&] { benchmark::doNotOptimize(base::base64Encode(data)); }, data.size());
+    benchmark::measure(
+      "base64 decode 4 KiB", [&] { benchmark::doNotOptimize(base::base64Decode(base64)); }, data.size());
+
+    // streaming variants reuse the caller's buffers, so nothing is allocated per call
+    std::string text_buffer(hex.size(), '\0');
+    base::Bytes bytes_buffer(data.size());
+    benchmark::measure(
+      "hex encode 4 KiB into buffer",
+      [&] {
+          base::toHexInto(data, text_buffer.data());
+          benchmark::doNotOptimize(text_buffer);
+      },
+      data.size());
+    benchmark::measure(
+      "base64 decode 4 KiB into buffer",
+      [&] {
+          base::base64DecodeInto(base64, bytes_buffer.getData());
+          benchmark::doNotOptimize(bytes_buffer);
+      },
+      data.size());
+
+    // a hash is the most common thing converted to hex
+    auto hash = makeFixedBytes<32>();
+    benchmark::measure("hex encode 32 bytes", [&] { benchmark::doNotOptimize(base::toHex(hash)); });
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace benchmark
+{
+
+using CaseFunction = void (*)();
+
+class Registrar
+{
+  public:
+    Registrar(const char* name, CaseFunction f);
+};
+
+// calls f repeatedly for a fixed amount of time and prints an average time of a single call;
+// if bytes_per_call is not 0, then throughput is printed as well
+void measure(const std::string& label, const std::function<void()>& f, std::size_t bytes_per_call = 0);
+
+// calls f repeatedly and prints an average number of heap allocations made by a single call
+void countAllocations(const std::string& label, const std::function<void()>& f);
+
+// prints a value that is not a timing, e.g. a size, aligned with the output of measure
+void report(const std::string& label, double value, const std::string& unit);
+
+// prevents compiler from throwing away computation, which result is not used
+template<typename T>
+inline void doNotOptimize(const T& value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+} // namespace benchmark
+
+
+#define BENCHMARK_CASE(name)                                                                                           \
+    static void name();                                                                                                \
+    static const benchmark::Registrar name##_registrar{ #name, &name };                                                \
+    static void name()
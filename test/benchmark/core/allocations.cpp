@@ -0,0 +1,89 @@
+#include "benchmark.hpp"
+#include "core/samples.hpp"
+
+#include "base/arena.hpp"
+#include "base/config.hpp"
+#include "base/serialization.hpp"
+#include "core/messages.hpp"
+#include "core/transactions_set.hpp"
+
+namespace
+{
+
+// the same steps as Requests::prepareMessage and Session::send take to put a message on the wire
+template<typename T>
+base::Bytes frameMessage(const T& msg)
+{
+    base::SerializationOArchive oa;
+    oa.reserve(sizeof(std::uint16_t) + sizeof(T::TYPE_ID) + base::serializedSize(msg));
+    oa.serialize(std::uint16_t{ 1 });
+    oa.serialize(T::TYPE_ID);
+    oa.serialize(msg);
+    auto payload = std::move(oa).getBytes();
+    return base::toBytes(static_cast<std::uint16_t>(payload.size())) + payload;
+}
+
+
+// the same steps as Session::receive and Peer::process take to get a message from the wire
+template<typename T>
+T parseMessage(const base::Bytes& frame)
+{
+    auto length = base::fromBytes<std::uint16_t>(frame.takePart(0, sizeof(std::uint16_t)));
+    auto payload = base::BytesView(frame).subView(sizeof(std::uint16_t), sizeof(std::uint16_t) + length);
+    base::SerializationIArchive ia(payload);
+    ia.deserialize<std::uint16_t>();
+    ia.deserialize<lk::msg::Type>();
+    return ia.deserialize<T>();
+}
+
+
+template<typename T>
+void countMessageAllocations(const std::string& name, const T& msg)
+{
+    auto frame = frameMessage(msg);
+    benchmark::countAllocations("send " + name, [&] { benchmark::doNotOptimize(frameMessage(msg)); });
+    benchmark::countAllocations("receive " + name, [&] { benchmark::doNotOptimize(parseMessage<T>(frame)); });
+}
+
+} // namespace
+
+
+BENCHMARK_CASE(allocations_block_import)
+{
+    // what PersistentBlockchain does with a block: decode it, build its database key and encode it back
+    auto block = samples::makeBlock();
+    auto stored = base::toBytes(block, base::SerializationFormat::COMPACT);
+
+    benchmark::countAllocations("load block", [&] {
+        benchmark::doNotOptimize(base::fromBytes<lk::ImmutableBlock>(stored, base::SerializationFormat::COMPACT));
+    });
+    benchmark::countAllocations("store block", [&] {
+        base::Bytes key;
+        key.append(base::Byte{ 4 });
+        key.append(base::Bytes(block.getHash().getBytes()));
+        benchmark::doNotOptimize(key);
+        benchmark::doNotOptimize(base::toBytes(block, base::SerializationFormat::COMPACT));
+    });
+}
+
+
+BENCHMARK_CASE(allocations_block_checks)
+{
+    // balances map, which Core builds to check a block, on the heap and in the per-block arena
+    auto block = samples::makeBlock();
+
+    benchmark::countAllocations("block cost on heap",
+                                [&] { benchmark::doNotOptimize(lk::calcCost(block.getTransactions())); });
+    benchmark::countAllocations("block cost in arena", [&] {
+        base::Arena block_arena{ base::config::BC_BLOCK_ARENA_INITIAL_SIZE };
+        benchmark::doNotOptimize(lk::calcCost(block.getTransactions(), &block_arena));
+    });
+}
+
+
+BENCHMARK_CASE(allocations_message_handling)
+{
+    countMessageAllocations("ping", lk::msg::Ping{});
+    countMessageAllocations("get block", lk::msg::GetBlock{ base::Sha256::compute(base::Bytes("block")) });
+    countMessageAllocations("transaction", lk::msg::Transaction{ samples::makeTransaction(0) });
+}
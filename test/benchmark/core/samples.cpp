@@ -0,0 +1,85 @@
+#include "samples.hpp"
+
+#include "base/config.hpp"
+
+#include <random>
+
+namespace
+{
+
+std::mt19937_64& getGenerator()
+{
+    static std::mt19937_64 generator{ 0x5eed };
+    return generator;
+}
+
+
+template<typename T>
+T randomBytes(std::size_t size)
+{
+    T ret(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        ret[i] = static_cast<base::Byte>(getGenerator()());
+    }
+    return ret;
+}
+
+
+template<std::size_t S>
+base::FixedBytes<S> randomFixedBytes()
+{
+    base::FixedBytes<S> ret;
+    for (std::size_t i = 0; i < S; ++i) {
+        ret[i] = static_cast<base::Byte>(getGenerator()());
+    }
+    return ret;
+}
+
+} // namespace
+
+
+namespace samples
+{
+
+lk::Transaction makeTransaction(std::size_t data_size)
+{
+    auto& g = getGenerator();
+    return lk::Transaction{ lk::Address{ randomFixedBytes<lk::Address::LENGTH_IN_BYTES>() },
+                            lk::Address{ randomFixedBytes<lk::Address::LENGTH_IN_BYTES>() },
+                            lk::Balance{ g() } * lk::Balance{ g() },
+                            g() % 1'000'000 + 1,
+                            base::Time(static_cast<std::uint_least32_t>(g())),
+                            randomBytes<base::Bytes>(data_size),
+                            randomFixedBytes<base::Secp256PrivateKey::SECP256_SIGNATURE_SIZE>() };
+}
+
+
+lk::ImmutableBlock makeBlock(lk::BlockDepth depth)
+{
+    static constexpr std::size_t CONTRACT_CODE_SIZE = 4 * 1024;
+    static constexpr std::size_t CALL_DATA_SIZE = 68;
+
+    lk::TransactionsSet txs;
+    for (std::size_t i = 0; i < base::config::BC_MAX_TRANSACTIONS_IN_BLOCK; ++i) {
+        if (i % 5 == 0) {
+            txs.add(makeTransaction(CONTRACT_CODE_SIZE));
+        }
+        else if (i % 5 == 1) {
+            txs.add(makeTransaction(CALL_DATA_SIZE));
+        }
+        else {
+            txs.add(makeTransaction(0));
+        }
+    }
+
+    lk::BlockBuilder b;
+    b.setDepth(depth);
+    b.setNonce(getGenerator()());
+    b.setPrevBlockHash(base::Sha256::compute(randomBytes<base::Bytes>(32)));
+    b.setTimestamp(base::Time::now());
+    b.setCoinbase(lk::Address{ randomFixedBytes<lk::Address::LENGTH_IN_BYTES>() });
+    b.setTransactionsSet(std::move(txs));
+    return std::move(b).buildImmutable();
+}
+
+} // namespace samples
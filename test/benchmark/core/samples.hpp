@@ -0,0 +1,15 @@
+#pragma once
+
+#include "core/block.hpp"
+#include "core/transaction.hpp"
+
+namespace samples
+{
+
+// transaction with random addresses, amount and signature and data_size random bytes of data
+lk::Transaction makeTransaction(std::size_t data_size);
+
+// block filled up to the limit of transactions, every fifth of which carries contract bytecode
+lk::ImmutableBlock makeBlock(lk::BlockDepth depth = 1);
+
+} // namespace samples
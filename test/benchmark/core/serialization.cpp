@@ -0,0 +1,108 @@
+#include "benchmark.hpp"
+#include "core/samples.hpp"
+
+#include "base/serialization.hpp"
+
+
+BENCHMARK_CASE(serialization_block)
+{
+    auto block = samples::makeBlock();
+    auto serialized = base::toBytes(block);
+
+    benchmark::measure("serialize block", [&] { benchmark::doNotOptimize(base::toBytes(block)); }, serialized.size());
+    benchmark::measure(
+      "deserialize block",
+      [&] { benchmark::doNotOptimize(base::fromBytes<lk::ImmutableBlock>(serialized)); },
+      serialized.size());
+}
+
+
+BENCHMARK_CASE(serialization_bytes)
+{
+    base::Bytes code(24 * 1024);
+    auto serialized = base::toBytes(code);
+
+    benchmark::measure("serialize 24KB bytes", [&] { benchmark::doNotOptimize(base::toBytes(code)); }, code.size());
+    benchmark::measure(
+      "deserialize 24KB bytes",
+      [&] { benchmark::doNotOptimize(base::fromBytes<base::Bytes>(serialized)); },
+      code.size());
+}
+
+
+BENCHMARK_CASE(serialization_transaction)
+{
+    auto tx = samples::makeTransaction(0);
+    auto serialized = base::toBytes(tx);
+
+    benchmark::measure(
+      "serialize transaction", [&] { benchmark::doNotOptimize(base::toBytes(tx)); }, serialized.size());
+    benchmark::measure(
+      "deserialize transaction",
+      [&] { benchmark::doNotOptimize(base::fromBytes<lk::Transaction>(serialized)); },
+      serialized.size());
+
+    const auto compact = base::SerializationFormat::COMPACT;
+    auto serialized_compact = base::toBytes(tx, compact);
+    benchmark::measure(
+      "serialize transaction compact",
+      [&] { benchmark::doNotOptimize(base::toBytes(tx, compact)); },
+      serialized_compact.size());
+    benchmark::measure(
+      "deserialize transaction compact",
+      [&] { benchmark::doNotOptimize(base::fromBytes<lk::Transaction>(serialized_compact, compact)); },
+      serialized_compact.size());
+}
+
+
+BENCHMARK_CASE(serialization_balance)
+{
+    // FIXED keeps the decimal format hashes are built on, COMPACT stores the binary one
+    const auto compact = base::SerializationFormat::COMPACT;
+    lk::Balance balance{ "1000000000000000000000000" };
+    auto binary = base::toBytes(balance, compact);
+    auto decimal = base::toBytes(balance);
+
+    benchmark::measure("serialize balance binary", [&] { benchmark::doNotOptimize(base::toBytes(balance, compact)); });
+    benchmark::measure("serialize balance decimal", [&] { benchmark::doNotOptimize(base::toBytes(balance)); });
+    benchmark::measure("deserialize balance binary",
+                       [&] { benchmark::doNotOptimize(base::fromBytes<lk::Balance>(binary, compact)); });
+    benchmark::measure(
+      "deserialize balance decimal", [&] { benchmark::doNotOptimize(base::fromBytes<lk::Balance>(decimal)); });
+}
+
+
+BENCHMARK_CASE(serialization_compact_format)
+{
+    static constexpr std::size_t CHAIN_LENGTH = 16;
+    std::size_t fixed_size = 0;
+    std::size_t compact_size = 0;
+    for (lk::BlockDepth depth = 1; depth <= CHAIN_LENGTH; ++depth) {
+        auto block = samples::makeBlock(depth);
+        fixed_size += base::toBytes(block).size();
+        compact_size += base::toBytes(block, base::SerializationFormat::COMPACT).size();
+    }
+    benchmark::report("fixed bytes per block", static_cast<double>(fixed_size) / CHAIN_LENGTH, "B");
+    benchmark::report("compact bytes per block", static_cast<double>(compact_size) / CHAIN_LENGTH, "B");
+    benchmark::report("compact saving", 100.0 * static_cast<double>(fixed_size - compact_size) / fixed_size, "%");
+
+    // the generated blocks are dominated by contract code, which no format shrinks, so plain transfers are shown apart
+    auto transfer = samples::makeTransaction(0);
+    auto fixed_transfer_size = base::toBytes(transfer).size();
+    auto compact_transfer_size = base::toBytes(transfer, base::SerializationFormat::COMPACT).size();
+    benchmark::report("fixed bytes per transfer", static_cast<double>(fixed_transfer_size), "B");
+    benchmark::report("compact bytes per transfer", static_cast<double>(compact_transfer_size), "B");
+
+    auto block = samples::makeBlock();
+    auto compact = base::toBytes(block, base::SerializationFormat::COMPACT);
+    benchmark::measure(
+      "serialize block compact",
+      [&] { benchmark::doNotOptimize(base::toBytes(block, base::SerializationFormat::COMPACT)); },
+      compact.size());
+    benchmark::measure(
+      "deserialize block compact",
+      [&] {
+          benchmark::doNotOptimize(base::fromBytes<lk::ImmutableBlock>(compact, base::SerializationFormat::COMPACT));
+      },
+      compact.size());
+}
@@ -0,0 +1,129 @@
+#include "benchmark.hpp"
+
+#include "base/config.hpp"
+#include "core/managers.hpp"
+
+#include <cstring>
+#include <memory>
+
+namespace
+{
+
+constexpr std::size_t ACCOUNTS_COUNT = 1'000'000;
+constexpr std::size_t CONTRACT_STORAGE_SLOTS = 1'000;
+
+
+lk::Address makeAddress(std::uint64_t index)
+{
+    base::FixedBytes<lk::Address::LENGTH_IN_BYTES> raw;
+    std::memcpy(raw.getData(), &index, sizeof(index));
+    return lk::Address{ raw };
+}
+
+
+base::Sha256 makeKey(std::uint64_t index)
+{
+    return base::Sha256::compute(base::toBytes(index));
+}
+
+
+// clients with balances and a contract with a filled storage, as the state of a long living chain
+void fillState(lk::StateManager& state, const lk::Address& contract_address)
+{
+    for (std::uint64_t i = 0; i < ACCOUNTS_COUNT; ++i) {
+        state.getAccount(makeAddress(i)).setBalance(1'000'000);
+    }
+    auto& contract = state.getAccount(contract_address);
+    for (std::uint64_t i = 0; i < CONTRACT_STORAGE_SLOTS; ++i) {
+        contract.setStorageValue(makeKey(i), base::Bytes(32));
+    }
+}
+
+
+// what a contract call does with the state: a transfer with a fee and a couple of storage writes
+void performCall(lk::StateManager& state, const lk::Address& contract_address, std::uint64_t i)
+{
+    const auto from = makeAddress(i % ACCOUNTS_COUNT);
+    state.getAccount(from).subBalance(10);
+    state.tryTransferMoney(from, contract_address, 1);
+    auto& contract = state.getAccount(contract_address);
+    contract.setStorageValue(makeKey(i % CONTRACT_STORAGE_SLOTS), base::toBytes(i));
+    contract.setStorageValue(makeKey((i + 1) % CONTRACT_STORAGE_SLOTS), base::toBytes(i));
+}
+
+} // namespace
+
+
+BENCHMARK_CASE(state_transaction_1m_accounts)
+{
+    lk::StateManager state;
+    const auto contract_address = makeAddress(ACCOUNTS_COUNT);
+    fillState(state, contract_address);
+    std::uint64_t i = 0;
+
+    // how transactions were isolated before the journal: on a copy of the state, that replaces it on success
+    benchmark::measure("call on a copy of the state", [&] {
+        auto tx_state = state.createCopy();
+        performCall(tx_state, contract_address, ++i);
+        state.applyChanges(std::move(tx_state));
+    });
+    benchmark::measure("call in a committed state transaction", [&] {
+        lk::StateTransaction tx{ state };
+        performCall(state, contract_address, ++i);
+        tx.commit();
+    });
+    benchmark::measure("call in a rolled back state transaction", [&] {
+        lk::StateTransaction tx{ state };
+        performCall(state, contract_address, ++i);
+        tx.rollback();
+    });
+    // how read-only calls are isolated: on an overlay of the snapshot, that is shared by all of them
+    auto snapshot = state.makeSnapshot(nullptr);
+    benchmark::measure("call on an overlay of a snapshot", [&] {
+        lk::StateManager overlay{ snapshot };
+        performCall(overlay, contract_address, ++i);
+    });
+    benchmark::measure("call with a nested failed call", [&] {
+        lk::StateTransaction tx{ state };
+        performCall(state, contract_address, ++i);
+        {
+            lk::StateTransaction nested{ state };
+            performCall(state, contract_address, ++i);
+        }
+        tx.commit();
+    });
+}
+
+
+// the state work of Core::_tryAddBlock: every transaction of a full block is applied in its own state transaction,
+// then the snapshot, that is read by RPC and view calls, is made under the exclusive lock of the blockchain
+BENCHMARK_CASE(core_block_processing_1m_accounts)
+{
+    lk::StateManager state;
+    const auto contract_address = makeAddress(ACCOUNTS_COUNT);
+    fillState(state, contract_address);
+    std::uint64_t i = 0;
+
+    const auto applyBlock = [&] {
+        for (std::size_t tx_index = 0; tx_index < base::config::BC_MAX_TRANSACTIONS_IN_BLOCK; ++tx_index) {
+            lk::StateTransaction tx{ state };
+            performCall(state, contract_address, ++i);
+            tx.commit();
+        }
+    };
+
+    auto snapshot = state.makeSnapshot(nullptr);
+    benchmark::measure("block with a copy of the state for the snapshot", [&] {
+        applyBlock();
+        snapshot = state.makeSnapshot(nullptr);
+    });
+    benchmark::measure("block with a snapshot of changed accounts", [&] {
+        applyBlock();
+        snapshot = state.makeSnapshot(snapshot);
+    });
+    // reads go through the overlays, that were made by the blocks above
+    benchmark::measure("call on an overlay of the last snapshot", [&] {
+        lk::StateManager overlay{ snapshot };
+        performCall(overlay, contract_address, ++i);
+    });
+}
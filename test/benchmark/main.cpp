@@ -0,0 +1,144 @@
+#include "benchmark.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+constexpr std::chrono::milliseconds MIN_MEASUREMENT_TIME{ 500 };
+constexpr std::size_t ALLOCATIONS_COUNTING_CALLS = 100;
+
+std::atomic<std::size_t> allocations_count{ 0 };
+
+
+std::vector<std::pair<const char*, benchmark::CaseFunction>>& getCases()
+{
+    static std::vector<std::pair<const char*, benchmark::CaseFunction>> cases;
+    return cases;
+}
+
+} // namespace
+
+
+// every allocation of the benchmark binary goes through these, so they are counted in one place
+void* operator new(std::size_t size)
+{
+    allocations_count.fetch_add(1, std::memory_order_relaxed);
+    if (auto p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+
+// polymorphic allocators go through the aligned versions
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    allocations_count.fetch_add(1, std::memory_order_relaxed);
+    auto align = static_cast<std::size_t>(alignment);
+    if (auto p = std::aligned_alloc(align, (size == 0 ? align : (size + align - 1) / align * align))) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+
+namespace benchmark
+{
+
+Registrar::Registrar(const char* name, CaseFunction f)
+{
+    getCases().emplace_back(name, f);
+}
+
+
+void measure(const std::string& label, const std::function<void()>& f, std::size_t bytes_per_call)
+{
+    f(); // warm up
+
+    std::size_t calls = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::steady_clock::duration::zero();
+    do {
+        f();
+        ++calls;
+        elapsed = std::chrono::steady_clock::now() - start;
+    } while (elapsed < MIN_MEASUREMENT_TIME);
+
+    auto ns_per_call = std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(calls);
+    std::cout << "    " << std::left << std::setw(48) << label << std::right << std::setw(14) << std::fixed
+              << std::setprecision(1) << ns_per_call << " ns/op";
+    if (bytes_per_call != 0) {
+        auto mb_per_second = static_cast<double>(bytes_per_call) / ns_per_call * 1e9 / (1024 * 1024);
+        std::cout << std::setw(12) << mb_per_second << " MB/s";
+    }
+    std::cout << std::endl;
+}
+
+
+void countAllocations(const std::string& label, const std::function<void()>& f)
+{
+    f(); // warm up
+
+    auto allocations_before = allocations_count.load();
+    for (std::size_t i = 0; i < ALLOCATIONS_COUNTING_CALLS; ++i) {
+        f();
+    }
+    auto allocations = allocations_count.load() - allocations_before;
+    report(label, static_cast<double>(allocations) / ALLOCATIONS_COUNTING_CALLS, "allocs/op");
+}
+
+
+void report(const std::string& label, double value, const std::string& unit)
+{
+    std::cout << "    " << std::left << std::setw(48) << label << std::right << std::setw(14) << std::fixed
+              << std::setprecision(1) << value << " " << unit << std::endl;
+}
+
+} // namespace benchmark
+
+
+// usage: run_benchmarks [substring of benchmark case names to run]
+int main(int argc, char** argv)
+{
+    std::string filter = argc > 1 ? argv[1] : "";
+    for (const auto& [name, f] : getCases()) {
+        if (std::string(name).find(filter) == std::string::npos) {
+            continue;
+        }
+        std::cout << name << std::endl;
+        f();
+    }
+    return 0;
+}
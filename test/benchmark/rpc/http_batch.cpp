@@ -0,0 +1,180 @@
+#include "benchmark.hpp"
+
+#include "core/samples.hpp"
+
+#include "rpc/http/http_adapter.hpp"
+
+#include "base/error.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace
+{
+
+constexpr std::size_t CALLS_IN_BATCH = 16;
+// stands for a database read of a real node, which dominates the time of a call
+constexpr std::chrono::microseconds ACCOUNT_READ_TIME{ 200 };
+constexpr std::size_t BLOCK_CALLS = 100;
+
+const lk::Address ACCOUNT_ADDRESS{ "49cfqVfB1gTGw5XZSu6nZDrntLr1" };
+
+
+// answers only the calls made by the benchmark
+class StubService : public rpc::BaseRpcService
+{
+  public:
+    lk::AccountInfo getAccountInfo(const lk::Address& address) override
+    {
+        std::this_thread::sleep_for(ACCOUNT_READ_TIME);
+        return lk::AccountInfo{ lk::AccountType::CLIENT, address, 100, 1, {} };
+    }
+
+    rpc::Info getNodeInfo() override
+    {
+        // high enough for the sample block to be deep enough for caching by its number
+        return rpc::Info{ base::Sha256::null(), 1'000, 1 };
+    }
+
+    lk::ImmutableBlock getBlock(const base::Sha256&) override
+    {
+        RAISE_ERROR(base::LogicError, "not supported by the stub");
+    }
+
+    lk::ImmutableBlock getBlock(uint64_t) override
+    {
+        return _block;
+    }
+
+    lk::Transaction getTransaction(const base::Sha256&) override
+    {
+        RAISE_ERROR(base::LogicError, "not supported by the stub");
+    }
+
+    lk::TransactionStatus pushTransaction(const lk::Transaction&) override
+    {
+        RAISE_ERROR(base::LogicError, "not supported by the stub");
+    }
+
+    lk::TransactionStatus getTransactionStatus(const base::Sha256&) override
+    {
+        RAISE_ERROR(base::LogicError, "not supported by the stub");
+    }
+
+    lk::ViewCallResult callContractView(const lk::Transaction&) override
+    {
+        RAISE_ERROR(base::LogicError, "not supported by the stub");
+    }
+
+    std::uint64_t estimateGas(const lk::Transaction&) override
+    {
+        RAISE_ERROR(base::LogicError, "not supported by the stub");
+    }
+
+    std::vector<lk::LogRecord> getLogs(const lk::LogsFilter&) override
+    {
+        return {};
+    }
+
+    std::vector<lk::ContractTrace> getVmTraces() override
+    {
+        return {};
+    }
+
+    std::vector<lk::ImmutableBlock> getBlocks(uint64_t, std::size_t) override
+    {
+        RAISE_ERROR(base::LogicError, "not supported by the stub");
+    }
+
+    std::vector<lk::Transaction> getTransactions(const std::vector<base::Sha256>&) override
+    {
+        RAISE_ERROR(base::LogicError, "not supported by the stub");
+    }
+
+    std::vector<lk::TransactionStatus> pushTransactions(const std::vector<lk::Transaction>&) override
+    {
+        RAISE_ERROR(base::LogicError, "not supported by the stub");
+    }
+
+    std::shared_ptr<rpc::Subscription<lk::ImmutableBlock>> subscribeToBlocks() override
+    {
+        RAISE_ERROR(base::LogicError, "not supported by the stub");
+    }
+
+    std::shared_ptr<rpc::Subscription<lk::Transaction>> subscribeToPendingTransactions() override
+    {
+        RAISE_ERROR(base::LogicError, "not supported by the stub");
+    }
+
+    std::shared_ptr<rpc::Subscription<rpc::TransactionStatusUpdate>> subscribeToTransactionStatuses(
+      const std::vector<base::Sha256>&) override
+    {
+        RAISE_ERROR(base::LogicError, "not supported by the stub");
+    }
+
+  private:
+    const lk::ImmutableBlock _block{ samples::makeBlock() };
+};
+
+
+web::json::value makeAccountParams()
+{
+    web::json::value params;
+    params["address"] = web::json::value::string(ACCOUNT_ADDRESS.toString());
+    return params;
+}
+
+
+web::json::value makeBatch()
+{
+    std::vector<web::json::value> calls;
+    for (std::size_t i = 0; i < CALLS_IN_BATCH; ++i) {
+        web::json::value call;
+        call["method"] = web::json::value::string(i % 4 == 0 ? "get_node_info" : "get_account");
+        call["params"] = makeAccountParams();
+        calls.push_back(std::move(call));
+    }
+    return web::json::value::array(std::move(calls));
+}
+
+} // namespace
+
+
+BENCHMARK_CASE(http_batch_of_16_calls)
+{
+    rpc::http::Adapter adapter;
+    adapter.init(std::make_shared<StubService>());
+    const auto params = makeAccountParams();
+    const auto batch = makeBatch();
+
+    // how a client had to do it before batches: a call at a time, not counting a round trip for each
+    benchmark::measure("16 calls one by one", [&] {
+        for (std::size_t i = 0; i < CALLS_IN_BATCH; ++i) {
+            benchmark::doNotOptimize(adapter.processCall(i % 4 == 0 ? "get_node_info" : "get_account", params));
+        }
+    });
+    benchmark::measure("16 calls in a batch", [&] { benchmark::doNotOptimize(adapter.processBatch(batch).get()); });
+}
+
+
+BENCHMARK_CASE(http_get_block_cached)
+{
+    web::json::value params;
+    params["number"] = web::json::value::number(1);
+
+    rpc::http::Adapter uncached;
+    uncached.init(std::make_shared<StubService>(), base::config::RPC_HTTP_MAX_BATCH_SIZE, 0);
+    benchmark::measure("100 get_block without cache", [&] {
+        for (std::size_t i = 0; i < BLOCK_CALLS; ++i) {
+            benchmark::doNotOptimize(uncached.processCall("get_block", params));
+        }
+    });
+
+    rpc::http::Adapter cached;
+    cached.init(std::make_shared<StubService>());
+    benchmark::measure("100 get_block with cache", [&] {
+        for (std::size_t i = 0; i < BLOCK_CALLS; ++i) {
+            benchmark::doNotOptimize(cached.processCall("get_block", params));
+        }
+    });
+}
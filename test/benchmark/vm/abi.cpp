@@ -0,0 +1,76 @@
+#include "benchmark.hpp"
+
+#include "vm/abi.hpp"
+#include "vm/abi_registry.hpp"
+#include "vm/tools.hpp"
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+
+namespace
+{
+
+constexpr const char* METADATA = R"({"output": {"abi": [
+    {"type": "constructor", "inputs": [{"name": "owner", "type": "address"}]},
+    {"type": "function", "name": "highestBid", "inputs": [], "outputs": [{"name": "", "type": "uint256"}]},
+    {"type": "function", "name": "bid", "inputs": [{"name": "amount", "type": "uint256"}], "outputs": []},
+    {"type": "function", "name": "g", "inputs": [{"name": "", "type": "uint256[][]"}, {"name": "", "type": "string[]"}],
+     "outputs": [{"name": "", "type": "uint256[][]"}, {"name": "", "type": "string[]"}]}
+]}})";
+
+constexpr const char* DYNAMIC_CALL = R"(g([[1, 2], [3]], ["one", "two", "three"]))";
+
+
+boost::property_tree::ptree loadMetadata()
+{
+    std::istringstream input{ METADATA };
+    boost::property_tree::ptree ret;
+    boost::property_tree::read_json(input, ret);
+    return ret;
+}
+
+} // namespace
+
+
+BENCHMARK_CASE(abi_encode_decode)
+{
+    auto metadata = loadMetadata();
+    vm::ContractAbi contract{ metadata };
+    auto static_output = base::Bytes(contract.getFunctions()[0].getSelector()) + base::Bytes(32);
+    auto dynamic_call = contract.encodeCall(DYNAMIC_CALL, {});
+
+    benchmark::measure("abi parse metadata", [&] { benchmark::doNotOptimize(vm::ContractAbi{ metadata }); });
+    benchmark::measure("abi encode bid(uint256)",
+                       [&] { benchmark::doNotOptimize(contract.encodeCall("bid(1000)", {})); });
+    benchmark::measure("abi encode g(uint256[][],string[])",
+                       [&] { benchmark::doNotOptimize(contract.encodeCall(DYNAMIC_CALL, {})); });
+    benchmark::measure("abi decode uint256", [&] { benchmark::doNotOptimize(contract.decodeOutput(static_output)); });
+    benchmark::measure("abi decode (uint256[][],string[])",
+                       [&] { benchmark::doNotOptimize(contract.decodeOutput(dynamic_call)); });
+}
+
+
+BENCHMARK_CASE(abi_encode_from_folder)
+{
+    // same entry point the client uses, the folder is parsed once and then served from the abi registry
+    auto folder = std::filesystem::temp_directory_path() / "likelib_abi_benchmark";
+    std::filesystem::create_directories(folder);
+    std::ofstream(folder / "compiled_code.bin") << "6080604052348015600f57600080fd5b50";
+    std::ofstream(folder / "metadata.json") << METADATA;
+    auto output = base::toHex(vm::ContractAbi{ loadMetadata() }.getFunctions()[0].getSelector()) + std::string(64, '0');
+
+    benchmark::measure("abi load folder uncached", [&] {
+        vm::AbiRegistry registry;
+        benchmark::doNotOptimize(registry.load(folder));
+    });
+    benchmark::measure("abi encode call from folder",
+                       [&] { benchmark::doNotOptimize(vm::encodeCall(folder, "bid(1000)")); });
+    benchmark::measure("abi decode output from folder",
+                       [&] { benchmark::doNotOptimize(vm::decodeOutput(folder, output)); });
+
+    std::filesystem::remove_all(folder);
+}
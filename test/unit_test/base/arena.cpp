@@ -0,0 +1,48 @@
+#include <boost/test/unit_test.hpp>
+
+#include "base/arena.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(arena_counts_allocations)
+{
+    base::Arena arena{ 64 };
+    BOOST_CHECK_EQUAL(arena.getAllocationsCount(), 0);
+    BOOST_CHECK_EQUAL(arena.getAllocatedBytes(), 0);
+
+    auto p = arena.allocate(100, 8);
+    BOOST_CHECK(p);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(p) % 8, 0);
+    arena.deallocate(p, 100, 8);
+    BOOST_CHECK(arena.allocate(1000, 16));
+
+    BOOST_CHECK_EQUAL(arena.getAllocationsCount(), 2);
+    BOOST_CHECK_EQUAL(arena.getAllocatedBytes(), 1100);
+}
+
+
+BOOST_AUTO_TEST_CASE(arena_with_containers)
+{
+    base::Arena arena{ 1024 };
+    {
+        std::pmr::map<int, std::pmr::string> map{ &arena };
+        for (int i = 0; i < 100; ++i) {
+            map.emplace(i, std::string(100, static_cast<char>('a' + i % 26)));
+        }
+        BOOST_CHECK_EQUAL(map.size(), 100);
+        BOOST_CHECK(map.at(27) == std::pmr::string(100, 'b'));
+        BOOST_CHECK(map.at(27).get_allocator().resource() == &arena);
+
+        std::pmr::vector<int> v{ &arena };
+        v.resize(10000, 7);
+        BOOST_CHECK_EQUAL(v.back(), 7);
+    }
+    BOOST_CHECK_GE(arena.getAllocationsCount(), 201);
+    BOOST_CHECK(arena.is_equal(arena));
+
+    base::Arena other{ 1024 };
+    BOOST_CHECK(!arena.is_equal(other));
+}
@@ -3,7 +3,13 @@
 #include "base/bytes.hpp"
 #include "base/hash.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
 #include <memory>
+#include <random>
+#include <string>
+#include <vector>
 
 BOOST_AUTO_TEST_CASE(bytes_storage_check)
 {
@@ -21,6 +27,42 @@ BOOST_AUTO_TEST_CASE(bytes_storage_check)
 }
 
 
+BOOST_AUTO_TEST_CASE(bytes_inline_and_heap_storage)
+{
+    BOOST_CHECK_GE(base::Bytes{}.capacity(), base::Bytes::INLINE_CAPACITY);
+
+    // contents must survive copies, moves and growth on both sides of the inline capacity
+    for (std::size_t size : { std::size_t{ 1 }, base::Bytes::INLINE_CAPACITY, base::Bytes::INLINE_CAPACITY + 1,
+                              std::size_t{ 1000 } }) {
+        base::Bytes bytes(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            bytes[i] = static_cast<base::Byte>(i * 7 + 1);
+        }
+
+        base::Bytes copy{ bytes };
+        BOOST_CHECK(copy == bytes);
+        base::Bytes moved{ std::move(copy) };
+        BOOST_CHECK(moved == bytes);
+
+        base::Bytes assigned{ 0x01, 0x02 };
+        assigned = moved;
+        BOOST_CHECK(assigned == bytes);
+        assigned = base::Bytes(2000);
+        assigned = std::move(moved);
+        BOOST_CHECK(assigned == bytes);
+
+        base::Bytes grown;
+        for (std::size_t i = 0; i < size; ++i) {
+            grown.append(bytes[i]);
+        }
+        BOOST_CHECK(grown == bytes);
+        grown.shrinkToFit();
+        BOOST_CHECK(grown == bytes);
+        BOOST_CHECK(grown + bytes == base::Bytes(grown).append(bytes));
+    }
+}
+
+
 BOOST_AUTO_TEST_CASE(bytes_constructor_from_array_of_chars)
 {
     std::size_t length = 10;
@@ -344,6 +386,146 @@ BOOST_AUTO_TEST_CASE(base64_encode_fixed_bytes_one_byte)
 }
 
 
+namespace
+{
+
+base::Bytes makeRandomBytes(std::mt19937& generator, std::size_t size)
+{
+    std::uniform_int_distribution<int> byte_distribution{ 0, 255 };
+    base::Bytes ret(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        ret[i] = static_cast<base::Byte>(byte_distribution(generator));
+    }
+    return ret;
+}
+
+
+std::string referenceBase64(const base::Bytes& bytes)
+{
+    static constexpr char DIGITS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string ret;
+    std::size_t bits_count = 0;
+    unsigned bits = 0;
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bits = (bits << 8) | bytes[i];
+        bits_count += 8;
+        while (bits_count >= 6) {
+            bits_count -= 6;
+            ret += DIGITS[(bits >> bits_count) & 0x3F];
+        }
+    }
+    if (bits_count > 0) {
+        ret += DIGITS[(bits << (6 - bits_count)) & 0x3F];
+    }
+    while (ret.size() % 4 != 0) {
+        ret += '=';
+    }
+    return ret;
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(hex_encode_decode_all_lengths)
+{
+    // long enough inputs go through the vectorized code, so every length checks a different split with the tail
+    std::mt19937 generator{ 16 };
+    for (std::size_t size = 0; size < 200; ++size) {
+        auto bytes = makeRandomBytes(generator, size);
+
+        std::string expected;
+        for (std::size_t i = 0; i < size; ++i) {
+            char buffer[3];
+            std::snprintf(buffer, sizeof(buffer), "%02x", bytes[i]);
+            expected += buffer;
+        }
+
+        auto hex = base::toHex(bytes);
+        BOOST_CHECK_EQUAL(hex, expected);
+        BOOST_CHECK(base::fromHex<base::Bytes>(hex) == bytes);
+
+        std::transform(hex.begin(), hex.end(), hex.begin(), [](char c) { return std::toupper(c); });
+        BOOST_CHECK(base::fromHex<base::Bytes>(hex) == bytes);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(hex_decode_invalid_symbols)
+{
+    const std::string valid = base::toHex(base::Bytes(std::string(100, '\x5A')));
+    for (char bad : { 'g', 'G', '/', ':', '@', '`', ' ', '\0', '\x80', '\xC6' }) {
+        for (std::size_t position = 0; position < valid.size(); position += 7) {
+            auto hex = valid;
+            hex[position] = bad;
+            BOOST_CHECK_THROW(base::fromHex<base::Bytes>(hex), base::InvalidArgument);
+        }
+    }
+    BOOST_CHECK_THROW(base::fromHex<base::Bytes>(valid.substr(1)), base::InvalidArgument);
+}
+
+
+BOOST_AUTO_TEST_CASE(base64_encode_decode_all_lengths)
+{
+    std::mt19937 generator{ 64 };
+    for (std::size_t size = 0; size < 200; ++size) {
+        auto bytes = makeRandomBytes(generator, size);
+        auto base64 = base::base64Encode(bytes);
+        BOOST_CHECK_EQUAL(base64, referenceBase64(bytes));
+        BOOST_CHECK(base::base64Decode(base64) == bytes);
+
+        // padding may be omitted
+        BOOST_CHECK(base::base64Decode(base64.substr(0, base64.find('='))) == bytes);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(base64_decode_invalid)
+{
+    const std::string valid = base::base64Encode(base::Bytes(std::string(100, '\x5A')));
+    for (char bad : { '-', '_', '.', ':', '@', '[', '`', '{', '=', '\0', '\x80', '\xC1' }) {
+        for (std::size_t position = 0; position < valid.size() - 4; position += 5) {
+            auto base64 = valid;
+            base64[position] = bad;
+            BOOST_CHECK_THROW(base::base64Decode(base64), base::InvalidArgument);
+        }
+    }
+    BOOST_CHECK_THROW(base::base64Decode("QUJDR"), base::InvalidArgument);
+    BOOST_CHECK_THROW(base::base64Decode("QQ=A"), base::InvalidArgument);
+    BOOST_CHECK_THROW(base::base64Decode("Q==="), base::InvalidArgument);
+    BOOST_CHECK_THROW(base::base64Decode("===="), base::InvalidArgument);
+}
+
+
+BOOST_AUTO_TEST_CASE(hex_and_base64_streaming)
+{
+    std::mt19937 generator{ 1 };
+    auto bytes = makeRandomBytes(generator, 100);
+
+    // writing into a bigger buffer must not touch anything after the result
+    std::string hex(bytes.size() * 2 + 1, '#');
+    base::toHexInto(bytes, hex.data());
+    BOOST_CHECK_EQUAL(hex, base::toHex(bytes) + '#');
+
+    std::string base64(base::base64EncodedSize(bytes.size()) + 1, '#');
+    BOOST_CHECK_EQUAL(base64.size(), 137);
+    base::base64EncodeInto(bytes, base64.data());
+    BOOST_CHECK_EQUAL(base64, base::base64Encode(bytes) + '#');
+
+    base::Bytes decoded(bytes.size() + 1);
+    decoded[bytes.size()] = 0xA5;
+    base::fromHexInto(base::toHex(bytes), decoded.getData());
+    BOOST_CHECK(decoded.takePart(0, bytes.size()) == bytes);
+    BOOST_CHECK_EQUAL(decoded[bytes.size()], 0xA5);
+
+    base64.pop_back();
+    BOOST_CHECK_EQUAL(base::base64DecodedSize(base64), bytes.size());
+    decoded.getData()[0] = 0;
+    base::base64DecodeInto(base64, decoded.getData());
+    BOOST_CHECK(decoded.takePart(0, bytes.size()) == bytes);
+    BOOST_CHECK_EQUAL(decoded[bytes.size()], 0xA5);
+}
+
+
 BOOST_AUTO_TEST_CASE(base58_encode_decode)
 {
     base::Bytes target_msg("dFM#69356^#-04  @#4-0^\n\n4#0632=-GEJ3dls5s,spi+-5+0");
@@ -373,3 +555,133 @@ BOOST_AUTO_TEST_CASE(base58_encode_decode_empty)
     BOOST_CHECK(base64 == "");
     BOOST_CHECK(target_msg == decode_base64);
 }
+
+
+namespace
+{
+
+// the quadratic encoder, that base58Encode used before the fixed-size path, kept as an independent reference
+std::string referenceBase58Encode(const base::Bytes& bytes)
+{
+    static constexpr char ALPHABET[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+    std::size_t current_pos = 0;
+    while (current_pos != bytes.size() && bytes[current_pos] == 0) {
+        current_pos++;
+    }
+    const std::size_t zeroes_count = current_pos;
+
+    std::vector<std::size_t> b58(bytes.size() * 138 / 100 + 1); // log(256) / log(58)
+    std::size_t length = 0;
+    for (; current_pos != bytes.size(); current_pos++) {
+        auto carry = static_cast<std::size_t>(bytes[current_pos]);
+        std::size_t i = 0;
+        for (auto it = b58.rbegin(); (carry != 0 || i < length) && it != b58.rend(); it++, i++) {
+            carry += 256 * (*it);
+            *it = carry % 58;
+            carry /= 58;
+        }
+        length = i;
+    }
+    auto it = b58.begin() + (b58.size() - length);
+    while (it != b58.end() && *it == 0) {
+        it++;
+    }
+
+    std::string str(zeroes_count, '1');
+    while (it != b58.end()) {
+        str += ALPHABET[*(it++)];
+    }
+    return str;
+}
+
+
+template<std::size_t S>
+void checkFixedBase58(const base::FixedBytes<S>& bytes)
+{
+    auto reference = referenceBase58Encode(bytes.toBytes());
+    auto fixed = base::base58Encode(bytes);
+    BOOST_CHECK_EQUAL(fixed, reference);
+    BOOST_CHECK_EQUAL(base::base58Encode(bytes.toBytes()), reference);
+    BOOST_CHECK(base::base58Decode<S>(fixed) == bytes);
+    BOOST_CHECK(base::base58Decode(fixed) == bytes.toBytes());
+}
+
+
+template<std::size_t S>
+void fuzzFixedBase58(std::mt19937& generator)
+{
+    for (std::size_t iteration = 0; iteration < 2000; ++iteration) {
+        base::FixedBytes<S> bytes;
+        // some leading bytes are zeroed to check leading '1's and short numbers
+        const std::size_t zeroes = generator() % 4 == 0 ? generator() % (S + 1) : 0;
+        for (std::size_t i = zeroes; i < S; ++i) {
+            bytes[i] = static_cast<base::Byte>(generator());
+        }
+        checkFixedBase58(bytes);
+    }
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(base58_fixed_matches_reference)
+{
+    std::mt19937 generator{ 58 };
+    fuzzFixedBase58<20>(generator);
+    fuzzFixedBase58<25>(generator);
+    fuzzFixedBase58<32>(generator);
+    fuzzFixedBase58<1>(generator);
+    fuzzFixedBase58<7>(generator);
+
+    base::FixedBytes<20> all_ones;
+    for (std::size_t i = 0; i < 20; ++i) {
+        all_ones[i] = 0xFF;
+    }
+    checkFixedBase58(all_ones);
+    checkFixedBase58(base::FixedBytes<20>{});
+    BOOST_CHECK_EQUAL(base::base58Encode(all_ones), "4ZrjxJnU1LA5xSyrWMNuXTvSYKwt");
+    BOOST_CHECK_EQUAL(base::base58Encode(base::FixedBytes<20>{}), "11111111111111111111");
+
+    base::FixedBytes<25> checked_all_ones;
+    for (std::size_t i = 0; i < 25; ++i) {
+        checked_all_ones[i] = 0xFF;
+    }
+    BOOST_CHECK_EQUAL(base::base58Encode(checked_all_ones), "2n1XR4oJkmBdJMxhBGQGb96gQ88xUzxLFyG");
+}
+
+
+BOOST_AUTO_TEST_CASE(base58_general_uses_fixed_for_address_sizes)
+{
+    base::Bytes address(20);
+    base::Bytes checked_address(25);
+    for (std::size_t i = 0; i < 25; ++i) {
+        checked_address[i] = static_cast<base::Byte>(i * 37 + 1);
+        if (i < 20) {
+            address[i] = static_cast<base::Byte>(i * 11 + 3);
+        }
+    }
+    BOOST_CHECK(base::base58Decode(base::base58Encode(address)) == address);
+    BOOST_CHECK(base::base58Decode(base::base58Encode(checked_address)) == checked_address);
+    BOOST_CHECK(base::base58Encode(base::BytesView(address)) == base::base58Encode(base::FixedBytes<20>(address)));
+}
+
+
+BOOST_AUTO_TEST_CASE(base58_fixed_decode_invalid)
+{
+    base::FixedBytes<20> bytes;
+    for (std::size_t i = 0; i < 20; ++i) {
+        bytes[i] = static_cast<base::Byte>(0xF0 - i);
+    }
+    auto encoded = base::base58Encode(bytes);
+
+    BOOST_CHECK_THROW(base::base58Decode<20>(encoded + "z"), base::InvalidArgument);
+    BOOST_CHECK_THROW(base::base58Decode<20>("1" + encoded), base::InvalidArgument);
+    BOOST_CHECK_THROW(base::base58Decode<20>(encoded.substr(0, encoded.size() - 2)), base::InvalidArgument);
+    BOOST_CHECK_THROW(base::base58Decode<20>(encoded.substr(0, 5) + "0" + encoded.substr(6)), base::InvalidArgument);
+    BOOST_CHECK_THROW(base::base58Decode<20>(encoded.substr(0, 5) + "\xC3" + encoded.substr(6)), base::InvalidArgument);
+    BOOST_CHECK_THROW(base::base58Decode<20>(""), base::InvalidArgument);
+    BOOST_CHECK_THROW(base::base58Decode<20>(std::string(21, '1')), base::InvalidArgument);
+    BOOST_CHECK(base::base58Decode<20>(std::string(20, '1')) == base::FixedBytes<20>{});
+    BOOST_CHECK_THROW(base::base58Decode<25>(encoded), base::InvalidArgument);
+}
@@ -236,4 +236,33 @@ BOOST_AUTO_TEST_CASE(data_base_with_long_path)
     BOOST_CHECK_EQUAL(data_base2.get(key1).value().toString(), bytes1.toString());
 
     std::filesystem::remove_all(path_to_data_base_folder);
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(data_base_put_all_and_range)
+{
+    std::filesystem::path path_to_data_base_folder("local_test_base");
+    auto data_base = base::createClearDatabaseInstance(path_to_data_base_folder);
+
+    data_base.putAll({ { base::Bytes{ 0x01, 0x03 }, base::Bytes("c") },
+                       { base::Bytes{ 0x01, 0x01 }, base::Bytes("a") },
+                       { base::Bytes{ 0x01, 0x02 }, base::Bytes("b") },
+                       { base::Bytes{ 0x02, 0x01 }, base::Bytes("d") } });
+
+    std::string values;
+    data_base.forEachInRange(
+      base::Bytes{ 0x01 }, base::Bytes{ 0x02 }, [&values](base::BytesView, base::BytesView value) {
+          values += value.toString();
+          return true;
+      });
+    BOOST_CHECK_EQUAL(values, "abc");
+
+    values.clear();
+    data_base.forEachInRange(
+      base::Bytes{ 0x01, 0x02 }, base::Bytes{ 0x03 }, [&values](base::BytesView key, base::BytesView value) {
+          values += value.toString();
+          return key != base::Bytes{ 0x01, 0x03 };
+      });
+    BOOST_CHECK_EQUAL(values, "bc");
+
+    std::filesystem::remove_all(path_to_data_base_folder);
+}
@@ -27,6 +27,35 @@ class TestSerialization
 
     int _value;
 };
+
+
+struct FieldsSerialization
+{
+    std::uint32_t id;
+    std::string name;
+    std::vector<base::Bytes> payloads;
+
+    DEFINE_SERIALIZATION_FIELDS(FieldsSerialization, (id)(name)(payloads))
+};
+
+
+class PrivateFieldsSerialization
+{
+  public:
+    PrivateFieldsSerialization(std::int64_t a, base::FixedBytes<4> b)
+      : _a{ a }
+      , _b{ b }
+    {}
+
+    std::int64_t getA() const { return _a; }
+    const base::FixedBytes<4>& getB() const { return _b; }
+
+    DEFINE_SERIALIZATION_FIELDS(PrivateFieldsSerialization, (_a)(_b))
+
+  private:
+    const std::int64_t _a;
+    const base::FixedBytes<4> _b;
+};
 } // namespace
 
 BOOST_AUTO_TEST_CASE(serialization_sanity_check1)
@@ -298,4 +327,315 @@ BOOST_AUTO_TEST_CASE(serialization_pair2)
     BOOST_CHECK(p1._value == p4._value);
     BOOST_CHECK(p2._value == p5._value);
     BOOST_CHECK(p3._value == p6._value);
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(serialization_bytes_bulk)
+{
+    base::Bytes bb(10000);
+    for (std::size_t i = 0; i < bb.size(); ++i) {
+        bb[i] = static_cast<base::Byte>(i * 7 + 3);
+    }
+    base::FixedBytes<20> fb;
+    for (std::size_t i = 0; i < fb.size(); ++i) {
+        fb[i] = static_cast<base::Byte>(255 - i);
+    }
+    std::string str(3000, 'x');
+
+    base::SerializationOArchive oa;
+    oa.serialize(fb);
+    oa.serialize(bb);
+    oa.serialize(str);
+    oa.serialize(fb);
+
+    // the layout must not change: size as 8-byte big-endian integer followed by raw content
+    BOOST_CHECK_EQUAL(oa.getBytes().size(), 20 + 8 + bb.size() + 8 + str.size() + 20);
+    BOOST_CHECK(oa.getBytes().takePart(20, 28) == base::toBytes(bb.size()));
+    BOOST_CHECK(oa.getBytes().takePart(0, 20) == fb.toBytes());
+
+    base::SerializationIArchive ia(oa.getBytes());
+    BOOST_CHECK(ia.deserialize<base::FixedBytes<20>>() == fb);
+    BOOST_CHECK(ia.deserialize<base::Bytes>() == bb);
+    BOOST_CHECK_EQUAL(ia.deserialize<std::string>(), str);
+    BOOST_CHECK(ia.deserialize<base::FixedBytes<20>>() == fb);
+}
+
+
+BOOST_AUTO_TEST_CASE(serialization_string_same_as_bytes)
+{
+    std::string str = "some string \n with symbols";
+    BOOST_CHECK(base::toBytes(str) == base::toBytes(base::Bytes(str)));
+    BOOST_CHECK(base::toBytes(std::vector<char>(str.begin(), str.end())) == base::toBytes(base::Bytes(str)));
+}
+
+
+BOOST_AUTO_TEST_CASE(serialization_bytes_not_enough_data)
+{
+    base::Bytes bb{ 0x1, 0x3, 0x5, 0x7, 0x15 };
+    auto serialized = base::toBytes(bb);
+    auto truncated = serialized.takePart(0, serialized.size() - 1);
+
+    BOOST_CHECK_THROW(base::fromBytes<base::Bytes>(truncated), base::InvalidArgument);
+    BOOST_CHECK_THROW(base::fromBytes<std::string>(truncated), base::InvalidArgument);
+    BOOST_CHECK_THROW(base::fromBytes<std::vector<base::Byte>>(truncated), base::InvalidArgument);
+    BOOST_CHECK_THROW(base::fromBytes<base::FixedBytes<20>>(truncated), base::InvalidArgument);
+}
+
+
+BOOST_AUTO_TEST_CASE(serialization_serialized_size)
+{
+    std::vector<std::string> strings{ "abc", "", "some longer string" };
+    std::vector<std::int32_t> ints{ 1, -2, 3 };
+    std::optional<base::Bytes> bytes{ base::Bytes{ 0x1, 0x2, 0x3 } };
+    std::optional<base::Bytes> no_bytes;
+    std::pair<std::uint16_t, base::FixedBytes<4>> p{ 7, base::FixedBytes<4>{ 0x1, 0x2, 0x3, 0x4 } };
+
+    BOOST_CHECK_EQUAL(base::serializedSize(strings), base::toBytes(strings).size());
+    BOOST_CHECK_EQUAL(base::serializedSize(ints), base::toBytes(ints).size());
+    BOOST_CHECK_EQUAL(base::serializedSize(bytes), base::toBytes(bytes).size());
+    BOOST_CHECK_EQUAL(base::serializedSize(no_bytes), base::toBytes(no_bytes).size());
+    BOOST_CHECK_EQUAL(base::serializedSize(p), base::toBytes(p).size());
+    BOOST_CHECK_EQUAL(base::serializedSize(base::Uint256{ 1234567 }), base::toBytes(base::Uint256{ 1234567 }).size());
+}
+
+
+BOOST_AUTO_TEST_CASE(serialization_serialize_into_buffer)
+{
+    base::Bytes buffer;
+    base::serializeInto(base::Bytes(1000), buffer);
+    BOOST_CHECK(buffer == base::toBytes(base::Bytes(1000)));
+    auto capacity = buffer.capacity();
+    const auto* data = buffer.getData();
+
+    std::vector<std::uint64_t> v{ 1, 2, 3 };
+    base::serializeInto(v, buffer);
+    BOOST_CHECK(buffer == base::toBytes(v));
+    BOOST_CHECK_EQUAL(buffer.capacity(), capacity);
+    BOOST_CHECK(buffer.getData() == data);
+}
+
+
+BOOST_AUTO_TEST_CASE(serialization_serialized_size_big_integer)
+{
+    base::Uint256 n{ 1 };
+    for (std::size_t i = 0; i < 255; ++i) {
+        BOOST_CHECK_EQUAL(base::serializedSize(n), base::toBytes(n).size());
+        BOOST_CHECK_EQUAL(base::serializedSize(n - 1), base::toBytes(n - 1).size());
+        n <<= 1;
+    }
+    base::Uint256 power_of_ten{ 1 };
+    for (std::size_t i = 0; i < 77; ++i) {
+        power_of_ten *= 10;
+        BOOST_CHECK_EQUAL(base::serializedSize(power_of_ten), base::toBytes(power_of_ten).size());
+        BOOST_CHECK_EQUAL(base::serializedSize(power_of_ten - 1), base::toBytes(power_of_ten - 1).size());
+    }
+    BOOST_CHECK_EQUAL(base::serializedSize(~base::Uint256{ 0 }), base::toBytes(~base::Uint256{ 0 }).size());
+}
+
+
+BOOST_AUTO_TEST_CASE(serialization_deserialize_view)
+{
+    base::Bytes payload{ 0x1, 0x3, 0x5, 0x7, 0x15 };
+    base::FixedBytes<4> fixed{ 0x9, 0x8, 0x7, 0x6 };
+    std::string s{ "some string" };
+
+    base::SerializationOArchive oa;
+    oa.serialize(payload);
+    oa.serialize(fixed);
+    oa.serialize(s);
+    oa.serialize(std::uint32_t{ 42 });
+    auto serialized = std::move(oa).getBytes();
+
+    base::SerializationIArchive ia(serialized);
+    auto payload_view = ia.deserializeView<base::Bytes>();
+    auto fixed_view = ia.deserializeView<base::FixedBytes<4>>();
+    auto s_view = ia.deserializeView<std::string>();
+
+    BOOST_CHECK(payload_view == base::BytesView(payload));
+    BOOST_CHECK(fixed_view == base::BytesView(fixed));
+    BOOST_CHECK_EQUAL(s_view.toString(), s);
+    BOOST_CHECK(payload_view.getData() >= serialized.getData());
+    BOOST_CHECK(payload_view.getData() + payload_view.size() <= serialized.getData() + serialized.size());
+
+    auto rest = ia.getRemaining();
+    BOOST_CHECK_EQUAL(rest.size(), sizeof(std::uint32_t));
+    BOOST_CHECK_EQUAL(base::fromBytes<std::uint32_t>(rest), 42);
+    BOOST_CHECK_EQUAL(ia.deserialize<std::uint32_t>(), 42);
+    BOOST_CHECK(ia.getRemaining().isEmpty());
+}
+
+
+BOOST_AUTO_TEST_CASE(serialization_deserialize_from_sub_view)
+{
+    base::Bytes payload{ 0x1, 0x3, 0x5, 0x7, 0x15 };
+    auto serialized = base::toBytes(payload);
+    base::Bytes framed(serialized.size() + 2);
+    framed[0] = 0xAA;
+    for (std::size_t i = 0; i < serialized.size(); ++i) {
+        framed[i + 1] = serialized[i];
+    }
+    framed[framed.size() - 1] = 0xBB;
+
+    base::BytesView view(framed);
+    BOOST_CHECK(base::fromBytes<base::Bytes>(view.subView(1, framed.size() - 1)) == payload);
+    BOOST_CHECK_THROW(base::fromBytes<base::Bytes>(view.subView(1, framed.size() - 2)), base::InvalidArgument);
+}
+
+
+namespace
+{
+
+// COMPACT BigInteger: sign byte, magnitude length and the magnitude
+base::Bytes compactBigInteger(base::Byte sign, std::size_t length, const base::Bytes& magnitude)
+{
+    return base::Bytes({ sign }) + base::toBytes(length, base::SerializationFormat::COMPACT) + magnitude;
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(serialization_big_integer_binary)
+{
+    const auto compact = base::SerializationFormat::COMPACT;
+    std::vector<base::Uint256> values{ 0, 1, 255, 256, 1234567, ~base::Uint256{ 0 } };
+    for (const auto& value : values) {
+        BOOST_CHECK(base::fromBytes<base::Uint256>(base::toBytes(value, compact), compact) == value);
+    }
+
+    BOOST_CHECK(base::toBytes(base::Uint256{ 0 }, compact) == compactBigInteger(0x1, 0, {}));
+    BOOST_CHECK(base::toBytes(base::Uint256{ 0x1234 }, compact) == compactBigInteger(0x1, 2, { 0x12, 0x34 }));
+    BOOST_CHECK(base::toBytes(~base::Uint256{ 0 }, compact) == compactBigInteger(0x1, 32, base::Bytes(32, 0xFF)));
+
+    using Int512 = base::BigInteger<boost::multiprecision::cpp_int_backend<512,
+                                                                          512,
+                                                                          boost::multiprecision::signed_magnitude,
+                                                                          boost::multiprecision::checked,
+                                                                          void>>;
+    Int512 negative{ -0x1234 };
+    BOOST_CHECK(base::toBytes(negative, compact) == compactBigInteger(0x2, 2, { 0x12, 0x34 }));
+    BOOST_CHECK(base::fromBytes<Int512>(base::toBytes(negative, compact), compact) == negative);
+
+    // unbounded numbers have no limit on the magnitude length
+    boost::multiprecision::cpp_int huge = boost::multiprecision::cpp_int{ 1 } << 4000;
+    auto huge_bytes = base::toBytes(huge, compact);
+    BOOST_CHECK_EQUAL(huge_bytes.size(), compactBigInteger(0x1, 501, base::Bytes(501)).size());
+    BOOST_CHECK(base::fromBytes<boost::multiprecision::cpp_int>(huge_bytes, compact) == huge);
+}
+
+
+BOOST_AUTO_TEST_CASE(serialization_big_integer_fixed_is_decimal)
+{
+    // hashes of blocks and transactions are built on FIXED, so it must stay the decimal string
+    base::Uint256 value{ "123456789012345678901234567890" };
+    BOOST_CHECK(base::toBytes(value) == base::toBytes(value.str()));
+    BOOST_CHECK(base::fromBytes<base::Uint256>(base::toBytes(value.str())) == value);
+    BOOST_CHECK_EQUAL(base::serializedSize(value), base::toBytes(value).size());
+}
+
+
+BOOST_AUTO_TEST_CASE(serialization_big_integer_invalid)
+{
+    const auto compact = base::SerializationFormat::COMPACT;
+    // unknown sign
+    BOOST_CHECK_THROW(base::fromBytes<base::Uint256>(compactBigInteger(0x3, 0, {}), compact), base::InvalidArgument);
+    // negative number for an unsigned type
+    BOOST_CHECK_THROW(base::fromBytes<base::Uint256>(compactBigInteger(0x2, 1, { 0x5 }), compact),
+                      base::InvalidArgument);
+    // leading zeros
+    BOOST_CHECK_THROW(base::fromBytes<base::Uint256>(compactBigInteger(0x1, 2, { 0x0, 0x5 }), compact),
+                      base::InvalidArgument);
+    // truncated magnitude
+    BOOST_CHECK_THROW(base::fromBytes<base::Uint256>(compactBigInteger(0x1, 3, { 0x5 }), compact),
+                      base::InvalidArgument);
+    // too long for the type
+    base::Bytes too_long(33);
+    too_long[0] = 0x1;
+    BOOST_CHECK_THROW(base::fromBytes<base::Uint256>(compactBigInteger(0x1, 33, too_long), compact),
+                      base::InvalidArgument);
+}
+
+
+BOOST_AUTO_TEST_CASE(serialization_compact_integers)
+{
+    const auto compact = base::SerializationFormat::COMPACT;
+    BOOST_CHECK(base::toBytes(std::uint64_t{ 0 }, compact) == base::Bytes({ 0x0 }));
+    BOOST_CHECK(base::toBytes(std::uint64_t{ 127 }, compact) == base::Bytes({ 0x7F }));
+    BOOST_CHECK(base::toBytes(std::uint64_t{ 300 }, compact) == base::Bytes({ 0xAC, 0x2 }));
+    BOOST_CHECK(base::toBytes(std::int32_t{ -1 }, compact) == base::Bytes({ 0x1 }));
+    BOOST_CHECK(base::toBytes(std::int32_t{ 1 }, compact) == base::Bytes({ 0x2 }));
+    BOOST_CHECK_EQUAL(base::toBytes(std::numeric_limits<std::uint64_t>::max(), compact).size(), 10);
+
+    std::vector<std::uint64_t> unsigned_values{
+        0, 1, 127, 128, 16383, 16384, std::numeric_limits<std::uint64_t>::max()
+    };
+    for (auto value : unsigned_values) {
+        BOOST_CHECK_EQUAL(base::fromBytes<std::uint64_t>(base::toBytes(value, compact), compact), value);
+    }
+    std::vector<std::int64_t> signed_values{ 0,  -1, 1, -64, 64, std::numeric_limits<std::int64_t>::min(),
+                                             std::numeric_limits<std::int64_t>::max() };
+    for (auto value : signed_values) {
+        BOOST_CHECK_EQUAL(base::fromBytes<std::int64_t>(base::toBytes(value, compact), compact), value);
+    }
+    std::vector<std::int16_t> short_values{ 0, -1, std::numeric_limits<std::int16_t>::min(),
+                                            std::numeric_limits<std::int16_t>::max() };
+    for (auto value : short_values) {
+        BOOST_CHECK_EQUAL(base::fromBytes<std::int16_t>(base::toBytes(value, compact), compact), value);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(serialization_compact_containers)
+{
+    const auto compact = base::SerializationFormat::COMPACT;
+    base::Bytes bytes{ 0x1, 0x3, 0x5 };
+    BOOST_CHECK(base::toBytes(bytes, compact) == base::Bytes({ 0x3, 0x1, 0x3, 0x5 }));
+
+    std::vector<std::string> strings{ "abc", "", "some longer string" };
+    std::pair<std::uint32_t, std::optional<base::Bytes>> p{ 100000, base::Bytes(1000) };
+    base::Uint256 big{ "123456789012345678901234567890" };
+
+    BOOST_CHECK(base::fromBytes<std::vector<std::string>>(base::toBytes(strings, compact), compact) == strings);
+    auto serialized_pair = base::toBytes(p, compact);
+    base::SerializationIArchive ia(serialized_pair, compact);
+    BOOST_CHECK((ia.deserialize<std::uint32_t, std::optional<base::Bytes>>() == p));
+    BOOST_CHECK(base::fromBytes<base::Uint256>(base::toBytes(big, compact), compact) == big);
+    BOOST_CHECK_LT(base::toBytes(strings, compact).size(), base::toBytes(strings).size());
+}
+
+
+BOOST_AUTO_TEST_CASE(serialization_compact_invalid_varint)
+{
+    const auto compact = base::SerializationFormat::COMPACT;
+    // truncated
+    BOOST_CHECK_THROW(base::fromBytes<std::uint64_t>(base::Bytes({ 0x80 }), compact), base::InvalidArgument);
+    // not the shortest form
+    BOOST_CHECK_THROW(base::fromBytes<std::uint64_t>(base::Bytes({ 0x81, 0x0 }), compact), base::InvalidArgument);
+    // too long for the type
+    BOOST_CHECK_THROW(base::fromBytes<std::uint16_t>(base::Bytes({ 0xFF, 0xFF, 0x4 }), compact), base::InvalidArgument);
+    BOOST_CHECK_THROW(base::fromBytes<std::uint16_t>(base::Bytes({ 0x80, 0x80, 0x80, 0x1 }), compact),
+                      base::InvalidArgument);
+    BOOST_CHECK_EQUAL(base::fromBytes<std::uint16_t>(base::Bytes({ 0xFF, 0xFF, 0x3 }), compact), 0xFFFF);
+}
+
+
+BOOST_AUTO_TEST_CASE(serialization_fields_definition)
+{
+    FieldsSerialization value{ 7, "name", { base::Bytes{ 0x1, 0x2 }, base::Bytes{} } };
+
+    base::SerializationOArchive oa;
+    oa.serialize(value.id);
+    oa.serialize(value.name);
+    oa.serialize(value.payloads);
+    BOOST_CHECK(base::toBytes(value) == oa.getBytes());
+    BOOST_CHECK_EQUAL(base::serializedSize(value), oa.getBytes().size());
+
+    auto restored = base::fromBytes<FieldsSerialization>(base::toBytes(value));
+    BOOST_CHECK_EQUAL(restored.id, value.id);
+    BOOST_CHECK_EQUAL(restored.name, value.name);
+    BOOST_CHECK(restored.payloads == value.payloads);
+
+    PrivateFieldsSerialization private_value{ -12345, base::FixedBytes<4>{ 0x1, 0x2, 0x3, 0x4 } };
+    auto compact = base::toBytes(private_value, base::SerializationFormat::COMPACT);
+    auto restored_private = base::fromBytes<PrivateFieldsSerialization>(compact, base::SerializationFormat::COMPACT);
+    BOOST_CHECK_EQUAL(restored_private.getA(), private_value.getA());
+    BOOST_CHECK(restored_private.getB() == private_value.getB());
+}
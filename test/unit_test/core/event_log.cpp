@@ -0,0 +1,127 @@
+#include <boost/test/unit_test.hpp>
+
+#include "core/event_log.hpp"
+#include "core/log_index.hpp"
+
+#include <filesystem>
+
+namespace
+{
+
+lk::LogTopic makeTopic(base::Byte value)
+{
+    lk::LogTopic topic;
+    topic[31] = value;
+    return topic;
+}
+
+
+lk::EventLog makeLog(const lk::Address& address, std::vector<lk::LogTopic> topics)
+{
+    return lk::EventLog{ address, std::move(topics), base::Bytes{ 0x01, 0x02 } };
+}
+
+
+const lk::Address FIRST_ADDRESS{ "49cfqVfB1gTGw5XZSu6nZDrntLr1" };
+const lk::Address SECOND_ADDRESS{ lk::Address::null() };
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(event_log_serialization)
+{
+    lk::LogRecord record{ 7, base::Sha256::compute(base::Bytes{ 0x01 }), makeLog(FIRST_ADDRESS, { makeTopic(1) }) };
+
+    auto restored = base::fromBytes<lk::LogRecord>(base::toBytes(record));
+    BOOST_CHECK_EQUAL(restored.block_depth, 7);
+    BOOST_CHECK(restored.transaction_hash == record.transaction_hash);
+    BOOST_CHECK(restored.log == record.log);
+}
+
+
+BOOST_AUTO_TEST_CASE(event_log_bloom)
+{
+    lk::LogsBloom bloom;
+    bloom.add(makeLog(FIRST_ADDRESS, { makeTopic(1), makeTopic(2) }));
+
+    BOOST_CHECK(bloom.mayContain(base::Bytes(FIRST_ADDRESS.getBytes())));
+    BOOST_CHECK(bloom.mayContain(base::Bytes(makeTopic(1))));
+    BOOST_CHECK(bloom.mayContain(base::Bytes(makeTopic(2))));
+    BOOST_CHECK(!bloom.mayContain(base::Bytes(makeTopic(3))));
+
+    lk::LogsBloom restored{ bloom.getBytes() };
+    BOOST_CHECK(restored.mayContain(base::Bytes(makeTopic(2))));
+    BOOST_CHECK(!lk::LogsBloom{}.mayContain(base::Bytes(makeTopic(2))));
+}
+
+
+BOOST_AUTO_TEST_CASE(event_log_filter_matches)
+{
+    auto log = makeLog(FIRST_ADDRESS, { makeTopic(1), makeTopic(2) });
+
+    lk::LogsFilter filter;
+    BOOST_CHECK(filter.matches(log));
+
+    filter.address = FIRST_ADDRESS;
+    filter.topics = { std::nullopt, makeTopic(2) };
+    BOOST_CHECK(filter.matches(log));
+
+    filter.topics = { makeTopic(2) };
+    BOOST_CHECK(!filter.matches(log));
+
+    filter.topics = { makeTopic(1), makeTopic(2), std::nullopt }; // more topics than the log has
+    BOOST_CHECK(!filter.matches(log));
+
+    filter.topics.clear();
+    filter.address = SECOND_ADDRESS;
+    BOOST_CHECK(!filter.matches(log));
+}
+
+
+BOOST_AUTO_TEST_CASE(log_index_find)
+{
+    const std::filesystem::path database_path{ "local_test_log_index" };
+    std::filesystem::remove_all(database_path);
+    boost::property_tree::ptree config;
+    config.put("database.path", database_path.string());
+
+    {
+        lk::LogIndex index{ base::PropertyTree{ config } };
+        auto tx_hash = base::Sha256::compute(base::Bytes{ 0x01 });
+        index.addBlock(1, { { 1, tx_hash, makeLog(FIRST_ADDRESS, { makeTopic(1) }) } });
+        index.addBlock(2, {});
+        index.addBlock(3,
+                       { { 3, tx_hash, makeLog(SECOND_ADDRESS, { makeTopic(1), makeTopic(2) }) },
+                         { 3, tx_hash, makeLog(FIRST_ADDRESS, { makeTopic(2) }) } });
+        index.addBlock(3, {}); // already indexed, ignored
+
+        BOOST_CHECK(index.isIndexed(2));
+        BOOST_CHECK(!index.isIndexed(4));
+        BOOST_CHECK(!index.findBloom(2));
+        BOOST_CHECK(index.findBloom(3));
+
+        lk::LogsFilter all{ 0, 10, std::nullopt, {} };
+        BOOST_CHECK_EQUAL(index.find(all, 100).size(), 3);
+        BOOST_CHECK_THROW(index.find(all, 2), base::InvalidArgument);
+
+        lk::LogsFilter by_address{ 0, 10, FIRST_ADDRESS, {} };
+        auto found = index.find(by_address, 100);
+        BOOST_REQUIRE_EQUAL(found.size(), 2);
+        BOOST_CHECK_EQUAL(found[0].block_depth, 1);
+        BOOST_CHECK_EQUAL(found[1].block_depth, 3);
+        BOOST_CHECK(found[1].log.topics == std::vector<lk::LogTopic>{ makeTopic(2) });
+
+        lk::LogsFilter by_topic{ 0, 10, std::nullopt, { makeTopic(1) } };
+        BOOST_CHECK_EQUAL(index.find(by_topic, 100).size(), 2);
+
+        lk::LogsFilter by_second_topic{ 0, 10, std::nullopt, { std::nullopt, makeTopic(2) } };
+        found = index.find(by_second_topic, 100);
+        BOOST_REQUIRE_EQUAL(found.size(), 1);
+        BOOST_CHECK(found[0].log.address == SECOND_ADDRESS);
+
+        lk::LogsFilter by_range{ 2, 2, FIRST_ADDRESS, {} };
+        BOOST_CHECK(index.find(by_range, 100).empty());
+    }
+
+    std::filesystem::remove_all(database_path);
+}
@@ -0,0 +1,107 @@
+#include <boost/test/unit_test.hpp>
+
+#include "core/gas_estimation.hpp"
+
+#include "base/error.hpp"
+
+namespace
+{
+
+constexpr std::uint64_t MAX_GAS = 10'000'000;
+
+
+// a contract with a constant cost: it succeeds with any gas that covers it and leaves the rest
+class ConstantCostRun
+{
+  public:
+    explicit ConstantCostRun(std::uint64_t cost)
+      : _cost{ cost }
+    {}
+
+    std::optional<std::uint64_t> operator()(std::uint64_t gas)
+    {
+        ++runs_count;
+        if (gas < _cost) {
+            return std::nullopt;
+        }
+        return gas - _cost;
+    }
+
+    std::size_t runs_count{ 0 };
+
+  private:
+    std::uint64_t _cost;
+};
+
+
+// a contract that checks gas left before a nested call: with a lot of gas it uses less than it requires
+class GasCheckingRun
+{
+  public:
+    GasCheckingRun(std::uint64_t required_gas, std::uint64_t cost)
+      : _required_gas{ required_gas }
+      , _cost{ cost }
+    {}
+
+    std::optional<std::uint64_t> operator()(std::uint64_t gas)
+    {
+        if (gas < _required_gas) {
+            return std::nullopt;
+        }
+        return gas - _cost;
+    }
+
+  private:
+    std::uint64_t _required_gas;
+    std::uint64_t _cost;
+};
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(gas_estimation_contract_creation)
+{
+    ConstantCostRun run{ 123'456 };
+    auto gas = lk::findMinimalGas(MAX_GAS, std::ref(run));
+    BOOST_REQUIRE(gas);
+    BOOST_CHECK_EQUAL(*gas, 123'456);
+    // the gas used with the maximal gas is checked once and is enough, there is no search
+    BOOST_CHECK_EQUAL(run.runs_count, 2);
+}
+
+
+BOOST_AUTO_TEST_CASE(gas_estimation_contract_call)
+{
+    GasCheckingRun run{ 80'000, 30'000 };
+    auto gas = lk::findMinimalGas(MAX_GAS, run);
+    BOOST_REQUIRE(gas);
+    BOOST_CHECK_EQUAL(*gas, 80'000);
+    BOOST_CHECK(run(*gas));
+    BOOST_CHECK(!run(*gas - 1));
+}
+
+
+BOOST_AUTO_TEST_CASE(gas_estimation_out_of_gas_at_cap)
+{
+    BOOST_CHECK(!lk::findMinimalGas(MAX_GAS, ConstantCostRun{ MAX_GAS + 1 }));
+    BOOST_CHECK(!lk::findMinimalGas(MAX_GAS, GasCheckingRun{ MAX_GAS + 1, 1 }));
+
+    auto gas = lk::findMinimalGas(MAX_GAS, ConstantCostRun{ MAX_GAS });
+    BOOST_REQUIRE(gas);
+    BOOST_CHECK_EQUAL(*gas, MAX_GAS);
+}
+
+
+BOOST_AUTO_TEST_CASE(gas_estimation_payable_gas)
+{
+    // a transfer needs no gas, but the balance must cover its amount
+    BOOST_CHECK_EQUAL(lk::calcPayableGas(100, 100, MAX_GAS), 0);
+    BOOST_CHECK_THROW(lk::calcPayableGas(99, 100, MAX_GAS), base::InvalidArgument);
+
+    BOOST_CHECK_EQUAL(lk::calcPayableGas(50'000, 20'000, MAX_GAS), 30'000);
+    BOOST_CHECK_EQUAL(lk::calcPayableGas(lk::Balance{ MAX_GAS } * 1'000, 0, MAX_GAS), MAX_GAS);
+
+    // a search limited by the balance fails for a transaction the balance can't pay for
+    auto payable_gas = lk::calcPayableGas(50'000, 20'000, MAX_GAS);
+    BOOST_CHECK(!lk::findMinimalGas(payable_gas, ConstantCostRun{ 40'000 }));
+}
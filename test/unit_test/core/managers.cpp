@@ -0,0 +1,266 @@
+#include <boost/test/unit_test.hpp>
+
+#include "core/managers.hpp"
+
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+const lk::Address FIRST_ADDRESS{ "49cfqVfB1gTGw5XZSu6nZDrntLr1" };
+const lk::Address SECOND_ADDRESS{ lk::Address::null() };
+
+
+base::Sha256 makeKey(base::Byte value)
+{
+    return base::Sha256::compute(base::Bytes{ value });
+}
+
+
+lk::Address makeAddress(base::Byte value)
+{
+    base::FixedBytes<lk::Address::LENGTH_IN_BYTES> raw;
+    raw[0] = value;
+    return lk::Address{ raw };
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(state_transaction_commit)
+{
+    lk::StateManager state;
+    state.getAccount(FIRST_ADDRESS).setBalance(100);
+    {
+        lk::StateTransaction tx{ state };
+        BOOST_CHECK(state.tryTransferMoney(FIRST_ADDRESS, SECOND_ADDRESS, 30));
+        tx.commit();
+    }
+    BOOST_CHECK(!state.isInTransaction());
+    BOOST_CHECK_EQUAL(state.getAccount(FIRST_ADDRESS).getBalance(), 70);
+    BOOST_CHECK_EQUAL(state.getAccount(SECOND_ADDRESS).getBalance(), 30);
+}
+
+
+BOOST_AUTO_TEST_CASE(state_transaction_rollback)
+{
+    lk::StateManager state;
+    state.getAccount(FIRST_ADDRESS).setBalance(100);
+    state.getAccount(FIRST_ADDRESS).setStorageValue(makeKey(1), base::Bytes{ 0x01 });
+    {
+        lk::StateTransaction tx{ state };
+        BOOST_CHECK(state.tryTransferMoney(FIRST_ADDRESS, SECOND_ADDRESS, 30)); // creates the second account
+        auto& account = state.getAccount(FIRST_ADDRESS);
+        account.setStorageValue(makeKey(1), base::Bytes{ 0x02 });
+        account.setStorageValue(makeKey(2), base::Bytes{ 0x03 });
+        account.addTransactionHash(makeKey(3));
+        account.setRuntimeCode(base::Bytes{ 0x60, 0x00 });
+        // destroyed without commit
+    }
+    BOOST_CHECK(!state.hasAccount(SECOND_ADDRESS));
+    const auto& account = state.getAccount(FIRST_ADDRESS);
+    BOOST_CHECK_EQUAL(account.getBalance(), 100);
+    BOOST_CHECK_EQUAL(account.getNonce(), 0);
+    BOOST_CHECK(account.getStorageValue(makeKey(1)).data == base::Bytes{ 0x01 });
+    BOOST_CHECK(!account.checkStorageValue(makeKey(2)));
+    BOOST_CHECK(account.getRuntimeCode().isEmpty());
+}
+
+
+BOOST_AUTO_TEST_CASE(state_transaction_rollback_of_deleted_and_created_accounts)
+{
+    lk::StateManager state;
+    state.getAccount(FIRST_ADDRESS).setBalance(100);
+    {
+        lk::StateTransaction tx{ state };
+        auto contract_address = state.createContractAccount(FIRST_ADDRESS, makeKey(1));
+        BOOST_CHECK(state.hasAccount(contract_address));
+        BOOST_CHECK(state.deleteAccount(FIRST_ADDRESS));
+        tx.rollback();
+        BOOST_CHECK(!state.hasAccount(contract_address));
+    }
+    BOOST_REQUIRE(state.hasAccount(FIRST_ADDRESS));
+    BOOST_CHECK_EQUAL(state.getAccount(FIRST_ADDRESS).getBalance(), 100);
+}
+
+
+BOOST_AUTO_TEST_CASE(state_transaction_nested)
+{
+    lk::StateManager state;
+    state.getAccount(FIRST_ADDRESS).setBalance(100);
+
+    lk::StateTransaction outer{ state };
+    state.getAccount(FIRST_ADDRESS).subBalance(10);
+    {
+        lk::StateTransaction inner{ state };
+        state.getAccount(FIRST_ADDRESS).subBalance(20);
+        inner.rollback();
+    }
+    BOOST_CHECK_EQUAL(state.getAccount(FIRST_ADDRESS).getBalance(), 90);
+    {
+        lk::StateTransaction inner{ state };
+        state.getAccount(FIRST_ADDRESS).subBalance(30);
+        inner.commit();
+    }
+    BOOST_CHECK_EQUAL(state.getAccount(FIRST_ADDRESS).getBalance(), 60);
+
+    // the committed inner transaction is undone together with the outer one
+    outer.rollback();
+    BOOST_CHECK_EQUAL(state.getAccount(FIRST_ADDRESS).getBalance(), 100);
+}
+
+
+BOOST_AUTO_TEST_CASE(state_transaction_does_not_journal_copies)
+{
+    lk::StateManager state;
+    state.getAccount(FIRST_ADDRESS).setBalance(100);
+
+    lk::StateTransaction tx{ state };
+    auto copy = state.createCopy();
+    copy.getAccount(FIRST_ADDRESS).setBalance(1);
+    lk::AccountState detached{ state.getAccount(FIRST_ADDRESS) };
+    detached.setBalance(2);
+    tx.rollback();
+
+    BOOST_CHECK_EQUAL(state.getAccount(FIRST_ADDRESS).getBalance(), 100);
+    BOOST_CHECK_EQUAL(copy.getAccount(FIRST_ADDRESS).getBalance(), 1);
+}
+
+
+BOOST_AUTO_TEST_CASE(state_transaction_belongs_to_its_thread)
+{
+    lk::StateManager state;
+    state.getAccount(FIRST_ADDRESS).setBalance(100);
+    const auto snapshot = state.makeSnapshot(nullptr);
+
+    lk::StateTransaction tx{ state };
+    state.getAccount(FIRST_ADDRESS).subBalance(10);
+
+    // a reader sees the committed state through the snapshot, as RPC calls do while a block is applied
+    bool is_in_transaction_of_reader = true;
+    lk::Balance balance_seen_by_reader;
+    std::thread reader([&] {
+        is_in_transaction_of_reader = state.isInTransaction();
+        balance_seen_by_reader = snapshot->getAccount(FIRST_ADDRESS).getBalance();
+    });
+    reader.join();
+
+    BOOST_CHECK(!is_in_transaction_of_reader);
+    BOOST_CHECK_EQUAL(balance_seen_by_reader, 100);
+    BOOST_CHECK(state.isInTransaction());
+    tx.rollback();
+    BOOST_CHECK(!state.isInTransaction());
+    BOOST_CHECK_EQUAL(state.getAccount(FIRST_ADDRESS).getBalance(), 100);
+}
+
+
+BOOST_AUTO_TEST_CASE(state_overlay_does_not_change_its_base)
+{
+    auto base_state = std::make_shared<lk::StateManager>();
+    base_state->getAccount(FIRST_ADDRESS).setBalance(100);
+    base_state->getAccount(FIRST_ADDRESS).setStorageValue(makeKey(1), base::Bytes{ 0x01 });
+
+    lk::StateManager overlay{ std::shared_ptr<const lk::StateManager>{ base_state } };
+    BOOST_CHECK(overlay.hasAccount(FIRST_ADDRESS));
+    BOOST_CHECK(overlay.tryTransferMoney(FIRST_ADDRESS, SECOND_ADDRESS, 30));
+    overlay.getAccount(FIRST_ADDRESS).setStorageValue(makeKey(1), base::Bytes{ 0x02 });
+
+    BOOST_CHECK_EQUAL(overlay.getAccount(FIRST_ADDRESS).getBalance(), 70);
+    BOOST_CHECK_EQUAL(overlay.getAccount(SECOND_ADDRESS).getBalance(), 30);
+    BOOST_CHECK_EQUAL(base_state->getAccount(FIRST_ADDRESS).getBalance(), 100);
+    BOOST_CHECK(base_state->getAccount(FIRST_ADDRESS).getStorageValue(makeKey(1)).data == base::Bytes{ 0x01 });
+    BOOST_CHECK(!base_state->hasAccount(SECOND_ADDRESS));
+
+    BOOST_CHECK(overlay.deleteAccount(FIRST_ADDRESS));
+    BOOST_CHECK(!overlay.hasAccount(FIRST_ADDRESS));
+    BOOST_CHECK(base_state->hasAccount(FIRST_ADDRESS));
+}
+
+
+BOOST_AUTO_TEST_CASE(state_overlay_rollback)
+{
+    auto base_state = std::make_shared<lk::StateManager>();
+    base_state->getAccount(FIRST_ADDRESS).setBalance(100);
+
+    lk::StateManager overlay{ std::shared_ptr<const lk::StateManager>{ base_state } };
+    {
+        lk::StateTransaction tx{ overlay };
+        overlay.getAccount(FIRST_ADDRESS).subBalance(10);
+        BOOST_CHECK(overlay.deleteAccount(FIRST_ADDRESS));
+        overlay.getAccount(SECOND_ADDRESS).setBalance(5);
+        // destroyed without commit
+    }
+    BOOST_REQUIRE(overlay.hasAccount(FIRST_ADDRESS));
+    BOOST_CHECK_EQUAL(overlay.getAccount(FIRST_ADDRESS).getBalance(), 100);
+    BOOST_CHECK(!overlay.hasAccount(SECOND_ADDRESS));
+
+    overlay.getAccount(SECOND_ADDRESS).setBalance(5);
+    auto copy = overlay.createCopy();
+    BOOST_CHECK_EQUAL(copy.getAccount(FIRST_ADDRESS).getBalance(), 100);
+    BOOST_CHECK_EQUAL(copy.getAccount(SECOND_ADDRESS).getBalance(), 5);
+}
+
+
+BOOST_AUTO_TEST_CASE(state_snapshot_has_committed_changes_of_its_time)
+{
+    lk::StateManager state;
+    state.getAccount(FIRST_ADDRESS).setBalance(100);
+    auto first = state.makeSnapshot(nullptr);
+
+    BOOST_CHECK(state.tryTransferMoney(FIRST_ADDRESS, SECOND_ADDRESS, 30));
+    auto second = state.makeSnapshot(first);
+
+    const auto contract_address = state.createContractAccount(FIRST_ADDRESS, makeKey(1));
+    BOOST_CHECK(state.deleteAccount(SECOND_ADDRESS));
+    {
+        lk::StateTransaction tx{ state };
+        state.getAccount(FIRST_ADDRESS).subBalance(50);
+        // destroyed without commit
+    }
+    auto third = state.makeSnapshot(second);
+
+    BOOST_CHECK_EQUAL(first->getAccount(FIRST_ADDRESS).getBalance(), 100);
+    BOOST_CHECK(!first->hasAccount(SECOND_ADDRESS));
+    BOOST_CHECK_EQUAL(second->getAccount(FIRST_ADDRESS).getBalance(), 70);
+    BOOST_CHECK_EQUAL(second->getAccount(SECOND_ADDRESS).getBalance(), 30);
+    BOOST_CHECK(!second->hasAccount(contract_address));
+    BOOST_CHECK_EQUAL(third->getAccount(FIRST_ADDRESS).getBalance(), 70);
+    BOOST_CHECK(!third->hasAccount(SECOND_ADDRESS));
+    BOOST_CHECK(third->hasAccount(contract_address));
+}
+
+
+BOOST_AUTO_TEST_CASE(state_snapshot_merges_overlays)
+{
+    constexpr base::Byte ACCOUNTS_COUNT = 50;
+    lk::StateManager state;
+    state.getAccount(FIRST_ADDRESS).setBalance(1000);
+    auto snapshot = state.makeSnapshot(nullptr);
+
+    std::vector<std::shared_ptr<const lk::StateManager>> snapshots;
+    for (base::Byte i = 1; i <= ACCOUNTS_COUNT; ++i) {
+        BOOST_CHECK(state.tryTransferMoney(FIRST_ADDRESS, makeAddress(i), i));
+        if (i % 2 == 0) {
+            BOOST_CHECK(state.deleteAccount(makeAddress(i - 1)));
+        }
+        snapshot = state.makeSnapshot(snapshot);
+        snapshots.push_back(snapshot);
+    }
+
+    // merged overlays are new ones, so earlier snapshots stay as they were
+    for (base::Byte i = 1; i <= ACCOUNTS_COUNT; ++i) {
+        const auto& taken_after = *snapshots[i - 1];
+        BOOST_REQUIRE(taken_after.hasAccount(makeAddress(i)));
+        BOOST_CHECK_EQUAL(taken_after.getAccount(makeAddress(i)).getBalance(), i);
+        if (i < ACCOUNTS_COUNT) {
+            BOOST_CHECK(!taken_after.hasAccount(makeAddress(i + 1)));
+        }
+    }
+    for (base::Byte i = 1; i <= ACCOUNTS_COUNT; ++i) {
+        BOOST_CHECK_EQUAL(snapshot->hasAccount(makeAddress(i)), i % 2 == 0);
+    }
+    BOOST_CHECK_EQUAL(snapshot->getAccount(FIRST_ADDRESS).getBalance(), state.getAccount(FIRST_ADDRESS).getBalance());
+}
@@ -147,6 +147,19 @@ BOOST_AUTO_TEST_CASE(transaction_serialization2)
 }
 
 
+BOOST_AUTO_TEST_CASE(transaction_serialized_size)
+{
+    lk::Address from = lk::Address(base::Secp256PrivateKey().toPublicKey());
+    lk::Address to = lk::Address(base::Secp256PrivateKey().toPublicKey());
+    lk::Balance amount = 1239823409;
+    auto time = base::Time::now();
+    std::uint64_t fee{ 506 };
+    lk::Transaction tx(from, to, amount, fee, time, base::Bytes{ 0x1, 0x2, 0x3 });
+
+    BOOST_CHECK_EQUAL(tx.serializedSize(), base::toBytes(tx).size());
+}
+
+
 BOOST_AUTO_TEST_CASE(transaction_builder_set_all1)
 {
     lk::Address from = lk::Address(base::Secp256PrivateKey().toPublicKey());
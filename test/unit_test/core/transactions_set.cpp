@@ -216,3 +216,11 @@ BOOST_AUTO_TEST_CASE(transactions_set_serialixation)
     BOOST_CHECK(tx_set2.find(trans4));
     BOOST_CHECK(tx_set2.find(trans5));
 }
+
+
+BOOST_AUTO_TEST_CASE(transactions_set_serialized_size)
+{
+    auto tx_set = getTestSet();
+    BOOST_CHECK_EQUAL(tx_set.serializedSize(), base::toBytes(tx_set).size());
+    BOOST_CHECK_EQUAL(lk::TransactionsSet{}.serializedSize(), base::toBytes(lk::TransactionsSet{}).size());
+}
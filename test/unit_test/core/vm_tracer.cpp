@@ -0,0 +1,81 @@
+#include <boost/test/unit_test.hpp>
+
+#include "core/vm_tracer.hpp"
+
+#include <thread>
+
+namespace
+{
+
+const lk::Address FIRST_ADDRESS{ "49cfqVfB1gTGw5XZSu6nZDrntLr1" };
+const lk::Address SECOND_ADDRESS{ lk::Address::null() };
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(vm_tracer_enabling)
+{
+    lk::VmTracer tracer;
+    BOOST_CHECK(!tracer.isEnabled());
+    tracer.setEnabled(true);
+    BOOST_CHECK(tracer.isEnabled());
+    BOOST_CHECK(tracer.getTraces().empty());
+}
+
+
+BOOST_AUTO_TEST_CASE(vm_tracer_aggregates_calls)
+{
+    lk::VmTracer tracer{ true };
+    {
+        lk::VmTracer::Frame frame{ FIRST_ADDRESS, 0 };
+        frame.host_calls.storage_reads += 2;
+        frame.host_calls.logs += 1;
+        tracer.record(frame, 100, true);
+    }
+    {
+        lk::VmTracer::Frame frame{ FIRST_ADDRESS, 3 };
+        frame.host_calls.storage_writes += 1;
+        tracer.record(frame, 50, false);
+    }
+
+    auto traces = tracer.getTraces();
+    BOOST_REQUIRE_EQUAL(traces.size(), 1);
+    const auto& trace = traces.front();
+    BOOST_CHECK(trace.address == FIRST_ADDRESS);
+    BOOST_CHECK_EQUAL(trace.calls, 2);
+    BOOST_CHECK_EQUAL(trace.failed_calls, 1);
+    BOOST_CHECK_EQUAL(trace.gas_used, 150);
+    BOOST_CHECK_EQUAL(trace.max_depth, 3);
+    BOOST_CHECK_EQUAL(trace.host_calls.storage_reads, 2);
+    BOOST_CHECK_EQUAL(trace.host_calls.storage_writes, 1);
+    BOOST_CHECK_EQUAL(trace.host_calls.logs, 1);
+    BOOST_CHECK(trace.own_time <= trace.total_time);
+    BOOST_CHECK(trace.max_call_time <= trace.total_time);
+
+    tracer.reset();
+    BOOST_CHECK(tracer.getTraces().empty());
+}
+
+
+BOOST_AUTO_TEST_CASE(vm_tracer_excludes_nested_calls_from_own_time)
+{
+    lk::VmTracer tracer{ true };
+    lk::VmTracer::Frame outer{ FIRST_ADDRESS, 0 };
+    {
+        const auto started_at = lk::VmTracer::Clock::now();
+        lk::VmTracer::Frame inner{ SECOND_ADDRESS, 1 };
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        tracer.record(inner, 10, true);
+        outer.addNestedCallTime(lk::VmTracer::Clock::now() - started_at);
+    }
+    tracer.record(outer, 30, true);
+
+    auto traces = tracer.getTraces();
+    BOOST_REQUIRE_EQUAL(traces.size(), 2);
+    // sorted by total time, the outer call includes the inner one
+    BOOST_CHECK(traces[0].address == FIRST_ADDRESS);
+    BOOST_CHECK(traces[1].address == SECOND_ADDRESS);
+    BOOST_CHECK(traces[0].total_time >= std::chrono::milliseconds(20));
+    BOOST_CHECK(traces[0].own_time < std::chrono::milliseconds(20));
+    BOOST_CHECK(traces[1].own_time == traces[1].total_time);
+}
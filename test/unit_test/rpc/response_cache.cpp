@@ -0,0 +1,62 @@
+#include <boost/test/unit_test.hpp>
+
+#include <rpc/response_cache.hpp>
+
+
+BOOST_AUTO_TEST_CASE(response_cache_returns_put_values)
+{
+    rpc::ResponseCache<std::string> cache{ "test", 100 };
+    BOOST_CHECK(!cache.find("a"));
+
+    cache.put("a", "first", 5);
+    auto value = cache.find("a");
+    BOOST_CHECK(value);
+    BOOST_CHECK_EQUAL(*value, "first");
+
+    auto statistics = cache.getStatistics();
+    BOOST_CHECK_EQUAL(statistics.hits, 1);
+    BOOST_CHECK_EQUAL(statistics.misses, 1);
+    BOOST_CHECK_EQUAL(statistics.entries, 1);
+    BOOST_CHECK_EQUAL(statistics.size, 5);
+}
+
+
+BOOST_AUTO_TEST_CASE(response_cache_evicts_least_recently_used)
+{
+    rpc::ResponseCache<std::string> cache{ "test", 10 };
+    cache.put("a", "aaaa", 4);
+    cache.put("b", "bbbb", 4);
+    BOOST_CHECK(cache.find("a"));
+
+    cache.put("c", "cccc", 4);
+    BOOST_CHECK(cache.find("a"));
+    BOOST_CHECK(!cache.find("b"));
+    BOOST_CHECK(cache.find("c"));
+
+    auto statistics = cache.getStatistics();
+    BOOST_CHECK_EQUAL(statistics.evictions, 1);
+    BOOST_CHECK_EQUAL(statistics.entries, 2);
+    BOOST_CHECK_EQUAL(statistics.size, 8);
+}
+
+
+BOOST_AUTO_TEST_CASE(response_cache_skips_values_above_its_size)
+{
+    rpc::ResponseCache<std::string> cache{ "test", 4 };
+    cache.put("a", "aaaaa", 5);
+    BOOST_CHECK(!cache.find("a"));
+
+    rpc::ResponseCache<std::string> disabled{ "test", 0 };
+    disabled.put("a", "a", 1);
+    BOOST_CHECK(!disabled.find("a"));
+}
+
+
+BOOST_AUTO_TEST_CASE(response_cache_keeps_the_first_value_of_a_key)
+{
+    rpc::ResponseCache<std::string> cache{ "test", 100 };
+    cache.put("a", "first", 5);
+    cache.put("a", "second", 6);
+    BOOST_CHECK_EQUAL(*cache.find("a"), "first");
+    BOOST_CHECK_EQUAL(cache.getStatistics().size, 5);
+}
@@ -0,0 +1,93 @@
+#include <boost/test/unit_test.hpp>
+
+#include <rpc/subscription.hpp>
+
+#include <thread>
+
+namespace
+{
+
+constexpr std::chrono::milliseconds NO_WAIT{ 0 };
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(subscription_delivers_events_in_order)
+{
+    rpc::SubscriptionHub<int> hub{ 10 };
+    auto first = hub.subscribe();
+    auto second = hub.subscribe();
+
+    hub.publish(1);
+    hub.publish(2);
+
+    BOOST_CHECK_EQUAL(first->pop(NO_WAIT).value(), 1);
+    BOOST_CHECK_EQUAL(first->pop(NO_WAIT).value(), 2);
+    BOOST_CHECK(!first->pop(NO_WAIT));
+
+    auto events = second->popAll(NO_WAIT);
+    BOOST_CHECK(events == std::vector<int>({ 1, 2 }));
+}
+
+
+BOOST_AUTO_TEST_CASE(subscription_filters_events)
+{
+    rpc::SubscriptionHub<int> hub{ 10 };
+    auto even = hub.subscribe([](int event) { return event % 2 == 0; });
+
+    for (int i = 0; i < 5; ++i) {
+        hub.publish(i);
+    }
+
+    BOOST_CHECK(even->popAll(NO_WAIT) == std::vector<int>({ 0, 2, 4 }));
+}
+
+
+BOOST_AUTO_TEST_CASE(subscription_drops_slow_consumer)
+{
+    rpc::SubscriptionHub<int> hub{ 2 };
+    auto slow = hub.subscribe();
+    auto fast = hub.subscribe();
+
+    for (int i = 0; i < 3; ++i) {
+        hub.publish(i);
+        if (i < 2) {
+            BOOST_CHECK_EQUAL(fast->pop(NO_WAIT).value(), i);
+        }
+    }
+
+    BOOST_CHECK(slow->isOverflowed());
+    BOOST_CHECK(slow->isClosed());
+    BOOST_CHECK(!slow->pop(NO_WAIT));
+    BOOST_CHECK(!fast->isOverflowed());
+    BOOST_CHECK_EQUAL(hub.countSubscriptions(), 1);
+}
+
+
+BOOST_AUTO_TEST_CASE(subscription_released_by_owner_is_forgotten)
+{
+    rpc::SubscriptionHub<int> hub{ 10 };
+    auto subscription = hub.subscribe();
+    BOOST_CHECK_EQUAL(hub.countSubscriptions(), 1);
+
+    subscription.reset();
+    hub.publish(1);
+    BOOST_CHECK_EQUAL(hub.countSubscriptions(), 0);
+}
+
+
+BOOST_AUTO_TEST_CASE(subscription_pop_waits_for_event)
+{
+    rpc::SubscriptionHub<int> hub{ 10 };
+    auto subscription = hub.subscribe();
+
+    std::thread publisher([&hub] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 20 });
+        hub.publish(42);
+    });
+    auto event = subscription->pop(std::chrono::milliseconds{ 5'000 });
+    publisher.join();
+
+    BOOST_REQUIRE(event);
+    BOOST_CHECK_EQUAL(*event, 42);
+}
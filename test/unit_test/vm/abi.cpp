@@ -0,0 +1,283 @@
+#include <boost/test/unit_test.hpp>
+
+#include "vm/abi.hpp"
+#include "vm/abi_registry.hpp"
+
+#include <boost/property_tree/json_parser.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+// golden vectors are the examples of the Solidity ABI specification
+
+namespace
+{
+
+boost::property_tree::ptree makeMetadata(const std::string& abi)
+{
+    std::istringstream input{ R"({"output": {"abi": )" + abi + "}}" };
+    boost::property_tree::ptree ret;
+    boost::property_tree::read_json(input, ret);
+    return ret;
+}
+
+
+const vm::ContractAbi& specContract()
+{
+    static const vm::ContractAbi contract{ makeMetadata(R"([
+        {"type": "function", "name": "baz", "outputs": [{"name": "r", "type": "bool"}],
+         "inputs": [{"name": "x", "type": "uint32"}, {"name": "y", "type": "bool"}]},
+        {"type": "function", "name": "bar", "outputs": [],
+         "inputs": [{"name": "", "type": "bytes3[2]"}]},
+        {"type": "function", "name": "sam", "outputs": [],
+         "inputs": [{"name": "", "type": "bytes"}, {"name": "", "type": "bool"}, {"name": "", "type": "uint256[]"}]},
+        {"type": "function", "name": "f", "outputs": [],
+         "inputs": [{"name": "", "type": "uint256"}, {"name": "", "type": "uint32[]"},
+                    {"name": "", "type": "bytes10"}, {"name": "", "type": "bytes"}]},
+        {"type": "function", "name": "g", "outputs": [],
+         "inputs": [{"name": "", "type": "uint256[][]"}, {"name": "", "type": "string[]"}]},
+        {"type": "constructor", "inputs": [{"name": "value", "type": "uint256"}]}
+    ])") };
+    return contract;
+}
+
+
+base::Bytes fromHex(const std::string& hex)
+{
+    return base::fromHex<base::Bytes>(hex);
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(abi_type_parse)
+{
+    BOOST_CHECK_EQUAL(vm::AbiType::fromString("uint").getCanonicalName(), "uint256");
+    BOOST_CHECK_EQUAL(vm::AbiType::fromString("int").getCanonicalName(), "int256");
+
+    auto fixed_array = vm::AbiType::fromString("uint8[3]");
+    BOOST_CHECK(fixed_array.getKind() == vm::AbiType::Kind::FIXED_ARRAY);
+    BOOST_CHECK(!fixed_array.isDynamic());
+    BOOST_CHECK_EQUAL(fixed_array.getHeadSize(), 96);
+
+    auto nested = vm::AbiType::fromString("uint256[2][]");
+    BOOST_CHECK(nested.getKind() == vm::AbiType::Kind::ARRAY);
+    BOOST_CHECK_EQUAL(nested.getComponents().front().getCanonicalName(), "uint256[2]");
+    BOOST_CHECK(nested.isDynamic());
+
+    auto tuple = vm::AbiType::fromString("((uint8,bool),bytes)[2]");
+    BOOST_CHECK_EQUAL(tuple.getCanonicalName(), "((uint8,bool),bytes)[2]");
+    BOOST_CHECK(tuple.isDynamic());
+    BOOST_CHECK_EQUAL(tuple.getHeadSize(), 32);
+    BOOST_CHECK_EQUAL(tuple.getComponents().front().getComponents().front().getHeadSize(), 64);
+
+    BOOST_CHECK_THROW(vm::AbiType::fromString("uint7"), base::InvalidArgument);
+    BOOST_CHECK_THROW(vm::AbiType::fromString("bytes33"), base::InvalidArgument);
+    BOOST_CHECK_THROW(vm::AbiType::fromString("uint256[0]"), base::InvalidArgument);
+    BOOST_CHECK_THROW(vm::AbiType::fromString("fixed128x18"), base::InvalidArgument);
+}
+
+
+BOOST_AUTO_TEST_CASE(abi_function_selectors)
+{
+    const auto& functions = specContract().getFunctions();
+    BOOST_REQUIRE_EQUAL(functions.size(), 5);
+
+    BOOST_CHECK_EQUAL(functions[0].getSignature(), "baz(uint32,bool)");
+    BOOST_CHECK_EQUAL(base::toHex(functions[0].getSelector()), "cdcd77c0");
+    BOOST_CHECK_EQUAL(functions[1].getSignature(), "bar(bytes3[2])");
+    BOOST_CHECK_EQUAL(base::toHex(functions[1].getSelector()), "fce353f6");
+    BOOST_CHECK_EQUAL(functions[2].getSignature(), "sam(bytes,bool,uint256[])");
+    BOOST_CHECK_EQUAL(base::toHex(functions[2].getSelector()), "a5643bf2");
+    BOOST_CHECK_EQUAL(functions[3].getSignature(), "f(uint256,uint32[],bytes10,bytes)");
+    BOOST_CHECK_EQUAL(base::toHex(functions[3].getSelector()), "8be65246");
+    BOOST_CHECK_EQUAL(functions[4].getSignature(), "g(uint256[][],string[])");
+    BOOST_CHECK_EQUAL(base::toHex(functions[4].getSelector()), "2289b18c");
+}
+
+
+BOOST_AUTO_TEST_CASE(abi_encode_static)
+{
+    BOOST_CHECK_EQUAL(specContract().encodeCall("baz(69, true)", {}),
+                      fromHex("cdcd77c0"
+                              "0000000000000000000000000000000000000000000000000000000000000045"
+                              "0000000000000000000000000000000000000000000000000000000000000001"));
+
+    BOOST_CHECK_EQUAL(specContract().encodeCall(R"(bar(["0x616263", "0x646566"]))", {}),
+                      fromHex("fce353f6"
+                              "6162630000000000000000000000000000000000000000000000000000000000"
+                              "6465660000000000000000000000000000000000000000000000000000000000"));
+}
+
+
+BOOST_AUTO_TEST_CASE(abi_encode_dynamic)
+{
+    BOOST_CHECK_EQUAL(specContract().encodeCall(R"(sam("0x64617665", true, [1, 2, 3]))", {}),
+                      fromHex("a5643bf2"
+                              "0000000000000000000000000000000000000000000000000000000000000060"
+                              "0000000000000000000000000000000000000000000000000000000000000001"
+                              "00000000000000000000000000000000000000000000000000000000000000a0"
+                              "0000000000000000000000000000000000000000000000000000000000000004"
+                              "6461766500000000000000000000000000000000000000000000000000000000"
+                              "0000000000000000000000000000000000000000000000000000000000000003"
+                              "0000000000000000000000000000000000000000000000000000000000000001"
+                              "0000000000000000000000000000000000000000000000000000000000000002"
+                              "0000000000000000000000000000000000000000000000000000000000000003"));
+
+    BOOST_CHECK_EQUAL(
+      specContract().encodeCall(R"(f(0x123, [0x456, 0x789], "0x31323334353637383930", "0x48656c6c6f2c20776f726c6421"))",
+                                {}),
+      fromHex("8be65246"
+              "0000000000000000000000000000000000000000000000000000000000000123"
+              "0000000000000000000000000000000000000000000000000000000000000080"
+              "3132333435363738393000000000000000000000000000000000000000000000"
+              "00000000000000000000000000000000000000000000000000000000000000e0"
+              "0000000000000000000000000000000000000000000000000000000000000002"
+              "0000000000000000000000000000000000000000000000000000000000000456"
+              "0000000000000000000000000000000000000000000000000000000000000789"
+              "000000000000000000000000000000000000000000000000000000000000000d"
+              "48656c6c6f2c20776f726c642100000000000000000000000000000000000000"));
+}
+
+
+BOOST_AUTO_TEST_CASE(abi_encode_nested_dynamic)
+{
+    BOOST_CHECK_EQUAL(specContract().encodeCall(R"(g([[1, 2], [3]], ["one", "two", "three"]))", {}),
+                      fromHex("2289b18c"
+                              "0000000000000000000000000000000000000000000000000000000000000040"
+                              "0000000000000000000000000000000000000000000000000000000000000140"
+                              "0000000000000000000000000000000000000000000000000000000000000002"
+                              "0000000000000000000000000000000000000000000000000000000000000040"
+                              "00000000000000000000000000000000000000000000000000000000000000a0"
+                              "0000000000000000000000000000000000000000000000000000000000000002"
+                              "0000000000000000000000000000000000000000000000000000000000000001"
+                              "0000000000000000000000000000000000000000000000000000000000000002"
+                              "0000000000000000000000000000000000000000000000000000000000000001"
+                              "0000000000000000000000000000000000000000000000000000000000000003"
+                              "0000000000000000000000000000000000000000000000000000000000000003"
+                              "0000000000000000000000000000000000000000000000000000000000000060"
+                              "00000000000000000000000000000000000000000000000000000000000000a0"
+                              "00000000000000000000000000000000000000000000000000000000000000e0"
+                              "0000000000000000000000000000000000000000000000000000000000000003"
+                              "6f6e650000000000000000000000000000000000000000000000000000000000"
+                              "0000000000000000000000000000000000000000000000000000000000000003"
+                              "74776f0000000000000000000000000000000000000000000000000000000000"
+                              "0000000000000000000000000000000000000000000000000000000000000005"
+                              "7468726565000000000000000000000000000000000000000000000000000000"));
+}
+
+
+BOOST_AUTO_TEST_CASE(abi_encode_tuple)
+{
+    auto metadata = makeMetadata(R"([{"type": "function", "name": "h", "outputs": [], "inputs": [
+        {"name": "t", "type": "tuple", "components": [{"name": "a", "type": "uint256"}, {"name": "b", "type": "string"}]}
+    ]}])");
+    vm::ContractAbi contract{ metadata };
+    BOOST_CHECK_EQUAL(contract.getFunctions().front().getSignature(), "h((uint256,string))");
+
+    BOOST_CHECK_EQUAL(vm::abiEncode(contract.getFunctions().front().getInputs(), R"([5, "ab"])"),
+                      fromHex("0000000000000000000000000000000000000000000000000000000000000020"
+                              "0000000000000000000000000000000000000000000000000000000000000005"
+                              "0000000000000000000000000000000000000000000000000000000000000040"
+                              "0000000000000000000000000000000000000000000000000000000000000002"
+                              "6162000000000000000000000000000000000000000000000000000000000000"));
+}
+
+
+BOOST_AUTO_TEST_CASE(abi_encode_integers_range)
+{
+    std::vector types{ vm::AbiType::fromString("int8") };
+    BOOST_CHECK_EQUAL(vm::abiEncode(types, "-1"),
+                      fromHex("ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"));
+    BOOST_CHECK_EQUAL(vm::abiEncode(types, "-128"),
+                      fromHex("ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff80"));
+    BOOST_CHECK_THROW(vm::abiEncode(types, "128"), base::InvalidArgument);
+    BOOST_CHECK_THROW(vm::abiEncode(types, "-129"), base::InvalidArgument);
+
+    std::vector unsigned_types{ vm::AbiType::fromString("uint8") };
+    BOOST_CHECK_THROW(vm::abiEncode(unsigned_types, "256"), base::InvalidArgument);
+    BOOST_CHECK_THROW(vm::abiEncode(unsigned_types, "-1"), base::InvalidArgument);
+    BOOST_CHECK_THROW(vm::abiEncode(unsigned_types, "true"), base::InvalidArgument);
+    BOOST_CHECK_THROW(vm::abiEncode(unsigned_types, "1, 2"), base::InvalidArgument);
+}
+
+
+BOOST_AUTO_TEST_CASE(abi_encode_overloads_and_constructor)
+{
+    vm::ContractAbi contract{ makeMetadata(R"([
+        {"type": "function", "name": "set", "outputs": [], "inputs": [{"name": "", "type": "uint256"}]},
+        {"type": "function", "name": "set", "outputs": [], "inputs": [{"name": "", "type": "string"}]},
+        {"type": "constructor", "inputs": [{"name": "owner", "type": "address"}]}
+    ])") };
+
+    const auto& by_number = contract.findFunction("set", "5");
+    const auto& by_string = contract.findFunction("set", R"("five")");
+    BOOST_CHECK_EQUAL(by_number.getSignature(), "set(uint256)");
+    BOOST_CHECK_EQUAL(by_string.getSignature(), "set(string)");
+    BOOST_CHECK_THROW(contract.findFunction("set", "[1]"), base::InvalidArgument);
+    BOOST_CHECK_THROW(contract.encodeCall("unknown()", {}), base::InvalidArgument);
+
+    base::FixedBytes<20> address;
+    address[19] = 0xAB;
+    auto bytecode = fromHex("6080604052");
+    BOOST_CHECK_EQUAL(contract.encodeCall("constructor(Address(" + base::base58Encode(address) + "))", bytecode),
+                      bytecode + fromHex("00000000000000000000000000000000000000000000000000000000000000ab"));
+}
+
+
+BOOST_AUTO_TEST_CASE(abi_decode_output)
+{
+    vm::ContractAbi contract{ makeMetadata(R"([{"type": "function", "name": "get", "inputs": [], "outputs": [
+        {"name": "", "type": "uint256"}, {"name": "delta", "type": "int16"}, {"name": "ok", "type": "bool"},
+        {"name": "owner", "type": "address"}, {"name": "data", "type": "bytes"},
+        {"name": "tags", "type": "string[]"}, {"name": "pair", "type": "uint8[2]"}
+    ]}])") };
+    const auto& function = contract.getFunctions().front();
+
+    base::FixedBytes<20> address;
+    address[0] = 0x01;
+    auto data = vm::abiEncode(function.getOutputs(),
+                              R"(7, -2, true, ")" + base::toHex(address) + R"(", "0xbeef", ["a\"b", ""], [3, 4])");
+
+    auto expected = R"({"": 7, "delta": -2, "ok": true, "owner": ")" + base::base58Encode(address) +
+                    R"(", "data": "beef", "tags": ["a\"b", ""], "pair": [3, 4]})";
+    BOOST_CHECK_EQUAL(function.decodeOutput(data), expected);
+    BOOST_CHECK_EQUAL(contract.decodeOutput(base::Bytes(function.getSelector()) + data), expected);
+
+    BOOST_CHECK_THROW(function.decodeOutput(data.takePart(0, 100)), base::InvalidArgument);
+    BOOST_CHECK_THROW(contract.decodeOutput(fromHex("00000000")), base::InvalidArgument);
+}
+
+
+BOOST_AUTO_TEST_CASE(abi_registry_parses_folder_once)
+{
+    auto folder = std::filesystem::temp_directory_path() / "likelib_abi_registry_test";
+    std::filesystem::create_directories(folder);
+    std::ofstream(folder / "compiled_code.bin") << "6080604052\n";
+    std::ofstream(folder / "metadata.json")
+      << R"({"output": {"abi": [{"type": "function", "name": "get", "inputs": [], "outputs": []}]}})";
+
+    vm::AbiRegistry registry;
+    auto contract = registry.load(folder);
+    BOOST_CHECK_EQUAL(contract->bytecode, fromHex("6080604052"));
+    BOOST_CHECK_EQUAL(contract->abi.getFunctions().size(), 1);
+    BOOST_CHECK_EQUAL(registry.load(folder / "."), contract);
+    BOOST_CHECK_EQUAL(registry.find(base::Keccak256::compute(fromHex("6080604052"))), contract);
+    BOOST_CHECK_EQUAL(registry.size(), 1);
+
+    // rewritten metadata is picked up
+    std::ofstream(folder / "metadata.json") << R"({"output": {"abi": []}})";
+    std::filesystem::last_write_time(folder / "metadata.json",
+                                     std::filesystem::last_write_time(folder / "metadata.json") +
+                                       std::chrono::seconds{ 1 });
+    auto reloaded = registry.load(folder);
+    BOOST_CHECK_NE(reloaded, contract);
+    BOOST_CHECK(reloaded->abi.getFunctions().empty());
+    BOOST_CHECK_EQUAL(registry.size(), 1);
+
+    registry.clear();
+    BOOST_CHECK(!registry.find(reloaded->code_hash));
+    std::filesystem::remove_all(folder);
+    BOOST_CHECK_THROW(registry.load(folder), base::InvalidArgument);
+}
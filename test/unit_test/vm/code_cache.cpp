@@ -0,0 +1,63 @@
+#include <boost/test/unit_test.hpp>
+
+#include <vm/code_cache.hpp>
+
+BOOST_AUTO_TEST_CASE(code_cache_intern_shares_code)
+{
+    vm::CodeCache cache;
+    base::Bytes code{ 0x60, 0x00, 0x60, 0x00, 0xf3 };
+
+    auto first = cache.intern(code);
+    auto second = cache.intern(code);
+    BOOST_CHECK(first == second);
+    BOOST_CHECK(*first == code);
+
+    auto other = cache.intern(base::Bytes{ 0x00 });
+    BOOST_CHECK(other != first);
+
+    auto statistics = cache.getStatistics();
+    BOOST_CHECK_EQUAL(statistics.hits, 1);
+    BOOST_CHECK_EQUAL(statistics.misses, 2);
+    BOOST_CHECK_EQUAL(statistics.entries, 2);
+}
+
+
+BOOST_AUTO_TEST_CASE(code_cache_does_not_keep_unused_code)
+{
+    vm::CodeCache cache;
+    base::Bytes code{ 0x60, 0x01, 0x00 };
+
+    auto interned = cache.intern(code);
+    interned.reset();
+    interned = cache.intern(code);
+    BOOST_CHECK(*interned == code);
+
+    auto statistics = cache.getStatistics();
+    BOOST_CHECK_EQUAL(statistics.hits, 0);
+    BOOST_CHECK_EQUAL(statistics.misses, 2);
+}
+
+
+BOOST_AUTO_TEST_CASE(code_cache_empty_code)
+{
+    vm::CodeCache cache;
+    auto code = cache.intern(base::Bytes{});
+    BOOST_CHECK(code == vm::CodeCache::empty());
+    BOOST_CHECK(code->isEmpty());
+    BOOST_CHECK_EQUAL(cache.getStatistics().entries, 0);
+}
+
+
+BOOST_AUTO_TEST_CASE(code_cache_removes_unused_code)
+{
+    vm::CodeCache cache;
+    for (std::uint8_t i = 0; i < 200; ++i) {
+        cache.intern(base::Bytes{ 0x60, i });
+    }
+    auto kept = cache.intern(base::Bytes{ 0x60, 0x60, 0x60 });
+
+    auto statistics = cache.getStatistics();
+    BOOST_CHECK_EQUAL(statistics.misses, 201);
+    BOOST_CHECK(statistics.entries < 200);
+    BOOST_CHECK(cache.intern(*kept) == kept);
+}
@@ -0,0 +1,129 @@
+#include <boost/test/unit_test.hpp>
+
+#include <vm/error.hpp>
+#include <vm/pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(vm_pool_run_returns_result)
+{
+    vm::Pool pool{ 2 };
+    BOOST_CHECK_EQUAL(pool.getWorkersCount(), 2);
+
+    auto result = pool.run([](evmc::VM&) { return 42; }, std::chrono::milliseconds{ 1000 });
+    BOOST_CHECK_EQUAL(result, 42);
+
+    auto statistics = pool.getStatistics();
+    BOOST_CHECK_EQUAL(statistics.executed, 1);
+    BOOST_CHECK_EQUAL(statistics.expired, 0);
+    BOOST_CHECK_EQUAL(statistics.queued, 0);
+}
+
+
+BOOST_AUTO_TEST_CASE(vm_pool_passes_exceptions)
+{
+    vm::Pool pool{ 1 };
+    BOOST_CHECK_THROW(pool.run([](evmc::VM&) -> int { RAISE_ERROR(base::InvalidArgument, "test"); },
+                               std::chrono::milliseconds{ 1000 }),
+                      base::InvalidArgument);
+}
+
+
+BOOST_AUTO_TEST_CASE(vm_pool_runs_jobs_in_parallel)
+{
+    constexpr std::size_t WORKERS_COUNT = 4;
+    vm::Pool pool{ WORKERS_COUNT };
+
+    // every job waits until all of them are started, so it would hang on a single worker
+    std::atomic<std::size_t> started{ 0 };
+    std::vector<std::future<std::thread::id>> results;
+    for (std::size_t i = 0; i < WORKERS_COUNT; ++i) {
+        results.push_back(std::async(std::launch::async, [&pool, &started] {
+            return pool.run(
+              [&started](evmc::VM&) {
+                  ++started;
+                  while (started < WORKERS_COUNT) {
+                      std::this_thread::yield();
+                  }
+                  return std::this_thread::get_id();
+              },
+              std::chrono::milliseconds{ 10000 });
+        }));
+    }
+
+    std::vector<std::thread::id> threads;
+    for (auto& result : results) {
+        threads.push_back(result.get());
+    }
+    std::sort(threads.begin(), threads.end());
+    BOOST_CHECK(std::unique(threads.begin(), threads.end()) == threads.end());
+    BOOST_CHECK_EQUAL(pool.getStatistics().executed, WORKERS_COUNT);
+}
+
+
+BOOST_AUTO_TEST_CASE(vm_pool_time_budget)
+{
+    vm::Pool pool{ 1 };
+
+    std::promise<void> release;
+    auto blocker = release.get_future().share();
+    auto busy = std::async(std::launch::async, [&pool, blocker] {
+        pool.run([blocker](evmc::VM&) { blocker.wait(); }, std::chrono::milliseconds{ 10000 });
+    });
+    while (pool.getStatistics().executed == 0) {
+        std::this_thread::yield();
+    }
+
+    // the only worker is busy, so this job can't even start in time
+    bool was_run{ false };
+    BOOST_CHECK_THROW(pool.run([&was_run](evmc::VM&) { was_run = true; }, std::chrono::milliseconds{ 50 }),
+                      vm::VmError);
+    BOOST_CHECK_EQUAL(pool.getStatistics().queued, 1);
+
+    release.set_value();
+    busy.get();
+
+    // the expired job is dropped without being run
+    BOOST_CHECK_EQUAL(pool.run([](evmc::VM&) { return 1; }, std::chrono::milliseconds{ 1000 }), 1);
+    BOOST_CHECK(!was_run);
+    auto statistics = pool.getStatistics();
+    BOOST_CHECK_EQUAL(statistics.expired, 1);
+    BOOST_CHECK_EQUAL(statistics.executed, 2);
+    BOOST_CHECK(statistics.max_wait >= std::chrono::milliseconds{ 50 });
+}
+
+
+BOOST_AUTO_TEST_CASE(vm_pool_fails_queued_jobs_on_destruction)
+{
+    auto pool = std::make_unique<vm::Pool>(1);
+
+    std::promise<void> release;
+    auto blocker = release.get_future().share();
+    auto busy = std::async(std::launch::async, [&pool, blocker] {
+        pool->run([blocker](evmc::VM&) { blocker.wait(); }, std::chrono::milliseconds{ 10000 });
+    });
+    while (pool->getStatistics().executed == 0) {
+        std::this_thread::yield();
+    }
+
+    auto queued = std::async(std::launch::async, [&pool] {
+        return pool->run([](evmc::VM&) { return 1; }, std::chrono::milliseconds{ 10000 });
+    });
+    while (pool->getStatistics().queued == 0) {
+        std::this_thread::yield();
+    }
+
+    // the pool is stopping while the only worker is busy, so the queued job never starts
+    auto destroyed = std::async(std::launch::async, [&pool] { pool.reset(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });
+    release.set_value();
+    destroyed.get();
+    busy.get();
+
+    BOOST_CHECK_THROW(queued.get(), vm::VmError);
+}
@@ -3,9 +3,15 @@
 #include <vm/tools.hpp>
 #include <vm/vm.hpp>
 
+#include <boost/process/search_path.hpp>
+
+#include <algorithm>
+#include <cstdlib>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <map>
+#include <string>
 
 class HostImplementation : public evmc::Host
 {
@@ -238,3 +244,147 @@ contract SimpleStorage {
 
     std::filesystem::remove(code_file_path);
 }
+
+
+namespace
+{
+
+// puts a solc wrapper first in PATH, that counts its runs and calls the real compiler
+class CountingSolc
+{
+  public:
+    explicit CountingSolc(const std::filesystem::path& folder)
+      : _folder{ folder }
+      , _runs_path{ folder / "runs" }
+      , _old_path{ std::getenv("PATH") ? std::getenv("PATH") : "" }
+    {
+        auto real_solc = boost::process::search_path("solc");
+        BOOST_REQUIRE(!real_solc.empty());
+
+        std::filesystem::remove_all(_folder);
+        std::filesystem::create_directories(_folder);
+        auto wrapper_path = _folder / "solc";
+        std::ofstream(wrapper_path) << "#!/bin/sh\necho run >> '" << _runs_path.string() << "'\nexec '"
+                                    << real_solc.string() << "' \"$@\"\n";
+        std::filesystem::permissions(wrapper_path, std::filesystem::perms::owner_all);
+        ::setenv("PATH", (_folder.string() + ':' + _old_path).c_str(), 1);
+    }
+
+    ~CountingSolc()
+    {
+        ::setenv("PATH", _old_path.c_str(), 1);
+        std::filesystem::remove_all(_folder);
+    }
+
+    std::size_t getRunsCount() const
+    {
+        std::ifstream runs(_runs_path);
+        std::size_t count = 0;
+        for (std::string line; std::getline(runs, line);) {
+            ++count;
+        }
+        return count;
+    }
+
+  private:
+    std::filesystem::path _folder;
+    std::filesystem::path _runs_path;
+    std::string _old_path;
+};
+
+
+const vm::CompiledContract& findContract(const vm::Contracts& contracts, const std::string& name)
+{
+    auto it = std::find_if(
+      contracts.begin(), contracts.end(), [&name](const vm::CompiledContract& c) { return c.name == name; });
+    BOOST_REQUIRE(it != contracts.end());
+    return *it;
+}
+
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(vm_compile_cache)
+{
+    const char* source_code = R"raw(
+pragma solidity >=0.4.0 <0.7.0;
+
+contract CachedStorage {
+    uint storedData;
+
+    function get() public view returns (uint) {
+        return storedData;
+    }
+}
+)raw";
+
+    CountingSolc solc{ std::filesystem::temp_directory_path() / "likelib_vm_compile_cache_solc" };
+    std::filesystem::path code_file_path = "vm_compile_cache.sol";
+    auto cache_folder = std::filesystem::temp_directory_path() / "likelib_vm_compile_cache_test";
+    std::filesystem::remove_all(cache_folder);
+
+    std::ofstream(code_file_path) << source_code;
+
+    auto compiled = vm::compile(code_file_path.string(), cache_folder);
+    BOOST_REQUIRE(compiled && compiled->size() == 1);
+    BOOST_CHECK(!std::filesystem::is_empty(cache_folder));
+    BOOST_CHECK_EQUAL(solc.getRunsCount(), 1);
+
+    auto cached = vm::compile(code_file_path.string(), cache_folder);
+    BOOST_REQUIRE(cached && cached->size() == 1);
+    BOOST_CHECK_EQUAL(solc.getRunsCount(), 1); // taken from the cache
+    BOOST_CHECK_EQUAL(cached->front().name, "CachedStorage");
+    BOOST_CHECK_EQUAL(cached->front().code, compiled->front().code);
+    BOOST_CHECK_EQUAL(cached->front().metadata.toString(), compiled->front().metadata.toString());
+
+    auto uncached = vm::compile(code_file_path.string());
+    BOOST_REQUIRE(uncached && uncached->size() == 1);
+    BOOST_CHECK_EQUAL(solc.getRunsCount(), 2);
+    BOOST_CHECK_EQUAL(uncached->front().code, compiled->front().code);
+
+    std::filesystem::remove_all(cache_folder);
+    std::filesystem::remove(code_file_path);
+}
+
+
+BOOST_AUTO_TEST_CASE(vm_compile_cache_same_source_in_other_folder)
+{
+    const char* main_code = R"raw(
+pragma solidity >=0.4.0 <0.7.0;
+
+import "./lib.sol";
+
+contract Main is Lib {}
+)raw";
+    const auto makeLibCode = [](int value) {
+        return "pragma solidity >=0.4.0 <0.7.0;\n\ncontract Lib {\n    function value() public pure returns (uint) {\n"
+               "        return " +
+               std::to_string(value) + ";\n    }\n}\n";
+    };
+
+    CountingSolc solc{ std::filesystem::temp_directory_path() / "likelib_vm_compile_cache_folders_solc" };
+    const std::filesystem::path first_folder = "vm_compile_cache_first";
+    const std::filesystem::path second_folder = "vm_compile_cache_second";
+    auto cache_folder = std::filesystem::temp_directory_path() / "likelib_vm_compile_cache_folders_test";
+    std::filesystem::remove_all(cache_folder);
+    for (const auto& [folder, value] : { std::pair{ first_folder, 1 }, std::pair{ second_folder, 2 } }) {
+        std::filesystem::create_directories(folder);
+        std::ofstream(folder / "main.sol") << main_code;
+        std::ofstream(folder / "lib.sol") << makeLibCode(value);
+    }
+
+    // main.sol files are the same, while the libraries they import are not
+    auto first = vm::compile((first_folder / "main.sol").string(), cache_folder);
+    auto second = vm::compile((second_folder / "main.sol").string(), cache_folder);
+    BOOST_REQUIRE(first && second);
+    BOOST_CHECK_EQUAL(solc.getRunsCount(), 2);
+    BOOST_CHECK(findContract(*first, "Main").code != findContract(*second, "Main").code);
+
+    auto uncached_second = vm::compile((second_folder / "main.sol").string());
+    BOOST_REQUIRE(uncached_second);
+    BOOST_CHECK_EQUAL(findContract(*second, "Main").code, findContract(*uncached_second, "Main").code);
+
+    std::filesystem::remove_all(cache_folder);
+    std::filesystem::remove_all(first_folder);
+    std::filesystem::remove_all(second_folder);
+}